@@ -9,7 +9,36 @@
         "src/native/chip.cpp",
         "src/native/line.cpp",
         "src/native/line_config.cpp",
-        "src/native/line_request.cpp"
+        "src/native/line_request.cpp",
+        "src/native/program.cpp",
+        "src/native/edge_reader.cpp",
+        "src/native/glitch_filter.cpp",
+        "src/native/line_group.cpp",
+        "src/native/vcd_writer.cpp",
+        "src/native/thread_options.cpp",
+        "src/native/spi_bitbang.cpp",
+        "src/native/i2c_bitbang.cpp",
+        "src/native/shift_register.cpp",
+        "src/native/keypad.cpp",
+        "src/native/display_refresher.cpp",
+        "src/native/stepper.cpp",
+        "src/native/servo.cpp",
+        "src/native/pulse_meter.cpp",
+        "src/native/decoder.cpp",
+        "src/native/decoder_wiegand.cpp",
+        "src/native/decoder_ir.cpp",
+        "src/native/decoder_ook.cpp",
+        "src/native/decoder_uart.cpp",
+        "src/native/dht.cpp",
+        "src/native/one_wire.cpp",
+        "src/native/button.cpp",
+        "src/native/one_shot.cpp",
+        "src/native/bus_trigger.cpp",
+        "src/native/supervisor.cpp",
+        "src/native/watchdog.cpp",
+        "src/native/engine_utils.cpp",
+        "src/native/periodic_task.cpp",
+        "src/native/write_scheduler.cpp"
       ],
       "include_dirs": [
         "<!@(node -p \"require('node-addon-api').include\")"
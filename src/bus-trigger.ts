@@ -0,0 +1,143 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schemas for bus trigger options
+const busTriggerOptionsSchema = z.object({
+  lines: z.array(z.number().int().nonnegative()).min(1).max(32)
+});
+
+const triggerSchema = z.object({
+  mask: z.number().int().nonnegative().max(0xffffffff).optional(),
+  value: z.number().int().nonnegative().max(0xffffffff).default(0),
+  values: z.array(z.number().int().nonnegative().max(0xffffffff)).optional(),
+  on: z.enum(['enter', 'leave', 'both']).default('enter')
+});
+
+/**
+ * Options for a bus trigger
+ */
+export interface BusTriggerOptions {
+  /** Offsets of the bus lines, least significant bit first (requested as inputs with edge detection on both edges) */
+  lines: number[];
+}
+
+/**
+ * A pattern to match on the bus value
+ */
+export interface BusPattern {
+  /** Bits of the bus value to compare, defaults to all lines */
+  mask?: number;
+  /** Matches when (bus & mask) == value, defaults to 0 */
+  value?: number;
+  /** Matches when (bus & mask) is one of these instead, if given */
+  values?: number[];
+  /** Report when the bus starts matching ('enter', default), stops matching ('leave') or both */
+  on?: 'enter' | 'leave' | 'both';
+}
+
+/**
+ * A trigger that fired
+ */
+export interface BusTriggerEvent {
+  /** Id returned by addTrigger */
+  trigger: number;
+  /** Whether the bus started or stopped matching */
+  type: 'enter' | 'leave';
+  /** Bus value after the edge */
+  value: number;
+  /** Offset of the line whose edge caused the match */
+  offset: number;
+  /** Kernel timestamp of that edge in nanoseconds */
+  timestampNs: bigint;
+}
+
+/**
+ * Statistics of a bus trigger
+ */
+export interface BusTriggerStats {
+  /** Edges seen on the bus lines */
+  edges: number;
+  /** Reported events */
+  matches: number;
+  /** Registered triggers */
+  triggers: number;
+}
+
+/**
+ * Evaluates masked-compare triggers on a bus of up to 32 lines in native code
+ *
+ * The bus value is read once at start and kept current from the edge events;
+ * all triggers are evaluated on every edge and JavaScript is only called for
+ * matches. Lines that change together are seen one edge at a time, so
+ * intermediate values can match briefly.
+ */
+export class BusTrigger {
+  private _nativeTrigger: any;
+  private _isRunning: boolean = false;
+
+  /**
+   * Creates a new BusTrigger instance without triggers
+   * @param request The line request owning the bus lines
+   * @param options The bus lines
+   */
+  constructor(request: LineRequest, options: BusTriggerOptions) {
+    const validated = busTriggerOptionsSchema.parse(options);
+    this._nativeTrigger = new addon.BusTrigger(request.nativeRequest, validated);
+  }
+
+  /**
+   * Registers a trigger, also while running; a pattern that matches the
+   * current value fires once the bus leaves and re-enters it
+   * @param pattern The pattern to match
+   * @returns The id of the trigger
+   */
+  addTrigger(pattern: BusPattern): number {
+    return this._nativeTrigger.addTrigger(triggerSchema.parse(pattern));
+  }
+
+  /**
+   * Removes a trigger
+   * @param id The id returned by addTrigger
+   * @returns Whether the trigger existed
+   */
+  removeTrigger(id: number): boolean {
+    return this._nativeTrigger.removeTrigger(id);
+  }
+
+  /**
+   * Starts matching
+   * @param callback The callback to call for each trigger that fires
+   */
+  start(callback: (err: Error | null, event: BusTriggerEvent | null) => void): void {
+    this._nativeTrigger.start(callback);
+    this._isRunning = true;
+  }
+
+  /**
+   * Stops matching
+   */
+  stop(): void {
+    if (this._isRunning) {
+      this._nativeTrigger.stop();
+      this._isRunning = false;
+    }
+  }
+
+  /**
+   * Gets the current bus value (null if not running)
+   */
+  get value(): number | null {
+    return this._nativeTrigger.getValue();
+  }
+
+  /**
+   * Gets the trigger statistics
+   */
+  get stats(): BusTriggerStats {
+    return this._nativeTrigger.getStats();
+  }
+}
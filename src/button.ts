@@ -0,0 +1,118 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+import { ButtonEventType } from './enums.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for button classifier options
+const buttonOptionsSchema = z.object({
+  buttons: z.array(z.number().int().nonnegative()).min(1),
+  activeLow: z.boolean().default(true),
+  debounceMs: z.number().nonnegative().default(10),
+  longPressMs: z.number().nonnegative().default(800),
+  multiClickMs: z.number().nonnegative().default(300)
+});
+
+/**
+ * Options for a button classifier
+ */
+export interface ButtonClassifierOptions {
+  /** Offsets of the button lines (requested as inputs with edge detection on both edges) */
+  buttons: number[];
+  /** Whether a pressed button reads low, defaults to true (button to ground with pull-up) */
+  activeLow?: boolean;
+  /** Time a level has to be stable before it counts, on top of any kernel debounce; defaults to 10 ms, 0 disables */
+  debounceMs?: number;
+  /** Hold time of a long press, defaults to 800 ms, 0 disables */
+  longPressMs?: number;
+  /** Window after a release in which another press adds to a multi-click, defaults to 300 ms, 0 reports every click at once */
+  multiClickMs?: number;
+}
+
+/**
+ * Semantic event of a button
+ */
+export interface ButtonEvent {
+  /** Index of the button in the buttons option */
+  index: number;
+  /** Offset of the button line */
+  offset: number;
+  /** Type of the event */
+  type: ButtonEventType;
+  /** Kernel timestamp of the first edge of a press or release, or the time a timer expired, in nanoseconds */
+  timestampNs: bigint;
+  /** How long the button was held (release and long-press) in nanoseconds */
+  durationNs?: number;
+  /** Number of short presses (click, double-click, multi-click) */
+  count?: number;
+}
+
+/**
+ * Statistics of a button classifier
+ */
+export interface ButtonClassifierStats {
+  /** Edges seen on the button lines */
+  edges: number;
+  /** Edges suppressed as bounces */
+  bounces: number;
+  /** Reported events */
+  events: number;
+}
+
+/**
+ * Classifies push button edges into press, release, long-press and click
+ * events in native code
+ *
+ * Bounces are filtered from the kernel timestamps of the edges, so only
+ * semantic events reach JavaScript. The reader thread only runs timers while
+ * a button is settling, held or inside its click window.
+ */
+export class ButtonClassifier {
+  private _nativeClassifier: any;
+  private _isRunning: boolean = false;
+
+  /**
+   * Creates a new ButtonClassifier instance
+   * @param request The line request owning the button lines
+   * @param options Button lines and timing
+   */
+  constructor(request: LineRequest, options: ButtonClassifierOptions) {
+    const validated = buttonOptionsSchema.parse(options);
+    this._nativeClassifier = new addon.ButtonClassifier(request.nativeRequest, validated);
+  }
+
+  /**
+   * Starts classifying; the current levels are taken as the initial state
+   * @param callback The callback to call for each event
+   */
+  start(callback: (err: Error | null, event: ButtonEvent | null) => void): void {
+    this._nativeClassifier.start(callback);
+    this._isRunning = true;
+  }
+
+  /**
+   * Stops classifying
+   */
+  stop(): void {
+    if (this._isRunning) {
+      this._nativeClassifier.stop();
+      this._isRunning = false;
+    }
+  }
+
+  /**
+   * Gets the indices of the buttons currently held down (debounced)
+   */
+  get pressed(): number[] {
+    return this._nativeClassifier.getPressed();
+  }
+
+  /**
+   * Gets the classifier statistics
+   */
+  get stats(): ButtonClassifierStats {
+    return this._nativeClassifier.getStats();
+  }
+}
@@ -0,0 +1,236 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schemas for the decoder protocols
+const wiegandSchema = z.object({
+  protocol: z.literal('wiegand'),
+  d0: z.number().int().nonnegative(),
+  d1: z.number().int().nonnegative(),
+  timeoutMs: z.number().positive().default(25),
+  parity: z.boolean().default(true),
+  minBits: z.number().int().positive().default(4),
+  maxBits: z.number().int().positive().default(128)
+});
+
+const irSchema = {
+  line: z.number().int().nonnegative(),
+  activeLow: z.boolean().default(true),
+  tolerance: z.number().positive().max(0.5).default(0.25)
+};
+
+const necSchema = z.object({
+  protocol: z.literal('nec'),
+  ...irSchema
+});
+
+const rc5Schema = z.object({
+  protocol: z.literal('rc5'),
+  ...irSchema
+});
+
+const ookSchema = z.object({
+  protocol: z.literal('ook'),
+  line: z.number().int().nonnegative(),
+  activeLow: z.boolean().default(false),
+  encoding: z.enum(['pwm', 'manchester']).default('pwm'),
+  shortUs: z.number().positive().optional(),
+  longUs: z.number().positive().optional(),
+  gapUs: z.number().positive().default(5000),
+  tolerance: z.number().positive().max(0.5).default(0.3),
+  minBits: z.number().int().positive().default(8),
+  maxBits: z.number().int().positive().default(256)
+});
+
+const uartSchema = z.object({
+  protocol: z.literal('uart'),
+  line: z.number().int().nonnegative(),
+  activeLow: z.boolean().default(false),
+  baud: z.number().positive().max(115200).default(9600),
+  dataBits: z.number().int().min(5).max(8).default(8),
+  parity: z.enum(['none', 'even', 'odd']).default('none'),
+  stopBits: z.union([z.literal(1), z.literal(2)]).default(1),
+  maxChunk: z.number().int().positive().default(256)
+});
+
+const decoderOptionsSchema = z.discriminatedUnion('protocol', [
+  wiegandSchema,
+  necSchema,
+  rc5Schema,
+  ookSchema,
+  uartSchema
+]);
+
+/**
+ * Options for a Wiegand decoder
+ */
+export interface WiegandDecoderOptions {
+  protocol: 'wiegand';
+  /** Offset of the D0 line (requested with falling edge detection) */
+  d0: number;
+  /** Offset of the D1 line (requested with falling edge detection) */
+  d1: number;
+  /** Gap after the last pulse that ends a frame in milliseconds, defaults to 25 */
+  timeoutMs?: number;
+  /** Check the leading even and trailing odd parity bit of even-length frames, defaults to true */
+  parity?: boolean;
+  /** Shorter frames are dropped, defaults to 4 */
+  minBits?: number;
+  /** Longer frames are dropped, defaults to 128 */
+  maxBits?: number;
+}
+
+/**
+ * Options for an NEC or RC5 infrared remote decoder
+ */
+export interface IrDecoderOptions {
+  protocol: 'nec' | 'rc5';
+  /** Offset of the IR receiver output (requested with edge detection on both edges) */
+  line: number;
+  /** The receiver pulls its output low during a carrier burst, defaults to true */
+  activeLow?: boolean;
+  /** Accepted relative deviation from the nominal pulse widths, defaults to 0.25 */
+  tolerance?: number;
+}
+
+/**
+ * Options for a 433 MHz on-off keying decoder
+ */
+export interface OokDecoderOptions {
+  protocol: 'ook';
+  /** Offset of the receiver data output (requested with edge detection on both edges) */
+  line: number;
+  /** The carrier is on while the line is low, defaults to false */
+  activeLow?: boolean;
+  /** 'pwm': short mark is 0, long mark is 1; 'manchester': 1 is a space followed by a mark. Defaults to 'pwm' */
+  encoding?: 'pwm' | 'manchester';
+  /** Short period (pwm) or half-bit (manchester) in microseconds, defaults to 350 or 500 */
+  shortUs?: number;
+  /** Long period in microseconds, defaults to 3 (pwm) or 2 (manchester) short periods */
+  longUs?: number;
+  /** Space that separates frames in microseconds, defaults to 5000 */
+  gapUs?: number;
+  /** Accepted relative deviation from the nominal periods, defaults to 0.3 */
+  tolerance?: number;
+  /** Shorter frames are dropped as noise, defaults to 8 */
+  minBits?: number;
+  /** Longer frames are dropped, defaults to 256 */
+  maxBits?: number;
+}
+
+/**
+ * Options for a software UART receiver
+ */
+export interface UartDecoderOptions {
+  protocol: 'uart';
+  /** Offset of the RX line (requested with edge detection on both edges) */
+  line: number;
+  /** The line idles low, e.g. RS-232 levels without a line driver, defaults to false */
+  activeLow?: boolean;
+  /** Bit rate, defaults to 9600 */
+  baud?: number;
+  /** Data bits per character (5 to 8), defaults to 8 */
+  dataBits?: number;
+  /** Parity bit, defaults to 'none' */
+  parity?: 'none' | 'even' | 'odd';
+  /** Stop bits, defaults to 1 */
+  stopBits?: 1 | 2;
+  /** Bytes after which a chunk is emitted even if the line is still busy, defaults to 256 */
+  maxChunk?: number;
+}
+
+/**
+ * Options of any supported decoder protocol
+ */
+export type DecoderOptions = WiegandDecoderOptions | IrDecoderOptions | OokDecoderOptions | UartDecoderOptions;
+
+/**
+ * Complete frame emitted by a decoder
+ */
+export interface DecodedFrame {
+  /** Protocol that decoded the frame */
+  protocol: string;
+  /** Number of bits in the frame */
+  bits: number;
+  /** Frame bits packed MSB first */
+  data: Uint8Array;
+  /** Kernel timestamp of the first edge of the frame in nanoseconds */
+  timestampNs: bigint;
+  /** Facility code (Wiegand 26 and 34 bit frames) */
+  facility?: number;
+  /** Card number (Wiegand 26 and 34 bit frames) */
+  card?: number;
+  /** Device address (NEC, RC5) */
+  address?: number;
+  /** Key command (NEC, RC5) */
+  command?: number;
+  /** 1 for an NEC repeat code of a held key, which carries the last address and command */
+  repeat?: number;
+  /** Toggle bit, flips on every RC5 key press */
+  toggle?: number;
+}
+
+/**
+ * Statistics of a decoder; protocols add their own error counters
+ */
+export interface DecoderStats {
+  /** Edges fed to the protocol decoder */
+  edges: number;
+  /** Complete frames emitted */
+  frames: number;
+  /** Edge events lost to kernel buffer overflows (gaps in the sequence numbers) */
+  lostEvents: number;
+  [counter: string]: number;
+}
+
+/**
+ * Decodes a pulse protocol from the edge events of a line request in native
+ * code and emits only complete, valid frames
+ *
+ * Events are ordered by their kernel sequence number; a gap drops the
+ * partial frame. Protocol decoders are plugins selected by the protocol
+ * option.
+ */
+export class Decoder {
+  private _nativeDecoder: any;
+  private _isRunning: boolean = false;
+
+  /**
+   * Creates a new Decoder instance
+   * @param request The line request owning the protocol lines
+   * @param options The protocol and its options
+   */
+  constructor(request: LineRequest, options: DecoderOptions) {
+    const validated = decoderOptionsSchema.parse(options);
+    this._nativeDecoder = new addon.Decoder(request.nativeRequest, validated.protocol, validated);
+  }
+
+  /**
+   * Starts decoding
+   * @param callback Called with every complete frame
+   */
+  start(callback: (err: Error | null, frame: DecodedFrame | null) => void): void {
+    this._nativeDecoder.start(callback);
+    this._isRunning = true;
+  }
+
+  /**
+   * Stops decoding
+   */
+  stop(): void {
+    if (this._isRunning) {
+      this._nativeDecoder.stop();
+      this._isRunning = false;
+    }
+  }
+
+  /**
+   * Gets the decoder statistics
+   */
+  get stats(): DecoderStats {
+    return this._nativeDecoder.getStats();
+  }
+}
@@ -0,0 +1,92 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for DHT sensor options
+const dhtOptionsSchema = z.object({
+  line: z.number().int().nonnegative(),
+  model: z.enum(['dht11', 'dht22']).default('dht22'),
+  pullUp: z.boolean().default(true),
+  startUs: z.number().positive().optional(),
+  timeoutMs: z.number().positive().default(10)
+});
+
+/**
+ * Options for a DHT11/DHT22 sensor
+ */
+export interface DhtSensorOptions {
+  /** Offset of the data line */
+  line: number;
+  /** Sensor model, defaults to 'dht22' (also AM2302) */
+  model?: 'dht11' | 'dht22';
+  /** Enable the internal pull-up while the line is released, defaults to true */
+  pullUp?: boolean;
+  /** Width of the start pulse in microseconds, defaults to 20000 (DHT11) or 1100 (DHT22) */
+  startUs?: number;
+  /** Time to wait for the complete response in milliseconds, defaults to 10 */
+  timeoutMs?: number;
+}
+
+/**
+ * Humidity and temperature reading
+ */
+export interface DhtReading {
+  /** Relative humidity in percent */
+  humidity: number;
+  /** Temperature in degrees Celsius */
+  temperature: number;
+  /** Kernel timestamp of the first response edge in nanoseconds */
+  timestampNs: bigint;
+}
+
+/**
+ * Statistics of a DHT sensor
+ */
+export interface DhtSensorStats {
+  /** Successful readings */
+  reads: number;
+  /** Responses with a wrong checksum */
+  checksumErrors: number;
+  /** Incomplete responses */
+  timeouts: number;
+}
+
+/**
+ * Reads DHT11/DHT22 humidity and temperature sensors
+ *
+ * The start pulse is driven and the line then switched to an input with edge
+ * detection by reconfiguring the request in place; the 40 response bits are
+ * decoded from the kernel timestamps of the edges. The sensors need about two
+ * seconds between readings.
+ */
+export class DhtSensor {
+  private _nativeSensor: any;
+
+  /**
+   * Creates a new DhtSensor instance
+   * @param request The line request owning the data line
+   * @param options The data line and sensor model
+   */
+  constructor(request: LineRequest, options: DhtSensorOptions) {
+    const validated = dhtOptionsSchema.parse(options);
+    this._nativeSensor = new addon.DhtSensor(request.nativeRequest, validated);
+  }
+
+  /**
+   * Reads humidity and temperature
+   * @returns The reading; rejects on a timeout or checksum error
+   */
+  read(): Promise<DhtReading> {
+    return this._nativeSensor.read();
+  }
+
+  /**
+   * Gets the sensor statistics
+   */
+  get stats(): DhtSensorStats {
+    return this._nativeSensor.getStats();
+  }
+}
@@ -0,0 +1,107 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+import type { PeriodicStats } from './threads.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for display refresher options
+const displayOptionsSchema = z.object({
+  digits: z.array(z.number().int().nonnegative()).min(1),
+  segments: z.array(z.number().int().nonnegative()).min(1).max(8),
+  rateHz: z.number().positive().default(1000),
+  digitActiveLow: z.boolean().default(false),
+  segmentActiveLow: z.boolean().default(false),
+  blankUs: z.number().nonnegative().default(0),
+  spinUs: z.number().nonnegative().default(0)
+});
+
+/**
+ * Options for a multiplexed display refresher
+ */
+export interface DisplayRefresherOptions {
+  /** Offsets of the digit (or matrix row) select lines */
+  digits: number[];
+  /** Offsets of the segment (or matrix column) lines, bit n of a frame byte drives segments[n] */
+  segments: number[];
+  /** Digit switch rate in Hz, defaults to 1000 (the frame rate is rateHz / digits.length) */
+  rateHz?: number;
+  /** Whether a digit is selected by driving its line low, defaults to false */
+  digitActiveLow?: boolean;
+  /** Whether a segment is lit by driving its line low, defaults to false */
+  segmentActiveLow?: boolean;
+  /** Time all digits stay off while the segments change, defaults to 0 (no blanking) */
+  blankUs?: number;
+  /** Busy-wait before each deadline for lower jitter at the cost of CPU, defaults to 0 */
+  spinUs?: number;
+}
+
+/**
+ * Statistics of a multiplexed display refresher
+ */
+export interface DisplayRefresherStats {
+  /** Refresh cycles over all digits */
+  cycles: number;
+  /** Frames picked up by the refresh thread */
+  frames: number;
+  /** set_values calls (ticks without changed lines are skipped) */
+  writes: number;
+  /** Whether the refresh thread is running */
+  running: boolean;
+  /** Timing of the refresh thread */
+  refresh: PeriodicStats;
+  /** Error that stopped the refresh thread */
+  error: string | null;
+}
+
+/**
+ * Refreshes a multiplexed LED or 7-segment display on a native timing thread
+ *
+ * Every tick lights the next digit with one set_values call that only
+ * writes the lines that change. Frames are triple-buffered: setFrame()
+ * never blocks, and the refresh thread switches to the newest frame at the
+ * start of a cycle, so the display keeps running while the event loop stalls.
+ */
+export class DisplayRefresher {
+  private _nativeDisplay: any;
+
+  /**
+   * Creates a new DisplayRefresher instance
+   * @param request The line request owning the digit and segment outputs
+   * @param options Line offsets and refresh settings
+   */
+  constructor(request: LineRequest, options: DisplayRefresherOptions) {
+    const validated = displayOptionsSchema.parse(options);
+    this._nativeDisplay = new addon.DisplayRefresher(request.nativeRequest, validated);
+  }
+
+  /**
+   * Sets the frame to show from the next refresh cycle on
+   * @param frame One segment mask per digit
+   */
+  setFrame(frame: Uint8Array): void {
+    this._nativeDisplay.setFrame(frame);
+  }
+
+  /**
+   * Starts refreshing
+   */
+  start(): void {
+    this._nativeDisplay.start();
+  }
+
+  /**
+   * Stops refreshing and switches all digits off
+   */
+  stop(): void {
+    this._nativeDisplay.stop();
+  }
+
+  /**
+   * Gets the refresh statistics
+   */
+  get stats(): DisplayRefresherStats {
+    return this._nativeDisplay.getStats();
+  }
+}
@@ -65,3 +65,63 @@ export enum EventType {
   /** Falling edge event */
   FALLING_EDGE = 'falling-edge'
 }
+
+/**
+ * Scheduling policy of native GPIO threads
+ */
+export enum SchedPolicy {
+  /** Default time-sharing scheduling */
+  OTHER = 'other',
+  /** Real-time first-in first-out scheduling */
+  FIFO = 'fifo',
+  /** Real-time round-robin scheduling */
+  RR = 'rr'
+}
+
+/**
+ * Bit order of serial transfers
+ */
+export enum BitOrder {
+  /** Most significant bit first */
+  MSB_FIRST = 'msb-first',
+  /** Least significant bit first */
+  LSB_FIRST = 'lsb-first'
+}
+
+/**
+ * Keypad event type
+ */
+export enum KeyEventType {
+  /** Key pressed (debounced) */
+  KEY_DOWN = 'key-down',
+  /** Key released (debounced) */
+  KEY_UP = 'key-up'
+}
+
+/**
+ * Semantic button event types
+ */
+export enum ButtonEventType {
+  /** Button went down (debounced) */
+  PRESS = 'press',
+  /** Button went up (debounced) */
+  RELEASE = 'release',
+  /** Button held for the long press time */
+  LONG_PRESS = 'long-press',
+  /** One short press followed by a quiet multi-click window */
+  CLICK = 'click',
+  /** Two short presses within the multi-click window */
+  DOUBLE_CLICK = 'double-click',
+  /** Three or more short presses within the multi-click window */
+  MULTI_CLICK = 'multi-click'
+}
+
+/**
+ * Velocity profile of stepper moves
+ */
+export enum MotionProfile {
+  /** Constant acceleration */
+  TRAPEZOIDAL = 'trapezoidal',
+  /** Jerk-limited (sinusoidal) acceleration */
+  S_CURVE = 's-curve'
+}
@@ -0,0 +1,36 @@
+import { z } from 'zod';
+
+// Validation schema for glitch filter options
+export const glitchFilterSchema = z.object({
+  minPulseUs: z.number().nonnegative().default(0),
+  holdoffUs: z.number().nonnegative().default(0),
+  windowUs: z.number().nonnegative().default(0)
+});
+
+/**
+ * Options of the native glitch filter for lines whose driver ignores the
+ * kernel debounce period
+ *
+ * The filter works on kernel timestamps in the native event thread, so a
+ * change is delivered once it is confirmed (after the minimum pulse width or
+ * the window), carrying the timestamp of its first edge. All stages are
+ * disabled by default.
+ */
+export interface GlitchFilterOptions {
+  /** Drop pulses shorter than this, in microseconds */
+  minPulseUs?: number;
+  /** Do not deliver changes within this time after a delivered edge, in microseconds; the level at the end of the hold-off is delivered if it differs */
+  holdoffUs?: number;
+  /** Deliver a change only if the line spent more than half of this window after it at the new level, in microseconds */
+  windowUs?: number;
+}
+
+/**
+ * Edge statistics of a watcher
+ */
+export interface WatchStats {
+  /** Edges read from the kernel */
+  edges: number;
+  /** Edges suppressed by the glitch filter */
+  suppressed: number;
+}
@@ -0,0 +1,114 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { Chip } from './chip.js';
+import { LineConfig } from './line-config.js';
+import { LineRequest } from './line-request.js';
+import { Bias, Direction, Drive, Value } from './enums.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for I2C options
+const i2cOptionsSchema = z.object({
+  sda: z.number().int().nonnegative(),
+  scl: z.number().int().nonnegative(),
+  clockHz: z.number().positive().default(100000),
+  stretchTimeoutUs: z.number().nonnegative().default(10000)
+});
+
+// Validation schema for I2C transactions
+const writeReadSchema = z.object({
+  address: z.number().int().min(0).max(0x7f),
+  readLength: z.number().int().nonnegative()
+});
+
+/**
+ * Options for a bit-banged I2C master
+ */
+export interface I2cBitbangOptions {
+  /** Offset of the data line */
+  sda: number;
+  /** Offset of the clock line */
+  scl: number;
+  /** Target clock frequency in Hz, defaults to 100 kHz */
+  clockHz?: number;
+  /** How long a slave may hold SCL low in microseconds, defaults to 10 ms */
+  stretchTimeoutUs?: number;
+}
+
+/**
+ * Transaction statistics of a bit-banged I2C master
+ */
+export interface I2cBitbangStats {
+  /** Completed transactions */
+  transactions: number;
+  /** Transactions aborted because the address or a byte was not acknowledged */
+  nacks: number;
+  /** Clock pulses stretched by a slave */
+  clockStretches: number;
+  /** Transactions aborted because the bus was busy or another master won arbitration */
+  arbitrationLost: number;
+}
+
+/**
+ * I2C master bit-banged over two open-drain lines of a line request
+ *
+ * Both lines are only ever driven low or released, so the request must
+ * configure them as open-drain outputs with pull-ups (see requestBus()).
+ * The master reads both lines back while SCL is released to follow clock
+ * stretching and to detect lost arbitration.
+ */
+export class I2cBitbang {
+  private _nativeI2c: any;
+
+  /**
+   * Creates a new I2cBitbang instance and releases the bus
+   * @param request The line request owning the SDA and SCL lines
+   * @param options Line offsets and bus settings
+   */
+  constructor(request: LineRequest, options: I2cBitbangOptions) {
+    const validated = i2cOptionsSchema.parse(options);
+    this._nativeI2c = new addon.I2cBitbang(request.nativeRequest, validated);
+  }
+
+  /**
+   * Requests SDA and SCL as open-drain outputs with pull-ups, released high
+   * @param chip The chip owning the lines
+   * @param sda Offset of the data line
+   * @param scl Offset of the clock line
+   * @returns The line request to pass to the constructor
+   */
+  static requestBus(chip: Chip, sda: number, scl: number): LineRequest {
+    const config = new LineConfig();
+    for (const offset of [sda, scl]) {
+      config.setOffset(offset);
+      config.setDirection(Direction.OUTPUT);
+      config.setDrive(Drive.OPEN_DRAIN);
+      config.setBias(Bias.PULL_UP);
+      config.setOutputValue(Value.HIGH);
+    }
+    return new LineRequest(chip, [sda, scl], config);
+  }
+
+  /**
+   * Writes bytes to a device and reads its answer with a repeated start
+   *
+   * Writing nothing performs a read-only transaction; writing and reading
+   * nothing probes the address.
+   * @param address The 7-bit device address
+   * @param data The bytes to write
+   * @param readLength The number of bytes to read, at most 65536
+   * @returns The bytes read
+   */
+  writeRead(address: number, data: Uint8Array, readLength: number): Promise<Uint8Array> {
+    writeReadSchema.parse({ address, readLength });
+    return this._nativeI2c.writeRead(address, data, readLength);
+  }
+
+  /**
+   * Gets the transaction statistics
+   */
+  get stats(): I2cBitbangStats {
+    return this._nativeI2c.getStats();
+  }
+}
@@ -1,9 +1,54 @@
 import { z } from 'zod';
 import { Chip } from './chip.js';
 import { Line } from './line.js';
-import { Direction, Edge, Value, Bias, Drive } from './enums.js';
+import { Direction, Edge, Value, Bias, Drive, EventType, SchedPolicy, BitOrder, KeyEventType, MotionProfile, ButtonEventType } from './enums.js';
 import { LineConfig } from './line-config.js';
 import { LineRequest } from './line-request.js';
+import { LineGroup } from './line-group.js';
+import { VcdWriter } from './vcd-writer.js';
+import { ProgramBuilder, Opcode } from './program.js';
+import { SpiBitbang } from './spi-bitbang.js';
+import { I2cBitbang } from './i2c-bitbang.js';
+import { ShiftRegisterOut, ShiftRegisterIn } from './shift-register.js';
+import { KeypadScanner } from './keypad.js';
+import { DisplayRefresher } from './display-refresher.js';
+import { StepperController } from './stepper.js';
+import { ServoController } from './servo.js';
+import { PulseMeter } from './pulse-meter.js';
+import { Decoder } from './decoder.js';
+import { UartReceiver } from './uart-receiver.js';
+import { DhtSensor } from './dht.js';
+import { OneWireBus } from './one-wire.js';
+import { ButtonClassifier } from './button.js';
+import { DelayedOneShot } from './one-shot.js';
+import { BusTrigger } from './bus-trigger.js';
+import { WatchdogKicker } from './watchdog.js';
+import { setThreadOptions, getThreadOptions } from './threads.js';
+
+export type { OutputTransition, WriteStats, PulseOptions, ScheduleOptions, ScheduledWrite } from './line-request.js';
+export type { LineGroupLine, LineGroupEvent } from './line-group.js';
+export type { VcdWriterOptions, VcdWriterStats } from './vcd-writer.js';
+export type { ThreadOptions, PeriodicStats } from './threads.js';
+export type { WaitEdgeResult } from './program.js';
+export type { SpiBitbangOptions, SpiBitbangStats } from './spi-bitbang.js';
+export type { I2cBitbangOptions, I2cBitbangStats } from './i2c-bitbang.js';
+export type { ShiftRegisterOutOptions, ShiftRegisterInOptions, ShiftRegisterOutStats, ShiftRegisterInStats } from './shift-register.js';
+export type { KeypadOptions, KeypadEvent, KeypadStats } from './keypad.js';
+export type { DisplayRefresherOptions, DisplayRefresherStats } from './display-refresher.js';
+export type { StepperOptions, MoveOptions, StepperStats } from './stepper.js';
+export type { ServoOptions, ServoStats } from './servo.js';
+export type { PulseMeterOptions, PulseMeasurement, PulseMeterStats } from './pulse-meter.js';
+export type { DecoderOptions, WiegandDecoderOptions, IrDecoderOptions, OokDecoderOptions, UartDecoderOptions, DecodedFrame, DecoderStats } from './decoder.js';
+export type { UartReceiverOptions } from './uart-receiver.js';
+export type { DhtSensorOptions, DhtReading, DhtSensorStats } from './dht.js';
+export type { OneWireBusOptions, OneWireBusStats } from './one-wire.js';
+export type { GlitchFilterOptions, WatchStats } from './glitch-filter.js';
+export type { GetValueOptions, ValueCacheStats } from './line.js';
+export type { ButtonClassifierOptions, ButtonEvent, ButtonClassifierStats } from './button.js';
+export type { DelayedOneShotOptions, DelayedOneShotStats } from './one-shot.js';
+export type { SuperviseOptions, SupervisionEvent, SupervisionStatus, Supervision } from './supervisor.js';
+export type { BusTriggerOptions, BusPattern, BusTriggerEvent, BusTriggerStats } from './bus-trigger.js';
+export type { WatchdogKickerOptions, WatchdogKickerStats } from './watchdog.js';
 
 // Re-export all components
 export {
@@ -14,8 +59,37 @@ export {
   Value,
   LineConfig,
   LineRequest,
+  LineGroup,
   Bias,
-  Drive
+  Drive,
+  EventType,
+  SchedPolicy,
+  BitOrder,
+  KeyEventType,
+  MotionProfile,
+  ButtonEventType,
+  VcdWriter,
+  ProgramBuilder,
+  Opcode,
+  SpiBitbang,
+  I2cBitbang,
+  ShiftRegisterOut,
+  ShiftRegisterIn,
+  KeypadScanner,
+  DisplayRefresher,
+  StepperController,
+  ServoController,
+  PulseMeter,
+  Decoder,
+  UartReceiver,
+  DhtSensor,
+  OneWireBus,
+  ButtonClassifier,
+  DelayedOneShot,
+  BusTrigger,
+  WatchdogKicker,
+  setThreadOptions,
+  getThreadOptions
 };
 
 // Default export for CommonJS compatibility
@@ -27,6 +101,35 @@ export default {
   Value,
   LineConfig,
   LineRequest,
+  LineGroup,
   Bias,
-  Drive
+  Drive,
+  EventType,
+  SchedPolicy,
+  BitOrder,
+  KeyEventType,
+  MotionProfile,
+  ButtonEventType,
+  VcdWriter,
+  ProgramBuilder,
+  Opcode,
+  SpiBitbang,
+  I2cBitbang,
+  ShiftRegisterOut,
+  ShiftRegisterIn,
+  KeypadScanner,
+  DisplayRefresher,
+  StepperController,
+  ServoController,
+  PulseMeter,
+  Decoder,
+  UartReceiver,
+  DhtSensor,
+  OneWireBus,
+  ButtonClassifier,
+  DelayedOneShot,
+  BusTrigger,
+  WatchdogKicker,
+  setThreadOptions,
+  getThreadOptions
 };
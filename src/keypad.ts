@@ -0,0 +1,137 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+import { KeyEventType } from './enums.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for keypad options
+const keypadOptionsSchema = z.object({
+  rows: z.array(z.number().int().nonnegative()).min(1),
+  columns: z.array(z.number().int().nonnegative()).min(1),
+  keys: z.array(z.string()).optional(),
+  activeLow: z.boolean().default(true),
+  debounceMs: z.number().nonnegative().default(20),
+  scanIntervalMs: z.number().positive().default(5),
+  settleUs: z.number().nonnegative().default(5),
+  ghostBlocking: z.boolean().default(true)
+}).refine(options => !options.keys || options.keys.length === options.rows.length * options.columns.length, {
+  message: 'keys must name every key of the matrix in row order'
+});
+
+/**
+ * Options for a matrix keypad scanner
+ */
+export interface KeypadOptions {
+  /** Offsets of the row lines (outputs) */
+  rows: number[];
+  /** Offsets of the column lines (inputs with pull resistors) */
+  columns: number[];
+  /** Optional key names in row order, e.g. ['1', '2', '3', 'A', ...] */
+  keys?: string[];
+  /** Whether rows are selected low and pressed keys read low, defaults to true */
+  activeLow?: boolean;
+  /** Time a key has to be stable before it is reported, defaults to 20 ms */
+  debounceMs?: number;
+  /** Scan interval while keys are held or settling, defaults to 5 ms */
+  scanIntervalMs?: number;
+  /** Settle time between selecting a row and reading the columns, defaults to 5 µs */
+  settleUs?: number;
+  /** Ignore scans with ambiguous (ghosted) keys, defaults to true; disable for matrices with diodes */
+  ghostBlocking?: boolean;
+}
+
+/**
+ * Debounced key event of a matrix keypad
+ */
+export interface KeypadEvent {
+  /** Index of the key (row * columns + column) */
+  index: number;
+  /** Row of the key */
+  row: number;
+  /** Column of the key */
+  column: number;
+  /** Name of the key, if key names were given */
+  key?: string;
+  /** Whether the key went down or up */
+  type: KeyEventType;
+  /** CLOCK_MONOTONIC time of the first scan that saw the change in nanoseconds */
+  timestampNs: bigint;
+}
+
+/**
+ * Statistics of a matrix keypad scanner
+ */
+export interface KeypadStats {
+  /** Matrix scans */
+  scans: number;
+  /** Reported key events */
+  events: number;
+  /** Scans ignored because of ghosting */
+  ghostScans: number;
+}
+
+/**
+ * Scans a row/column matrix keypad on a native thread
+ *
+ * While no key is held, all rows are selected and the thread sleeps until a
+ * column changes (request the columns with edge detection for an immediate
+ * wake-up). It then scans the matrix row by row until all keys are released
+ * again, debouncing every key on its own so any number of keys can be held.
+ * Use open-drain rows or diodes if several keys of a column may be pressed.
+ */
+export class KeypadScanner {
+  private _nativeKeypad: any;
+  private _keys?: string[];
+  private _isRunning: boolean = false;
+
+  /**
+   * Creates a new KeypadScanner instance
+   * @param request The line request owning the row and column lines
+   * @param options Line offsets and scan settings
+   */
+  constructor(request: LineRequest, options: KeypadOptions) {
+    const validated = keypadOptionsSchema.parse(options);
+    this._keys = validated.keys;
+    this._nativeKeypad = new addon.KeypadScanner(request.nativeRequest, validated);
+  }
+
+  /**
+   * Starts scanning
+   * @param callback The callback to call for each debounced key event
+   */
+  start(callback: (err: Error | null, event: KeypadEvent | null) => void): void {
+    this._nativeKeypad.start((err: Error | null, event: KeypadEvent | null) => {
+      if (event && this._keys) {
+        event.key = this._keys[event.index];
+      }
+      callback(err, event);
+    });
+    this._isRunning = true;
+  }
+
+  /**
+   * Stops scanning
+   */
+  stop(): void {
+    if (this._isRunning) {
+      this._nativeKeypad.stop();
+      this._isRunning = false;
+    }
+  }
+
+  /**
+   * Gets the indices of the keys currently held down (debounced)
+   */
+  get pressed(): number[] {
+    return this._nativeKeypad.getPressed();
+  }
+
+  /**
+   * Gets the scan statistics
+   */
+  get stats(): KeypadStats {
+    return this._nativeKeypad.getStats();
+  }
+}
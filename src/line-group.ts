@@ -0,0 +1,154 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+import { EventType, Value } from './enums.js';
+import { GlitchFilterOptions, WatchStats, glitchFilterSchema } from './glitch-filter.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for line group constructor
+const lineGroupSchema = z.object({
+  requests: z.array(z.instanceof(LineRequest)).min(1)
+});
+
+/**
+ * A line of a line group
+ */
+export interface LineGroupLine {
+  /** Name of the chip the line belongs to */
+  chip: string;
+  /** Offset of the line on its chip */
+  offset: number;
+}
+
+/**
+ * Edge event of the merged event stream of a line group
+ */
+export interface LineGroupEvent {
+  /** Index of the line within the group */
+  index: number;
+  /** Name of the chip the line belongs to */
+  chip: string;
+  /** Offset of the line on its chip */
+  offset: number;
+  /** Type of the edge */
+  type: EventType;
+  /** Kernel timestamp of the edge in nanoseconds */
+  timestampNs: bigint;
+  /** Sequence number of the event within its request */
+  globalSeqno: number;
+  /** Sequence number of the event on its line */
+  lineSeqno: number;
+}
+
+/**
+ * Presents the lines of several requests, usually on different chips, as one
+ * logical request
+ *
+ * Lines are numbered in the order of the requests and their offsets. Per-chip
+ * ioctls are issued back to back from native code, and edge events of all
+ * requests are merged into one stream.
+ */
+export class LineGroup {
+  private _nativeGroup: any;
+  private _requests: LineRequest[];
+  private _isWatching: boolean = false;
+
+  /**
+   * Creates a new LineGroup instance
+   * @param requests The requests to combine
+   */
+  constructor(requests: LineRequest[]) {
+    const { requests: validatedRequests } = lineGroupSchema.parse({ requests });
+
+    this._requests = validatedRequests;
+    this._nativeGroup = new addon.LineGroup(validatedRequests.map(request => request.nativeRequest));
+  }
+
+  /**
+   * Gets the lines of the group in index order
+   */
+  get lines(): LineGroupLine[] {
+    return this._nativeGroup.getLines();
+  }
+
+  /**
+   * Gets the requests the group is made of
+   */
+  get requests(): LineRequest[] {
+    return [...this._requests];
+  }
+
+  /**
+   * Gets the values of all lines
+   * @returns The values in index order
+   */
+  getValues(): Value[] {
+    return this._nativeGroup.getValues();
+  }
+
+  /**
+   * Sets the values of all lines
+   * @param values The values in index order
+   */
+  setValues(values: Value[]): void {
+    this._nativeGroup.setValues(values);
+  }
+
+  /**
+   * Gets the values of all lines as a bitmask (bit n is line index n, at most 32 lines)
+   */
+  getMask(): number {
+    return this._nativeGroup.getMask();
+  }
+
+  /**
+   * Sets the lines selected by a mask to the corresponding bits (at most 32 lines)
+   * @param mask Lines to write
+   * @param bits Values of the written lines
+   */
+  setMask(mask: number, bits: number): void {
+    this._nativeGroup.setMask(mask >>> 0, bits >>> 0);
+  }
+
+  /**
+   * Watches the merged edge event stream of all requests
+   *
+   * Events read in one wake-up of the native reader are delivered in kernel
+   * timestamp order. Reads are not held back for other chips, so an event
+   * that reaches its chip's buffer late can follow a later event of another
+   * chip; compare timestampNs where the exact order across chips matters.
+   * @param callback The callback to call for each edge event
+   * @param filter Glitch filter for the edges of each line
+   */
+  watch(callback: (err: Error | null, event: LineGroupEvent | null) => void, filter: GlitchFilterOptions = {}): void {
+    const validated = glitchFilterSchema.parse(filter);
+    this._nativeGroup.watch(callback, validated);
+    this._isWatching = true;
+  }
+
+  /**
+   * Stops watching for edge events
+   */
+  unwatch(): void {
+    if (this._isWatching) {
+      this._nativeGroup.unwatch();
+      this._isWatching = false;
+    }
+  }
+
+  /**
+   * Gets the edge statistics of the current or last watch
+   */
+  get watchStats(): WatchStats {
+    return this._nativeGroup.getWatchStats();
+  }
+
+  /**
+   * Gets the native group instance (for internal use)
+   */
+  get nativeGroup(): any {
+    return this._nativeGroup;
+  }
+}
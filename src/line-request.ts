@@ -2,6 +2,8 @@ import { z } from 'zod';
 import bindings from 'bindings';
 import { Chip } from './chip.js';
 import { LineConfig } from './line-config.js';
+import { Value } from './enums.js';
+import { HeartbeatSupervisor, SuperviseOptions, Supervision, SupervisionEvent } from './supervisor.js';
 
 // Load native addon
 const addon = bindings('gpiod2-node-gyp');
@@ -11,6 +13,74 @@ const lineRequestSchema = z.object({
   offsets: z.array(z.number().int().nonnegative()).min(1)
 });
 
+// Validation schema for pulse measurement options
+export const pulseOptionsSchema = z.object({
+  triggerUs: z.number().positive().default(10),
+  timeoutMs: z.number().positive().default(50)
+});
+
+/**
+ * Options for trigger/echo pulse measurements
+ */
+export interface PulseOptions {
+  /** Width of the trigger pulse in microseconds, defaults to 10 */
+  triggerUs?: number;
+  /** Time to wait for the end of the echo in milliseconds, defaults to 50 */
+  timeoutMs?: number;
+}
+
+// Validation schema for scheduled write options
+const scheduleOptionsSchema = z.object({
+  clock: z.enum(['monotonic', 'realtime']).default('monotonic'),
+  spinUs: z.number().nonnegative().default(50)
+});
+
+/**
+ * Options for writes scheduled at an absolute time
+ */
+export interface ScheduleOptions {
+  /** Clock of the time, defaults to 'monotonic' (the clock of edge event timestamps) */
+  clock?: 'monotonic' | 'realtime';
+  /** Busy-wait before the deadline for lower jitter, defaults to 50 µs */
+  spinUs?: number;
+}
+
+/**
+ * Result of a write scheduled at an absolute time
+ */
+export interface ScheduledWrite {
+  /** Requested time in nanoseconds on the chosen clock */
+  scheduledNs: bigint;
+  /** Time the write ioctl was issued in nanoseconds on the chosen clock */
+  writtenNs: bigint;
+  /** writtenNs - scheduledNs in nanoseconds */
+  latenessNs: number;
+  /** Duration of the write ioctl in nanoseconds; the lines change within it */
+  ioctlNs: number;
+}
+
+/**
+ * Output transition reported by the output observer
+ */
+export interface OutputTransition {
+  /** Offset of the line */
+  offset: number;
+  /** New value of the line */
+  value: Value;
+}
+
+/**
+ * Write statistics of the output shadow register
+ */
+export interface WriteStats {
+  /** Line values passed to setValue/setValues */
+  writes: number;
+  /** Line values skipped because they were unchanged */
+  elided: number;
+  /** set_values calls issued to the kernel */
+  ioctls: number;
+}
+
 /**
  * Request for GPIO lines
  */
@@ -19,6 +89,7 @@ export class LineRequest {
   private _chip: Chip;
   private _offsets: number[];
   private _config: LineConfig;
+  private _supervisor: HeartbeatSupervisor | null = null;
 
   /**
    * Creates a new LineRequest instance
@@ -57,6 +128,9 @@ export class LineRequest {
 
   /**
    * Sets the value of a line
+   *
+   * The request keeps a shadow of the last written output values. With write
+   * elision enabled, writing an unchanged value does not issue an ioctl.
    * @param offset The offset of the line
    * @param value The value to set
    */
@@ -64,10 +138,162 @@ export class LineRequest {
     this._nativeRequest.setValue(offset, value);
   }
 
+  /**
+   * Gets the values of several lines with one ioctl
+   * @param offsets The offsets of the lines (defaults to all requested lines)
+   * @returns The values in the order of the offsets
+   */
+  getValues(offsets?: number[]): Value[] {
+    return this._nativeRequest.getValues(offsets);
+  }
+
+  /**
+   * Sets the values of several lines
+   *
+   * The values are written with a single ioctl; unchanged ones are skipped
+   * if write elision is enabled.
+   * @param offsets The offsets of the lines
+   * @param values The values to set, in the order of the offsets
+   * @returns The number of lines that actually changed
+   */
+  setValues(offsets: number[], values: Value[]): number {
+    return this._nativeRequest.setValues(offsets, values);
+  }
+
+  /**
+   * Sets the value of a line at an absolute time
+   * @see setValuesAt
+   * @param timeNs Time in nanoseconds on the chosen clock
+   * @param offset The offset of the line
+   * @param value The value to set
+   * @param options Clock and spin time
+   * @returns The actual write time
+   */
+  setValueAt(timeNs: bigint, offset: number, value: Value, options: ScheduleOptions = {}): Promise<ScheduledWrite> {
+    return this.setValuesAt(timeNs, [offset], [value], options);
+  }
+
+  /**
+   * Sets the values of several lines with one ioctl at an absolute time
+   *
+   * Pending writes are queued on one native thread per request, which waits
+   * for the earliest deadline, approaches it with
+   * clock_nanosleep(TIMER_ABSTIME) on the chosen clock and spins for the
+   * last spinUs. A time that already passed is written at once and shows up
+   * in latenessNs. release() rejects the writes that have not fired yet.
+   * The output shadow is bypassed and forgotten after the write.
+   * @param timeNs Time in nanoseconds on the chosen clock
+   * @param offsets The offsets of the lines
+   * @param values The values to set, in the order of the offsets
+   * @param options Clock and spin time
+   * @returns The actual write time
+   */
+  setValuesAt(timeNs: bigint, offsets: number[], values: Value[], options: ScheduleOptions = {}): Promise<ScheduledWrite> {
+    const validated = scheduleOptionsSchema.parse(options);
+    return this._nativeRequest.setValuesAt(z.bigint().nonnegative().parse(timeNs), offsets, values, validated);
+  }
+
+  /**
+   * Registers an observer for actual output transitions, or removes it
+   * @param observer Called after each write that changed at least one line
+   */
+  onOutputChange(observer: ((transitions: OutputTransition[]) => void) | null): void {
+    this._nativeRequest.setOutputObserver(observer);
+  }
+
+  /**
+   * Enables or disables skipping of unchanged writes (disabled by default)
+   *
+   * The shadow only knows what this library wrote. With elision enabled, a
+   * line changed behind its back (by another process, a register write or a
+   * reset) is not corrected by writing the value the shadow already holds.
+   * @param enabled Whether unchanged writes are skipped
+   */
+  setWriteElision(enabled: boolean): void {
+    this._nativeRequest.setWriteElision(enabled);
+  }
+
+  /**
+   * Gets the write statistics of the output shadow register
+   */
+  get writeStats(): WriteStats {
+    return this._nativeRequest.getWriteStats();
+  }
+
+  /**
+   * Runs a GPIO micro-program on a native worker thread
+   *
+   * The whole sequence runs in one native call (see ProgramBuilder). A
+   * program with WAIT_EDGE instructions reads the edge events of the request,
+   * so it fails while another edge consumer is running, and edge events
+   * that are pending when it starts are discarded.
+   * @param program The program words (an ArrayBuffer must hold whole 32-bit
+   * words, otherwise a RangeError is thrown)
+   * @returns The result slots
+   */
+  execute(program: ArrayBuffer | Uint32Array): Promise<Uint32Array> {
+    return this._nativeRequest.execute(program);
+  }
+
+  /**
+   * Emits a trigger pulse and measures the width of the following echo pulse
+   *
+   * The echo line must be requested with edge detection on both edges; the
+   * width comes from the kernel timestamps of its rising and falling edge.
+   * Edge events that are pending when the measurement starts are discarded,
+   * and the measurement fails while another edge consumer is running.
+   * @param triggerOffset Offset of the trigger output
+   * @param echoOffset Offset of the echo input
+   * @param options Trigger pulse width and echo timeout
+   * @returns The echo pulse width in nanoseconds; rejects if no complete echo arrives in time
+   */
+  measurePulse(triggerOffset: number, echoOffset: number, options: PulseOptions = {}): Promise<number> {
+    const validated = pulseOptionsSchema.parse(options);
+    return this._nativeRequest.measurePulse(triggerOffset, echoOffset, validated);
+  }
+
+  /**
+   * Changes the configuration of the requested lines without releasing them
+   *
+   * The lines stay owned by this request, outputs keep their level unless
+   * the new configuration changes it, and watchers and engines on the
+   * request keep working.
+   * @param config The new configuration for the lines
+   */
+  reconfigure(config: LineConfig): void {
+    this._nativeRequest.reconfigure(config.nativeConfig);
+    this._config = config;
+  }
+
+  /**
+   * Supervises a heartbeat input in native code
+   *
+   * Every heartbeat edge re-arms a deadline from its kernel timestamp on a
+   * native reader thread shared by all supervised lines of the request, so
+   * JavaScript is only called when a heartbeat times out, comes too fast or
+   * recovers. A line that never pulses times out one interval after
+   * supervision starts.
+   * @param offset Offset of the heartbeat line, requested with edge detection
+   * @param options Heartbeat intervals
+   * @param callback Called for each transition
+   * @returns A handle to query or cancel the supervision
+   */
+  supervise(offset: number, options: SuperviseOptions,
+            callback: (err: Error | null, event: SupervisionEvent | null) => void): Supervision {
+    if (!this._supervisor) {
+      this._supervisor = new HeartbeatSupervisor(this);
+    }
+    return this._supervisor.add(offset, options, callback);
+  }
+
   /**
    * Releases the request
+   *
+   * Does not wait for native engines: a native write in progress is their
+   * last one, and the lines are freed when it ends.
    */
   release(): void {
+    this._supervisor?.stop();
     this._nativeRequest.release();
   }
 
@@ -5,6 +5,7 @@ import { Chip } from './chip.js';
 import { Direction, Edge, Value, Drive, Bias } from './enums.js';
 import { LineConfig } from './line-config.js';
 import { LineRequest } from './line-request.js';
+import { GlitchFilterOptions, WatchStats, glitchFilterSchema } from './glitch-filter.js';
 
 // Load native addon
 const addon = bindings('gpiod2-node-gyp');
@@ -14,6 +15,28 @@ const lineSchema = z.object({
   offset: z.number().int().nonnegative()
 });
 
+/**
+ * Options for reading the value of a line
+ */
+export interface GetValueOptions {
+  /** Answer from the edge-tracked level of a watched line without a syscall, defaults to false */
+  cached?: boolean;
+}
+
+/**
+ * Statistics of the value cache of a watched line
+ */
+export interface ValueCacheStats {
+  /** Reads answered from the cache */
+  hits: number;
+  /** Reads that issued an ioctl while watched (seeding at watch start, uncached reads, stale cache) */
+  reads: number;
+  /** Gaps in the line sequence numbers, i.e. edge events dropped by the kernel */
+  overruns: number;
+  /** Whether the cache will be refreshed by the next read after an overrun */
+  stale: boolean;
+}
+
 /**
  * Represents a GPIO line
  */
@@ -112,15 +135,21 @@ export class Line extends EventEmitter {
   }
 
   /**
-   * Gets the current value of the line
-   * @returns The current value
+   * Gets the value of the line
+   *
+   * While the line is watched, the native watcher tracks its level from the
+   * edge events, and a cached read answers from it without a syscall. After
+   * the kernel dropped edge events the cache is stale and the next read
+   * refreshes it with an ioctl.
+   * @param options Whether to answer from the value cache
+   * @returns The value of the line
    */
-  getValue(): Value {
+  getValue(options: GetValueOptions = {}): Value {
     if (!this._isExported) {
       throw new Error('Line is not exported');
     }
     
-    const value = this._nativeLine.getValue();
+    const value = this._nativeLine.getValue(options.cached === true);
     this._value = value;
     return value;
   }
@@ -242,9 +271,13 @@ export class Line extends EventEmitter {
 
   /**
    * Watches for value changes on the line
+   *
+   * The watch reads the edge events of the line's request, so it fails
+   * while another edge consumer runs on that request.
    * @param callback The callback to call when the value changes
+   * @param filter Glitch filter for the edges, applied when the first watcher starts
    */
-  watch(callback: (err: Error | null, value: Value) => void): void {
+  watch(callback: (err: Error | null, value: Value) => void, filter: GlitchFilterOptions = {}): void {
     if (!this._isExported) {
       this._export();
     }
@@ -254,6 +287,7 @@ export class Line extends EventEmitter {
     }
     
     if (!this._isWatching) {
+      const validated = glitchFilterSchema.parse(filter);
       this._nativeLine.watch((err: Error | null, value: Value) => {
         if (err) {
           this.emit('error', err);
@@ -261,7 +295,7 @@ export class Line extends EventEmitter {
           this._value = value;
           this.emit('change', value);
         }
-      });
+      }, validated);
       
       this._isWatching = true;
     }
@@ -285,6 +319,20 @@ export class Line extends EventEmitter {
     }
   }
 
+  /**
+   * Gets the edge statistics of the current or last watch
+   */
+  get watchStats(): WatchStats {
+    return this._nativeLine.getWatchStats();
+  }
+
+  /**
+   * Gets the statistics of the value cache of the current or last watch
+   */
+  get valueCacheStats(): ValueCacheStats {
+    return this._nativeLine.getValueCacheStats();
+  }
+
   /**
    * Exports the line for use
    */
@@ -318,9 +366,10 @@ export class Line extends EventEmitter {
       return;
     }
     
-    // Release the current request
+    // Change the settings in place; the line stays requested
     if (this._request) {
-      this._request.release();
+      this._request.reconfigure(this._config);
+      return;
     }
     
     // Create a new request
@@ -0,0 +1,316 @@
+#include "bus_trigger.h"
+#include "engine_utils.h"
+#include <algorithm>
+
+Napi::FunctionReference BusTrigger::constructor;
+
+Napi::Object BusTrigger::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "BusTrigger", {
+    InstanceMethod("addTrigger", &BusTrigger::AddTrigger),
+    InstanceMethod("removeTrigger", &BusTrigger::RemoveTrigger),
+    InstanceMethod("start", &BusTrigger::Start),
+    InstanceMethod("stop", &BusTrigger::Stop),
+    InstanceMethod("getValue", &BusTrigger::GetValue),
+    InstanceMethod("getStats", &BusTrigger::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("BusTrigger", func);
+  return exports;
+}
+
+BusTrigger::BusTrigger(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<BusTrigger>(info), owner_(nullptr), started_(false), bus_(0), next_id_(1), edges_(0),
+    matches_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  if (!ReadLineOffsets(env, options, "lines", owner_->GetOffsets(), lines_)) {
+    return;
+  }
+  if (lines_.empty() || lines_.size() > 32) {
+    Napi::RangeError::New(env, "Between 1 and 32 bus lines expected").ThrowAsJavaScriptException();
+    return;
+  }
+}
+
+BusTrigger::~BusTrigger() {
+  StopMatching();
+}
+
+bool BusTrigger::Matches(const Trigger& trigger, uint32_t bus) const {
+  uint32_t masked = bus & trigger.mask;
+  if (!trigger.values.empty()) {
+    return trigger.values.count(masked) > 0;
+  }
+  return masked == trigger.value;
+}
+
+void BusTrigger::OnEvents(const std::vector<EdgeRecord>& edges) {
+  std::vector<Match> matches;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const EdgeRecord& edge : edges) {
+      auto it = std::find(lines_.begin(), lines_.end(), edge.offset);
+      if (it == lines_.end()) {
+        continue;
+      }
+      edges_++;
+
+      uint32_t bit = 1u << (it - lines_.begin());
+      uint32_t bus = edge.rising ? (bus_ | bit) : (bus_ & ~bit);
+      if (bus == bus_) {
+        continue;
+      }
+      bus_ = bus;
+
+      for (Trigger& trigger : triggers_) {
+        bool matched = Matches(trigger, bus);
+        if (matched == trigger.matched) {
+          continue;
+        }
+        trigger.matched = matched;
+        if (matched ? trigger.on_enter : trigger.on_leave) {
+          matches.push_back({trigger.id, matched, bus, edge});
+        }
+      }
+    }
+    matches_ += matches.size();
+  }
+
+  if (matches.empty()) {
+    return;
+  }
+
+  auto batch = std::make_shared<std::vector<Match>>(std::move(matches));
+  tsfn_.BlockingCall([batch](Napi::Env env, Napi::Function jsCallback) {
+    for (const Match& match : *batch) {
+      Napi::Object result = Napi::Object::New(env);
+      result.Set("trigger", Napi::Number::New(env, match.id));
+      result.Set("type", Napi::String::New(env, match.entered ? "enter" : "leave"));
+      result.Set("value", Napi::Number::New(env, match.bus));
+      result.Set("offset", Napi::Number::New(env, match.edge.offset));
+      result.Set("timestampNs", Napi::BigInt::New(env, match.edge.timestamp_ns));
+      jsCallback.Call({env.Null(), result});
+    }
+  });
+}
+
+Napi::Value BusTrigger::AddTrigger(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsObject()) {
+    Napi::TypeError::New(env, "Trigger object expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  Napi::Object options = info[0].As<Napi::Object>();
+
+  uint32_t all = lines_.size() == 32 ? 0xffffffffu : (1u << lines_.size()) - 1;
+  Trigger trigger = {};
+  trigger.mask = static_cast<uint32_t>(ReadNumber(options, "mask", all)) & all;
+  trigger.value = static_cast<uint32_t>(ReadNumber(options, "value", 0));
+  if (options.Has("values") && options.Get("values").IsArray()) {
+    Napi::Array values = options.Get("values").As<Napi::Array>();
+    for (uint32_t i = 0; i < values.Length(); i++) {
+      Napi::Value value = values[i];
+      if (!value.IsNumber()) {
+        Napi::TypeError::New(env, "Trigger values must be numbers").ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+      trigger.values.insert(value.As<Napi::Number>().Uint32Value());
+    }
+  }
+
+  // Bits outside the mask can never match
+  bool unreachable = (trigger.value & ~trigger.mask) != 0;
+  for (uint32_t value : trigger.values) {
+    unreachable = unreachable || (value & ~trigger.mask) != 0;
+  }
+  if (unreachable) {
+    Napi::RangeError::New(env, "Trigger value has bits outside the mask").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string on = "enter";
+  if (options.Has("on") && options.Get("on").IsString()) {
+    on = options.Get("on").As<Napi::String>().Utf8Value();
+  }
+  if (on != "enter" && on != "leave" && on != "both") {
+    Napi::RangeError::New(env, "Trigger must fire on 'enter', 'leave' or 'both'").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  trigger.on_enter = on != "leave";
+  trigger.on_leave = on != "enter";
+
+  // A trigger that already matches fires when the bus leaves its set
+  std::lock_guard<std::mutex> lock(mutex_);
+  trigger.id = next_id_++;
+  trigger.matched = started_ && Matches(trigger, bus_);
+  triggers_.push_back(trigger);
+
+  return Napi::Number::New(env, trigger.id);
+}
+
+Napi::Value BusTrigger::RemoveTrigger(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Trigger id expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  uint32_t id = info[0].As<Napi::Number>().Uint32Value();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = std::find_if(triggers_.begin(), triggers_.end(), [id](const Trigger& trigger) {
+    return trigger.id == id;
+  });
+  if (it == triggers_.end()) {
+    return Napi::Boolean::New(env, false);
+  }
+  triggers_.erase(it);
+  return Napi::Boolean::New(env, true);
+}
+
+Napi::Value BusTrigger::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsFunction()) {
+    Napi::TypeError::New(env, "Callback function expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!request) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  StopMatching();
+
+  if (!owner_->ClaimEdgeEvents(env, this, "BusTrigger")) {
+    return env.Undefined();
+  }
+
+  // Seed the bus value; triggers that match it do not fire until the bus
+  // leaves and re-enters their set
+  try {
+    gpiod::line::offsets offsets(lines_.begin(), lines_.end());
+    gpiod::line::values values = request->get_values(offsets);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    bus_ = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+      if (values[i] == gpiod::line::value::ACTIVE) {
+        bus_ |= 1u << i;
+      }
+    }
+    for (Trigger& trigger : triggers_) {
+      trigger.matched = Matches(trigger, bus_);
+    }
+    started_ = true;
+  } catch (const std::exception& e) {
+    owner_->ReleaseEdgeEvents(this);
+    Napi::Error::New(env, "Failed to read bus: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    info[0].As<Napi::Function>(),
+    "GPIO Bus Trigger Callback",
+    0,
+    1
+  );
+
+  reader_ = std::make_unique<EdgeReader>(
+    request,
+    [this](const std::vector<EdgeRecord>& edges) { OnEvents(edges); },
+    [this](const std::string& error) {
+      tsfn_.BlockingCall([error](Napi::Env env, Napi::Function jsCallback) {
+        jsCallback.Call({Napi::Error::New(env, error).Value(), env.Null()});
+      });
+    }
+  );
+
+  std::string error = reader_->Start();
+  if (!error.empty()) {
+    StopMatching();
+    Napi::Error::New(env, "Failed to start bus trigger: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value BusTrigger::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  StopMatching();
+  return env.Undefined();
+}
+
+void BusTrigger::StopMatching() {
+  bool started;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    started = started_;
+    started_ = false;
+  }
+
+  if (started) {
+    if (reader_) {
+      reader_->Stop();
+      reader_.reset();
+    }
+    tsfn_.Release();
+  }
+
+  if (owner_) {
+    owner_->ReleaseEdgeEvents(this);
+  }
+}
+
+Napi::Value BusTrigger::GetValue(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!started_) {
+    return env.Null();
+  }
+  return Napi::Number::New(env, bus_);
+}
+
+Napi::Value BusTrigger::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("edges", Napi::Number::New(env, static_cast<double>(edges_)));
+  result.Set("matches", Napi::Number::New(env, static_cast<double>(matches_)));
+  result.Set("triggers", Napi::Number::New(env, static_cast<double>(triggers_.size())));
+
+  return result;
+}
@@ -0,0 +1,77 @@
+#ifndef BUS_TRIGGER_H
+#define BUS_TRIGGER_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+#include "edge_reader.h"
+
+// Pattern-match triggers on a bus of up to 32 input lines. The bus value is
+// seeded by one read at start and kept current from the edge events; every
+// trigger is evaluated per edge and only matches are reported, with the
+// kernel timestamp of the edge that caused them.
+class BusTrigger : public Napi::ObjectWrap<BusTrigger> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  BusTrigger(const Napi::CallbackInfo& info);
+  ~BusTrigger();
+
+  // Wrapped methods
+  Napi::Value AddTrigger(const Napi::CallbackInfo& info);
+  Napi::Value RemoveTrigger(const Napi::CallbackInfo& info);
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value GetValue(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  // A trigger matches when (bus & mask) == value, or when (bus & mask) is
+  // one of values if that set is not empty
+  struct Trigger {
+    uint32_t id;
+    uint32_t mask;
+    uint32_t value;
+    std::set<uint32_t> values;
+    bool on_enter;
+    bool on_leave;
+    bool matched;
+  };
+
+  struct Match {
+    uint32_t id;
+    bool entered;
+    uint32_t bus;
+    EdgeRecord edge;
+  };
+
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+  std::vector<unsigned int> lines_;
+
+  std::unique_ptr<EdgeReader> reader_;
+  Napi::ThreadSafeFunction tsfn_;
+  bool started_;
+
+  // Guards the bus value, the triggers and the counters
+  std::mutex mutex_;
+  uint32_t bus_;
+  std::vector<Trigger> triggers_;
+  uint32_t next_id_;
+  uint64_t edges_;
+  uint64_t matches_;
+
+  // Internal methods
+  bool Matches(const Trigger& trigger, uint32_t bus) const;
+  void OnEvents(const std::vector<EdgeRecord>& edges);
+  void StopMatching();
+};
+
+#endif // BUS_TRIGGER_H
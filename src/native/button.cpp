@@ -0,0 +1,362 @@
+#include "button.h"
+#include "engine_utils.h"
+#include <algorithm>
+
+Napi::FunctionReference ButtonClassifier::constructor;
+
+Napi::Object ButtonClassifier::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "ButtonClassifier", {
+    InstanceMethod("start", &ButtonClassifier::Start),
+    InstanceMethod("stop", &ButtonClassifier::Stop),
+    InstanceMethod("getPressed", &ButtonClassifier::GetPressed),
+    InstanceMethod("getStats", &ButtonClassifier::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("ButtonClassifier", func);
+  return exports;
+}
+
+ButtonClassifier::ButtonClassifier(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<ButtonClassifier>(info), owner_(nullptr), active_low_(true), debounce_ns_(0), long_press_ns_(0),
+    multi_click_ns_(0), started_(false), edges_(0), transitions_(0), events_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  std::vector<unsigned int> offsets;
+  if (!ReadLineOffsets(env, options, "buttons", owner_->GetOffsets(), offsets)) {
+    return;
+  }
+
+  active_low_ = ReadBoolean(options, "activeLow", true);
+  double debounce_ms = ReadNumber(options, "debounceMs", 10);
+  double long_press_ms = ReadNumber(options, "longPressMs", 800);
+  double multi_click_ms = ReadNumber(options, "multiClickMs", 300);
+  if (debounce_ms < 0 || long_press_ms < 0 || multi_click_ms < 0) {
+    Napi::RangeError::New(env, "Debounce, long press and multi-click times must not be negative").ThrowAsJavaScriptException();
+    return;
+  }
+  debounce_ns_ = static_cast<uint64_t>(debounce_ms * 1e6);
+  long_press_ns_ = static_cast<uint64_t>(long_press_ms * 1e6);
+  multi_click_ns_ = static_cast<uint64_t>(multi_click_ms * 1e6);
+
+  for (unsigned int offset : offsets) {
+    Button button = {};
+    button.offset = offset;
+    buttons_.push_back(button);
+  }
+}
+
+ButtonClassifier::~ButtonClassifier() {
+  StopClassifying();
+}
+
+void ButtonClassifier::Transition(Button& button, size_t index, bool pressed, uint64_t timestamp_ns,
+                                  std::vector<ButtonEvent>& events) {
+  button.pressed = pressed;
+  transitions_++;
+
+  if (pressed) {
+    button.press_ns = timestamp_ns;
+    button.long_fired = false;
+    events.push_back({index, EventType::kPress, timestamp_ns, 0, 0});
+    return;
+  }
+
+  events.push_back({index, EventType::kRelease, timestamp_ns, timestamp_ns - button.press_ns, 0});
+
+  // A long press is not a click
+  if (button.long_fired) {
+    return;
+  }
+  button.clicks++;
+  button.click_deadline_ns = timestamp_ns + multi_click_ns_;
+  if (multi_click_ns_ == 0) {
+    events.push_back({index, EventType::kClick, timestamp_ns, 0, button.clicks});
+    button.clicks = 0;
+  }
+}
+
+void ButtonClassifier::Settle(Button& button, size_t index, uint64_t now_ns, std::vector<ButtonEvent>& events) {
+  // The new level counts once it held for the debounce time; the event gets
+  // the timestamp of the first edge away from the old level
+  if (button.raw != button.pressed && now_ns >= button.raw_ns + debounce_ns_) {
+    Transition(button, index, button.raw, button.first_change_ns, events);
+  }
+}
+
+void ButtonClassifier::OnEvents(const std::vector<EdgeRecord>& edges) {
+  std::vector<ButtonEvent> events;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const EdgeRecord& edge : edges) {
+      auto it = std::find_if(buttons_.begin(), buttons_.end(), [&](const Button& button) {
+        return button.offset == edge.offset;
+      });
+      if (it == buttons_.end()) {
+        continue;
+      }
+      size_t index = static_cast<size_t>(it - buttons_.begin());
+      Button& button = *it;
+      edges_++;
+
+      // Resolve a level that settled before this edge
+      Settle(button, index, edge.timestamp_ns, events);
+
+      bool level = edge.rising != active_low_;
+      if (level != button.pressed && button.raw == button.pressed) {
+        button.first_change_ns = edge.timestamp_ns;
+      }
+      button.raw = level;
+      button.raw_ns = edge.timestamp_ns;
+
+      if (debounce_ns_ == 0) {
+        Settle(button, index, edge.timestamp_ns, events);
+      }
+    }
+  }
+
+  Emit(events);
+}
+
+void ButtonClassifier::OnIdle(uint64_t now_ns) {
+  std::vector<ButtonEvent> events;
+  uint64_t deadline = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (size_t index = 0; index < buttons_.size(); index++) {
+      Button& button = buttons_[index];
+      Settle(button, index, now_ns, events);
+
+      if (button.pressed && !button.long_fired && long_press_ns_ > 0 && now_ns >= button.press_ns + long_press_ns_) {
+        button.long_fired = true;
+        button.clicks = 0;
+        events.push_back({index, EventType::kLongPress, button.press_ns + long_press_ns_, long_press_ns_, 0});
+      }
+
+      if (!button.pressed && button.clicks > 0 && now_ns >= button.click_deadline_ns) {
+        events.push_back({index, EventType::kClick, button.click_deadline_ns - multi_click_ns_, 0, button.clicks});
+        button.clicks = 0;
+      }
+    }
+
+    deadline = NextDeadline();
+  }
+
+  // Sleep until the next pending timer, or until the next edge if none
+  reader_->WakeAt(deadline);
+  Emit(events);
+}
+
+uint64_t ButtonClassifier::NextDeadline() const {
+  uint64_t deadline = 0;
+  auto consider = [&](uint64_t candidate) {
+    if (deadline == 0 || candidate < deadline) {
+      deadline = candidate;
+    }
+  };
+
+  for (const Button& button : buttons_) {
+    if (button.raw != button.pressed) {
+      consider(button.raw_ns + debounce_ns_);
+    }
+    if (button.pressed && !button.long_fired && long_press_ns_ > 0) {
+      consider(button.press_ns + long_press_ns_);
+    }
+    if (!button.pressed && button.clicks > 0) {
+      consider(button.click_deadline_ns);
+    }
+  }
+  return deadline;
+}
+
+void ButtonClassifier::Emit(std::vector<ButtonEvent>& events) {
+  if (events.empty()) {
+    return;
+  }
+
+  std::vector<unsigned int> offsets;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    events_ += events.size();
+    for (const Button& button : buttons_) {
+      offsets.push_back(button.offset);
+    }
+  }
+
+  auto batch = std::make_shared<std::vector<ButtonEvent>>(std::move(events));
+  tsfn_.BlockingCall([batch, offsets](Napi::Env env, Napi::Function jsCallback) {
+    for (const ButtonEvent& event : *batch) {
+      Napi::Object result = Napi::Object::New(env);
+      result.Set("index", Napi::Number::New(env, static_cast<double>(event.index)));
+      result.Set("offset", Napi::Number::New(env, offsets[event.index]));
+
+      const char* type = "press";
+      switch (event.type) {
+      case EventType::kPress:
+        break;
+      case EventType::kRelease:
+        type = "release";
+        break;
+      case EventType::kLongPress:
+        type = "long-press";
+        break;
+      case EventType::kClick:
+        type = event.count == 1 ? "click" : event.count == 2 ? "double-click" : "multi-click";
+        break;
+      }
+      result.Set("type", Napi::String::New(env, type));
+      result.Set("timestampNs", Napi::BigInt::New(env, event.timestamp_ns));
+
+      if (event.type == EventType::kRelease || event.type == EventType::kLongPress) {
+        result.Set("durationNs", Napi::Number::New(env, static_cast<double>(event.duration_ns)));
+      }
+      if (event.type == EventType::kClick) {
+        result.Set("count", Napi::Number::New(env, event.count));
+      }
+      jsCallback.Call({env.Null(), result});
+    }
+  });
+}
+
+Napi::Value ButtonClassifier::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsFunction()) {
+    Napi::TypeError::New(env, "Callback function expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!request) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  StopClassifying();
+
+  // Start from the current levels without reporting them
+  try {
+    std::lock_guard<std::mutex> lock(mutex_);
+    gpiod::line::offsets offsets;
+    for (const Button& button : buttons_) {
+      offsets.push_back(button.offset);
+    }
+    gpiod::line::values values = request->get_values(offsets);
+    for (size_t i = 0; i < buttons_.size(); i++) {
+      bool pressed = (values[i] == gpiod::line::value::ACTIVE) != active_low_;
+      Button button = {};
+      button.offset = buttons_[i].offset;
+      button.raw = pressed;
+      button.pressed = pressed;
+      buttons_[i] = button;
+    }
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to read buttons: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!owner_->ClaimEdgeEvents(env, this, "ButtonClassifier")) {
+    return env.Undefined();
+  }
+
+  tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    info[0].As<Napi::Function>(),
+    "GPIO Button Callback",
+    0,
+    1
+  );
+  started_ = true;
+
+  reader_ = std::make_unique<EdgeReader>(
+    request,
+    [this](const std::vector<EdgeRecord>& edges) { OnEvents(edges); },
+    [this](const std::string& error) {
+      tsfn_.BlockingCall([error](Napi::Env env, Napi::Function jsCallback) {
+        jsCallback.Call({Napi::Error::New(env, error).Value(), env.Null()});
+      });
+    }
+  );
+  reader_->SetIdleHandler([this](uint64_t now_ns) { OnIdle(now_ns); }, 100);
+
+  std::string error = reader_->Start();
+  if (!error.empty()) {
+    StopClassifying();
+    Napi::Error::New(env, "Failed to start button classifier: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value ButtonClassifier::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  StopClassifying();
+  return env.Undefined();
+}
+
+void ButtonClassifier::StopClassifying() {
+  if (started_) {
+    started_ = false;
+    if (reader_) {
+      reader_->Stop();
+      reader_.reset();
+    }
+    tsfn_.Release();
+  }
+
+  if (owner_) {
+    owner_->ReleaseEdgeEvents(this);
+  }
+}
+
+Napi::Value ButtonClassifier::GetPressed(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Napi::Array result = Napi::Array::New(env);
+  uint32_t count = 0;
+  for (size_t i = 0; i < buttons_.size(); i++) {
+    if (buttons_[i].pressed) {
+      result[count++] = Napi::Number::New(env, static_cast<double>(i));
+    }
+  }
+  return result;
+}
+
+Napi::Value ButtonClassifier::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("edges", Napi::Number::New(env, static_cast<double>(edges_)));
+  // Every edge that did not become a press or release was a bounce
+  result.Set("bounces", Napi::Number::New(env, static_cast<double>(edges_ > transitions_ ? edges_ - transitions_ : 0)));
+  result.Set("events", Napi::Number::New(env, static_cast<double>(events_)));
+
+  return result;
+}
@@ -0,0 +1,84 @@
+#ifndef BUTTON_H
+#define BUTTON_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+#include "edge_reader.h"
+
+// Turns the edges of push buttons into semantic events: press, release,
+// long-press and click, double-click or multi-click. Bounces are filtered
+// from the kernel timestamps, and timers (debounce settle, hold time, click
+// window) only wake the reader thread while a button has one pending.
+class ButtonClassifier : public Napi::ObjectWrap<ButtonClassifier> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  ButtonClassifier(const Napi::CallbackInfo& info);
+  ~ButtonClassifier();
+
+  // Wrapped methods
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value GetPressed(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  enum class EventType { kPress, kRelease, kLongPress, kClick };
+
+  struct Button {
+    unsigned int offset;
+    bool raw;
+    uint64_t raw_ns;
+    uint64_t first_change_ns;
+    bool pressed;
+    uint64_t press_ns;
+    bool long_fired;
+    unsigned int clicks;
+    uint64_t click_deadline_ns;
+  };
+
+  struct ButtonEvent {
+    size_t index;
+    EventType type;
+    uint64_t timestamp_ns;
+    uint64_t duration_ns;
+    unsigned int count;
+  };
+
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  bool active_low_;
+  uint64_t debounce_ns_;
+  uint64_t long_press_ns_;
+  uint64_t multi_click_ns_;
+
+  std::unique_ptr<EdgeReader> reader_;
+  Napi::ThreadSafeFunction tsfn_;
+  bool started_;
+
+  // Guards the button states and counters against GetPressed/GetStats
+  mutable std::mutex mutex_;
+  std::vector<Button> buttons_;
+  uint64_t edges_;
+  uint64_t transitions_;
+  uint64_t events_;
+
+  // Internal methods, called from the reader thread
+  void OnEvents(const std::vector<EdgeRecord>& edges);
+  void OnIdle(uint64_t now_ns);
+  void Settle(Button& button, size_t index, uint64_t now_ns, std::vector<ButtonEvent>& events);
+  void Transition(Button& button, size_t index, bool pressed, uint64_t timestamp_ns, std::vector<ButtonEvent>& events);
+  uint64_t NextDeadline() const;
+  void Emit(std::vector<ButtonEvent>& events);
+  void StopClassifying();
+};
+
+#endif // BUTTON_H
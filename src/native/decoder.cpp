@@ -0,0 +1,334 @@
+#include "decoder.h"
+#include "engine_utils.h"
+#include <algorithm>
+#include <cmath>
+
+Napi::FunctionReference Decoder::constructor;
+
+namespace {
+
+struct Protocol {
+  const char* name;
+  DecoderFactory factory;
+};
+
+// Known protocols; new decoders add their factory here
+const Protocol kProtocols[] = {
+  {"wiegand", CreateWiegandDecoder},
+  {"nec", CreateNecDecoder},
+  {"rc5", CreateRc5Decoder},
+  {"ook", CreateOokDecoder},
+  {"uart", CreateUartDecoder}
+};
+
+} // namespace
+
+std::vector<uint8_t> PackBits(const std::vector<bool>& bits) {
+  std::vector<uint8_t> bytes((bits.size() + 7) / 8, 0);
+  for (size_t i = 0; i < bits.size(); i++) {
+    if (bits[i]) {
+      bytes[i / 8] = static_cast<uint8_t>(bytes[i / 8] | (0x80 >> (i % 8)));
+    }
+  }
+  return bytes;
+}
+
+PulseTracker::PulseTracker(unsigned int offset, bool active_low)
+  : offset_(offset), active_low_(active_low), has_edge_(false), mark_(false), last_ns_(0) {
+}
+
+bool PulseTracker::Feed(const EdgeRecord& edge, Pulse& pulse) {
+  if (edge.offset != offset_) {
+    return false;
+  }
+
+  bool had_edge = has_edge_;
+  pulse.mark = mark_;
+  pulse.start_ns = last_ns_;
+  pulse.duration_ns = edge.timestamp_ns - last_ns_;
+
+  has_edge_ = true;
+  mark_ = edge.rising != active_low_;
+  last_ns_ = edge.timestamp_ns;
+
+  // The level before the first edge has no known start
+  return had_edge;
+}
+
+void PulseTracker::Reset() {
+  has_edge_ = false;
+}
+
+bool NearDuration(uint64_t duration_ns, uint64_t nominal_ns, double tolerance) {
+  double difference = static_cast<double>(duration_ns) - static_cast<double>(nominal_ns);
+  return std::abs(difference) <= nominal_ns * tolerance;
+}
+
+bool DecodeManchester(const std::vector<bool>& halves, bool one_is_rising, std::vector<bool>& bits) {
+  for (size_t skip = 0; skip < 2; skip++) {
+    // Alignment 1 assumes an invisible space half-bit before the first mark
+    std::vector<bool> aligned;
+    if (skip == 1) {
+      aligned.push_back(false);
+    }
+    aligned.insert(aligned.end(), halves.begin(), halves.end());
+    if (aligned.size() % 2 != 0) {
+      aligned.push_back(false);
+    }
+
+    bits.clear();
+    bool valid = !aligned.empty();
+    for (size_t i = 0; i + 1 < aligned.size() && valid; i += 2) {
+      if (aligned[i] == aligned[i + 1]) {
+        valid = false;
+      } else {
+        bits.push_back(aligned[i + 1] == one_is_rising);
+      }
+    }
+    if (valid) {
+      return true;
+    }
+  }
+
+  bits.clear();
+  return false;
+}
+
+bool ReadDecoderLine(Napi::Env env, Napi::Object options, const std::vector<unsigned int>& offsets,
+                     bool default_active_low, unsigned int& offset, bool& active_low) {
+  int line = -1;
+  if (!ReadLineOffset(env, options, "line", offsets, true, line)) {
+    return false;
+  }
+  offset = static_cast<unsigned int>(line);
+  active_low = ReadBoolean(options, "activeLow", default_active_low);
+  return true;
+}
+
+Napi::Object Decoder::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "Decoder", {
+    InstanceMethod("start", &Decoder::Start),
+    InstanceMethod("stop", &Decoder::Stop),
+    InstanceMethod("getStats", &Decoder::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("Decoder", func);
+  return exports;
+}
+
+Decoder::Decoder(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<Decoder>(info), owner_(nullptr), started_(false), next_seqno_(0), edges_(0), frames_(0),
+    lost_events_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 3 || !info[0].IsObject() || !info[1].IsString() || !info[2].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object, protocol name and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  protocol_ = info[1].As<Napi::String>().Utf8Value();
+  for (const Protocol& protocol : kProtocols) {
+    if (protocol_ == protocol.name) {
+      decoder_ = protocol.factory(env, info[2].As<Napi::Object>(), owner_->GetOffsets());
+      if (!decoder_) {
+        return;
+      }
+      break;
+    }
+  }
+
+  if (!decoder_) {
+    Napi::TypeError::New(env, "Unknown decoder protocol: " + protocol_).ThrowAsJavaScriptException();
+    return;
+  }
+}
+
+Decoder::~Decoder() {
+  StopDecoding();
+}
+
+void Decoder::OnEvents(const std::vector<EdgeRecord>& events) {
+  std::vector<DecodedFrame> frames;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Order by kernel sequence number; a gap means the kernel buffer
+    // overflowed and the partial frame cannot be trusted
+    ordered_ = events;
+    std::stable_sort(ordered_.begin(), ordered_.end(), [](const EdgeRecord& a, const EdgeRecord& b) {
+      return a.global_seqno < b.global_seqno;
+    });
+
+    for (const EdgeRecord& edge : ordered_) {
+      if (next_seqno_ != 0 && edge.global_seqno != next_seqno_) {
+        if (edge.global_seqno > next_seqno_) {
+          lost_events_ += edge.global_seqno - next_seqno_;
+        }
+        decoder_->Reset();
+      }
+      next_seqno_ = edge.global_seqno + 1;
+      edges_++;
+
+      decoder_->OnEdge(edge, frames);
+    }
+  }
+
+  Emit(frames);
+}
+
+void Decoder::OnIdle(uint64_t now_ns) {
+  std::vector<DecodedFrame> frames;
+  uint64_t deadline;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    decoder_->OnIdle(now_ns, frames);
+    deadline = decoder_->NextDeadline();
+  }
+
+  // Sleep until the pending frame times out, or until the next edge if none
+  reader_->WakeAt(deadline);
+  Emit(frames);
+}
+
+void Decoder::Emit(std::vector<DecodedFrame>& frames) {
+  if (frames.empty()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    frames_ += frames.size();
+  }
+
+  auto batch = std::make_shared<std::vector<DecodedFrame>>(std::move(frames));
+  tsfn_.BlockingCall([batch](Napi::Env env, Napi::Function jsCallback) {
+    for (const DecodedFrame& frame : *batch) {
+      Napi::Object result = Napi::Object::New(env);
+      result.Set("protocol", Napi::String::New(env, frame.protocol));
+      result.Set("bits", Napi::Number::New(env, static_cast<double>(frame.bits)));
+      result.Set("data", Napi::Buffer<uint8_t>::Copy(env, frame.data.data(), frame.data.size()));
+      result.Set("timestampNs", Napi::BigInt::New(env, frame.timestamp_ns));
+      for (const auto& field : frame.fields) {
+        result.Set(field.first, Napi::Number::New(env, field.second));
+      }
+      jsCallback.Call({env.Null(), result});
+    }
+  });
+}
+
+Napi::Value Decoder::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsFunction()) {
+    Napi::TypeError::New(env, "Callback function expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!request) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  StopDecoding();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    decoder_->Reset();
+    next_seqno_ = 0;
+  }
+
+  if (!owner_->ClaimEdgeEvents(env, this, "Decoder")) {
+    return env.Undefined();
+  }
+
+  tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    info[0].As<Napi::Function>(),
+    "GPIO Decoder Callback",
+    0,
+    1
+  );
+  started_ = true;
+
+  reader_ = std::make_unique<EdgeReader>(
+    request,
+    [this](const std::vector<EdgeRecord>& events) { OnEvents(events); },
+    [this](const std::string& error) {
+      tsfn_.BlockingCall([error](Napi::Env env, Napi::Function jsCallback) {
+        jsCallback.Call({Napi::Error::New(env, error).Value(), env.Null()});
+      });
+    }
+  );
+  reader_->SetIdleHandler([this](uint64_t now_ns) { OnIdle(now_ns); }, -1);
+
+  std::string error = reader_->Start();
+  if (!error.empty()) {
+    StopDecoding();
+    Napi::Error::New(env, "Failed to start decoding: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value Decoder::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  StopDecoding();
+
+  return env.Undefined();
+}
+
+void Decoder::StopDecoding() {
+  if (started_) {
+    started_ = false;
+
+    if (reader_) {
+      reader_->Stop();
+      reader_.reset();
+    }
+
+    tsfn_.Release();
+  }
+
+  if (owner_) {
+    owner_->ReleaseEdgeEvents(this);
+  }
+}
+
+Napi::Value Decoder::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("edges", Napi::Number::New(env, static_cast<double>(edges_)));
+  result.Set("frames", Napi::Number::New(env, static_cast<double>(frames_)));
+  result.Set("lostEvents", Napi::Number::New(env, static_cast<double>(lost_events_)));
+
+  std::vector<std::pair<std::string, uint64_t>> stats;
+  decoder_->GetStats(stats);
+  for (const auto& stat : stats) {
+    result.Set(stat.first, Napi::Number::New(env, static_cast<double>(stat.second)));
+  }
+
+  return result;
+}
@@ -0,0 +1,148 @@
+#ifndef DECODER_H
+#define DECODER_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+#include "edge_reader.h"
+
+// Frame assembled by a protocol decoder
+struct DecodedFrame {
+  std::string protocol;
+  std::vector<uint8_t> data;
+  size_t bits;
+  uint64_t timestamp_ns;
+  std::vector<std::pair<std::string, double>> fields;
+};
+
+// Protocol plugin of the Decoder: turns the ordered edge stream of its lines
+// into frames. All methods run on the reader thread.
+class ProtocolDecoder {
+public:
+  virtual ~ProtocolDecoder() = default;
+
+  // Called for every edge of the request in kernel order
+  virtual void OnEdge(const EdgeRecord& edge, std::vector<DecodedFrame>& frames) = 0;
+
+  // Called after every wake-up of the reader thread; finishes frames whose
+  // inter-bit timeout expired
+  virtual void OnIdle(uint64_t now_ns, std::vector<DecodedFrame>& frames) {}
+
+  // CLOCK_MONOTONIC time at which OnIdle has to run next, 0 while no frame
+  // is in progress. The reader thread sleeps until then or the next edge.
+  virtual uint64_t NextDeadline() const { return 0; }
+
+  // Drops a partial frame, e.g. after lost events
+  virtual void Reset() = 0;
+
+  // Adds the decoder specific counters
+  virtual void GetStats(std::vector<std::pair<std::string, uint64_t>>& stats) const {}
+};
+
+// Creates a protocol decoder from its options; returns nullptr and throws a
+// JavaScript exception on invalid options
+using DecoderFactory = std::unique_ptr<ProtocolDecoder> (*)(Napi::Env env, Napi::Object options,
+                                                            const std::vector<unsigned int>& offsets);
+
+// Packs bits MSB first into bytes
+std::vector<uint8_t> PackBits(const std::vector<bool>& bits);
+
+// Level of a single line between two edges; a mark is the active level
+struct Pulse {
+  bool mark;
+  uint64_t start_ns;
+  uint64_t duration_ns;
+};
+
+// Turns the edges of one line into pulses
+class PulseTracker {
+public:
+  PulseTracker(unsigned int offset, bool active_low);
+
+  // Returns true and fills the pulse that the edge ended
+  bool Feed(const EdgeRecord& edge, Pulse& pulse);
+  void Reset();
+
+  unsigned int Offset() const { return offset_; }
+  bool HasEdge() const { return has_edge_; }
+  uint64_t LastEdgeNs() const { return last_ns_; }
+
+private:
+  unsigned int offset_;
+  bool active_low_;
+  bool has_edge_;
+  bool mark_;
+  uint64_t last_ns_;
+};
+
+// Whether a duration is within the relative tolerance of a nominal one
+bool NearDuration(uint64_t duration_ns, uint64_t nominal_ns, double tolerance);
+
+// Decodes Manchester half-bits (true = mark) into bits; a bit is one when
+// it changes from space to mark if one_is_rising. Tries both alignments,
+// since a half-bit at the idle level is invisible at either end of a frame.
+bool DecodeManchester(const std::vector<bool>& halves, bool one_is_rising, std::vector<bool>& bits);
+
+// Reads the line and invert options shared by single-line decoders
+bool ReadDecoderLine(Napi::Env env, Napi::Object options, const std::vector<unsigned int>& offsets,
+                     bool default_active_low, unsigned int& offset, bool& active_low);
+
+// Protocol factories, one per decoder_*.cpp
+std::unique_ptr<ProtocolDecoder> CreateWiegandDecoder(Napi::Env env, Napi::Object options,
+                                                      const std::vector<unsigned int>& offsets);
+std::unique_ptr<ProtocolDecoder> CreateNecDecoder(Napi::Env env, Napi::Object options,
+                                                  const std::vector<unsigned int>& offsets);
+std::unique_ptr<ProtocolDecoder> CreateRc5Decoder(Napi::Env env, Napi::Object options,
+                                                  const std::vector<unsigned int>& offsets);
+std::unique_ptr<ProtocolDecoder> CreateOokDecoder(Napi::Env env, Napi::Object options,
+                                                  const std::vector<unsigned int>& offsets);
+std::unique_ptr<ProtocolDecoder> CreateUartDecoder(Napi::Env env, Napi::Object options,
+                                                   const std::vector<unsigned int>& offsets);
+
+// Runs a protocol decoder on the edge events of a request and emits only
+// complete frames to JavaScript
+class Decoder : public Napi::ObjectWrap<Decoder> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  Decoder(const Napi::CallbackInfo& info);
+  ~Decoder();
+
+  // Wrapped methods
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  std::string protocol_;
+  std::unique_ptr<ProtocolDecoder> decoder_;
+  std::unique_ptr<EdgeReader> reader_;
+  Napi::ThreadSafeFunction tsfn_;
+  bool started_;
+
+  // Guards the decoder and the counters against GetStats
+  mutable std::mutex mutex_;
+  std::vector<EdgeRecord> ordered_;
+  uint64_t next_seqno_;
+  uint64_t edges_;
+  uint64_t frames_;
+  uint64_t lost_events_;
+
+  // Internal methods
+  void OnEvents(const std::vector<EdgeRecord>& events);
+  void OnIdle(uint64_t now_ns);
+  void Emit(std::vector<DecodedFrame>& frames);
+  void StopDecoding();
+};
+
+#endif // DECODER_H
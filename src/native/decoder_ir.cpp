@@ -0,0 +1,341 @@
+#include "decoder.h"
+#include "engine_utils.h"
+#include <algorithm>
+
+namespace {
+
+// NEC: 9 ms leader mark, 4.5 ms space, then 32 bits LSB first (address,
+// inverted address, command, inverted command). Every bit starts with a
+// 562.5 us mark; a short space is a 0, a three times longer one a 1. A held
+// key sends repeat codes of a leader mark followed by a 2.25 ms space.
+class NecDecoder : public ProtocolDecoder {
+public:
+  NecDecoder(unsigned int offset, bool active_low, double tolerance)
+    : tracker_(offset, active_low), tolerance_(tolerance), state_(State::kIdle), first_ns_(0),
+      have_last_(false), last_address_(0), last_command_(0),
+      noise_pulses_(0), invalid_frames_(0), repeats_(0) {
+  }
+
+  void OnEdge(const EdgeRecord& edge, std::vector<DecodedFrame>& frames) override {
+    Pulse pulse;
+    if (tracker_.Feed(edge, pulse)) {
+      OnPulse(pulse, frames);
+    }
+  }
+
+  void OnIdle(uint64_t now_ns, std::vector<DecodedFrame>& frames) override {
+    // A space longer than any symbol aborts a partial frame
+    if (state_ != State::kIdle && now_ns > tracker_.LastEdgeNs() && now_ns - tracker_.LastEdgeNs() >= kTimeoutNs) {
+      Abort();
+    }
+  }
+
+  uint64_t NextDeadline() const override {
+    return state_ != State::kIdle ? tracker_.LastEdgeNs() + kTimeoutNs : 0;
+  }
+
+  void Reset() override {
+    tracker_.Reset();
+    state_ = State::kIdle;
+    bits_.clear();
+  }
+
+  void GetStats(std::vector<std::pair<std::string, uint64_t>>& stats) const override {
+    stats.emplace_back("noisePulses", noise_pulses_);
+    stats.emplace_back("invalidFrames", invalid_frames_);
+    stats.emplace_back("repeats", repeats_);
+  }
+
+private:
+  enum class State { kIdle, kLeader, kBitMark, kBitSpace };
+
+  static constexpr uint64_t kUnitNs = 562500;
+  static constexpr uint64_t kTimeoutNs = 20000000;
+
+  PulseTracker tracker_;
+  double tolerance_;
+  State state_;
+  std::vector<bool> bits_;
+  uint64_t first_ns_;
+
+  bool have_last_;
+  uint32_t last_address_;
+  uint32_t last_command_;
+
+  uint64_t noise_pulses_;
+  uint64_t invalid_frames_;
+  uint64_t repeats_;
+
+  bool Near(const Pulse& pulse, uint64_t units) const {
+    return NearDuration(pulse.duration_ns, units * kUnitNs, tolerance_);
+  }
+
+  void Abort() {
+    invalid_frames_++;
+    state_ = State::kIdle;
+    bits_.clear();
+  }
+
+  void OnPulse(const Pulse& pulse, std::vector<DecodedFrame>& frames) {
+    switch (state_) {
+    case State::kIdle:
+      if (pulse.mark && Near(pulse, 16)) {
+        state_ = State::kLeader;
+        first_ns_ = pulse.start_ns;
+      } else if (pulse.mark) {
+        noise_pulses_++;
+      }
+      break;
+
+    case State::kLeader:
+      if (!pulse.mark && Near(pulse, 8)) {
+        bits_.clear();
+        state_ = State::kBitMark;
+      } else if (!pulse.mark && Near(pulse, 4)) {
+        state_ = State::kIdle;
+        if (have_last_) {
+          repeats_++;
+          Emit(frames, last_address_, last_command_, true);
+        }
+      } else {
+        Abort();
+      }
+      break;
+
+    case State::kBitMark:
+      if (pulse.mark && Near(pulse, 1)) {
+        state_ = State::kBitSpace;
+      } else {
+        Abort();
+      }
+      break;
+
+    case State::kBitSpace:
+      if (pulse.mark || !(Near(pulse, 1) || Near(pulse, 3))) {
+        Abort();
+        break;
+      }
+      bits_.push_back(Near(pulse, 3));
+      state_ = State::kBitMark;
+      if (bits_.size() == 32) {
+        Finish(frames);
+      }
+      break;
+    }
+  }
+
+  uint8_t Byte(size_t index) const {
+    uint8_t value = 0;
+    for (size_t i = 0; i < 8; i++) {
+      if (bits_[index * 8 + i]) {
+        value |= static_cast<uint8_t>(1u << i);
+      }
+    }
+    return value;
+  }
+
+  void Finish(std::vector<DecodedFrame>& frames) {
+    uint8_t address = Byte(0);
+    uint8_t address_inverted = Byte(1);
+    uint8_t command = Byte(2);
+    uint8_t command_inverted = Byte(3);
+    state_ = State::kIdle;
+    bits_.clear();
+
+    if ((command ^ command_inverted) != 0xff) {
+      invalid_frames_++;
+      return;
+    }
+
+    // Extended NEC uses both address bytes for a 16 bit address
+    uint32_t full_address = (address ^ address_inverted) == 0xff
+      ? address
+      : static_cast<uint32_t>(address) | (static_cast<uint32_t>(address_inverted) << 8);
+
+    have_last_ = true;
+    last_address_ = full_address;
+    last_command_ = command;
+    Emit(frames, full_address, command, false);
+  }
+
+  void Emit(std::vector<DecodedFrame>& frames, uint32_t address, uint32_t command, bool repeat) {
+    DecodedFrame frame;
+    frame.protocol = "nec";
+    frame.bits = repeat ? 0 : 32;
+    frame.timestamp_ns = first_ns_;
+    if (!repeat) {
+      frame.data = {
+        static_cast<uint8_t>(address & 0xff),
+        static_cast<uint8_t>(address > 0xff ? address >> 8 : ~address & 0xff),
+        static_cast<uint8_t>(command),
+        static_cast<uint8_t>(~command & 0xff)
+      };
+    }
+    frame.fields.emplace_back("address", address);
+    frame.fields.emplace_back("command", command);
+    frame.fields.emplace_back("repeat", repeat ? 1 : 0);
+    frames.push_back(std::move(frame));
+  }
+};
+
+// RC5: 14 Manchester coded bits of 1.778 ms, a 1 being a space followed by a
+// mark. Two start bits, a toggle bit that flips on every key press, 5 address
+// and 6 command bits; the inverted second start bit is the 7th command bit
+// of RC5X. A frame ends with the idle line after the last bit.
+class Rc5Decoder : public ProtocolDecoder {
+public:
+  Rc5Decoder(unsigned int offset, bool active_low, double tolerance)
+    : tracker_(offset, active_low), tolerance_(tolerance), first_ns_(0),
+      noise_pulses_(0), invalid_frames_(0) {
+  }
+
+  void OnEdge(const EdgeRecord& edge, std::vector<DecodedFrame>& frames) override {
+    Pulse pulse;
+    if (tracker_.Feed(edge, pulse)) {
+      OnPulse(pulse, frames);
+    }
+  }
+
+  void OnIdle(uint64_t now_ns, std::vector<DecodedFrame>& frames) override {
+    if (!halves_.empty() && now_ns > tracker_.LastEdgeNs() && now_ns - tracker_.LastEdgeNs() >= 3 * kHalfBitNs) {
+      Finish(frames);
+    }
+  }
+
+  uint64_t NextDeadline() const override {
+    return !halves_.empty() ? tracker_.LastEdgeNs() + 3 * kHalfBitNs : 0;
+  }
+
+  void Reset() override {
+    tracker_.Reset();
+    halves_.clear();
+  }
+
+  void GetStats(std::vector<std::pair<std::string, uint64_t>>& stats) const override {
+    stats.emplace_back("noisePulses", noise_pulses_);
+    stats.emplace_back("invalidFrames", invalid_frames_);
+  }
+
+private:
+  static constexpr uint64_t kHalfBitNs = 889000;
+  static constexpr size_t kBits = 14;
+
+  PulseTracker tracker_;
+  double tolerance_;
+  std::vector<bool> halves_;
+  uint64_t first_ns_;
+
+  uint64_t noise_pulses_;
+  uint64_t invalid_frames_;
+
+  void OnPulse(const Pulse& pulse, std::vector<DecodedFrame>& frames) {
+    if (halves_.empty()) {
+      // The first half of the leading start bit is the idle space
+      if (!pulse.mark) {
+        return;
+      }
+      first_ns_ = pulse.start_ns - kHalfBitNs;
+    }
+
+    size_t count = 0;
+    if (NearDuration(pulse.duration_ns, kHalfBitNs, tolerance_)) {
+      count = 1;
+    } else if (NearDuration(pulse.duration_ns, 2 * kHalfBitNs, tolerance_)) {
+      count = 2;
+    }
+
+    if (count == 0) {
+      if (!pulse.mark && !halves_.empty() && pulse.duration_ns > 2 * kHalfBitNs) {
+        Finish(frames);
+      } else if (halves_.empty()) {
+        noise_pulses_++;
+      } else {
+        invalid_frames_++;
+        halves_.clear();
+      }
+      return;
+    }
+
+    if (halves_.empty()) {
+      halves_.push_back(false);
+    }
+    halves_.insert(halves_.end(), count, pulse.mark);
+    if (halves_.size() > 2 * kBits) {
+      invalid_frames_++;
+      halves_.clear();
+    }
+  }
+
+  void Finish(std::vector<DecodedFrame>& frames) {
+    std::vector<bool> halves;
+    halves.swap(halves_);
+
+    // A trailing 0 bit ends in a space that merges with the idle line
+    if (halves.size() == 2 * kBits - 1) {
+      halves.push_back(false);
+    }
+
+    std::vector<bool> bits;
+    if (halves.size() != 2 * kBits || !DecodeManchester(halves, true, bits) || bits.size() != kBits || !bits[0]) {
+      invalid_frames_++;
+      return;
+    }
+
+    auto field = [&](size_t first, size_t count) {
+      uint32_t value = 0;
+      for (size_t i = first; i < first + count; i++) {
+        value = (value << 1) | (bits[i] ? 1 : 0);
+      }
+      return value;
+    };
+
+    uint32_t command = field(8, 6) | (bits[1] ? 0 : 0x40);
+
+    DecodedFrame frame;
+    frame.protocol = "rc5";
+    frame.bits = kBits;
+    frame.data = PackBits(bits);
+    frame.timestamp_ns = first_ns_;
+    frame.fields.emplace_back("address", field(3, 5));
+    frame.fields.emplace_back("command", command);
+    frame.fields.emplace_back("toggle", bits[2] ? 1 : 0);
+    frames.push_back(std::move(frame));
+  }
+};
+
+bool ReadTolerance(Napi::Env env, Napi::Object options, double& tolerance) {
+  tolerance = ReadNumber(options, "tolerance", 0.25);
+  if (tolerance <= 0 || tolerance >= 0.5) {
+    Napi::RangeError::New(env, "Tolerance must be between 0 and 0.5").ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+} // namespace
+
+// IR receiver modules demodulate the carrier and pull their output low
+// during a burst, so both decoders default to active low
+std::unique_ptr<ProtocolDecoder> CreateNecDecoder(Napi::Env env, Napi::Object options,
+                                                  const std::vector<unsigned int>& offsets) {
+  unsigned int offset = 0;
+  bool active_low = true;
+  double tolerance = 0;
+  if (!ReadDecoderLine(env, options, offsets, true, offset, active_low) ||
+      !ReadTolerance(env, options, tolerance)) {
+    return nullptr;
+  }
+  return std::make_unique<NecDecoder>(offset, active_low, tolerance);
+}
+
+std::unique_ptr<ProtocolDecoder> CreateRc5Decoder(Napi::Env env, Napi::Object options,
+                                                  const std::vector<unsigned int>& offsets) {
+  unsigned int offset = 0;
+  bool active_low = true;
+  double tolerance = 0;
+  if (!ReadDecoderLine(env, options, offsets, true, offset, active_low) ||
+      !ReadTolerance(env, options, tolerance)) {
+    return nullptr;
+  }
+  return std::make_unique<Rc5Decoder>(offset, active_low, tolerance);
+}
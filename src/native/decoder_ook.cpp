@@ -0,0 +1,201 @@
+#include "decoder.h"
+#include "engine_utils.h"
+#include <algorithm>
+
+namespace {
+
+// Generic on-off keyed pulse trains of cheap 433 MHz remotes and sensors,
+// as delivered by a superheterodyne receiver module. Frames are separated
+// by a long space. Two line codings are supported:
+//  - pwm: every bit is a mark, a short one for 0 and a long one for 1
+//    (PT2262, EV1527 and most remote sockets)
+//  - manchester: marks and spaces of one or two half-bit periods, a 1 being
+//    a space followed by a mark (IEEE 802.3 convention, weather sensors)
+// Receivers output noise while no transmitter is active, so pulses that fit
+// neither period are dropped and frames shorter than minBits discarded.
+class OokDecoder : public ProtocolDecoder {
+public:
+  OokDecoder(unsigned int offset, bool active_low, bool manchester, uint64_t short_ns, uint64_t long_ns,
+             uint64_t gap_ns, double tolerance, size_t min_bits, size_t max_bits)
+    : tracker_(offset, active_low), manchester_(manchester), short_ns_(short_ns), long_ns_(long_ns),
+      gap_ns_(gap_ns), tolerance_(tolerance), min_bits_(min_bits), max_bits_(max_bits), active_(false),
+      first_ns_(0), noise_pulses_(0), short_frames_(0), invalid_frames_(0) {
+  }
+
+  void OnEdge(const EdgeRecord& edge, std::vector<DecodedFrame>& frames) override {
+    Pulse pulse;
+    if (tracker_.Feed(edge, pulse)) {
+      OnPulse(pulse, frames);
+    }
+  }
+
+  void OnIdle(uint64_t now_ns, std::vector<DecodedFrame>& frames) override {
+    if (active_ && now_ns > tracker_.LastEdgeNs() && now_ns - tracker_.LastEdgeNs() >= gap_ns_) {
+      Finish(frames);
+    }
+  }
+
+  uint64_t NextDeadline() const override {
+    return active_ ? tracker_.LastEdgeNs() + gap_ns_ : 0;
+  }
+
+  void Reset() override {
+    tracker_.Reset();
+    Clear();
+  }
+
+  void GetStats(std::vector<std::pair<std::string, uint64_t>>& stats) const override {
+    stats.emplace_back("noisePulses", noise_pulses_);
+    stats.emplace_back("shortFrames", short_frames_);
+    stats.emplace_back("invalidFrames", invalid_frames_);
+  }
+
+private:
+  PulseTracker tracker_;
+  bool manchester_;
+  uint64_t short_ns_;
+  uint64_t long_ns_;
+  uint64_t gap_ns_;
+  double tolerance_;
+  size_t min_bits_;
+  size_t max_bits_;
+
+  // Bits for pwm, half-bits for manchester
+  std::vector<bool> symbols_;
+  bool active_;
+  uint64_t first_ns_;
+
+  uint64_t noise_pulses_;
+  uint64_t short_frames_;
+  uint64_t invalid_frames_;
+
+  void Clear() {
+    symbols_.clear();
+    active_ = false;
+  }
+
+  // Drops the frame in progress; a train that never got past a few symbols
+  // was most likely receiver noise rather than a damaged frame
+  void Drop() {
+    if (symbols_.size() < (manchester_ ? 2 * min_bits_ : min_bits_)) {
+      noise_pulses_++;
+    } else {
+      invalid_frames_++;
+    }
+    Clear();
+  }
+
+  void OnPulse(const Pulse& pulse, std::vector<DecodedFrame>& frames) {
+    if (!pulse.mark && pulse.duration_ns >= gap_ns_) {
+      if (active_) {
+        Finish(frames);
+      }
+      return;
+    }
+
+    if (!active_) {
+      if (!pulse.mark) {
+        return;
+      }
+      active_ = true;
+      first_ns_ = pulse.start_ns;
+    }
+
+    bool is_short = NearDuration(pulse.duration_ns, short_ns_, tolerance_);
+    bool is_long = NearDuration(pulse.duration_ns, long_ns_, tolerance_);
+    if (!is_short && !is_long) {
+      Drop();
+      return;
+    }
+
+    if (manchester_) {
+      symbols_.insert(symbols_.end(), is_long ? 2 : 1, pulse.mark);
+    } else if (pulse.mark) {
+      symbols_.push_back(is_long);
+    }
+
+    if (symbols_.size() > (manchester_ ? 2 * max_bits_ : max_bits_)) {
+      Drop();
+    }
+  }
+
+  void Finish(std::vector<DecodedFrame>& frames) {
+    std::vector<bool> bits;
+    if (manchester_) {
+      if (!DecodeManchester(symbols_, true, bits)) {
+        invalid_frames_++;
+        Clear();
+        return;
+      }
+    } else {
+      bits.swap(symbols_);
+    }
+
+    if (bits.size() < min_bits_) {
+      short_frames_++;
+    } else {
+      DecodedFrame frame;
+      frame.protocol = "ook";
+      frame.bits = bits.size();
+      frame.data = PackBits(bits);
+      frame.timestamp_ns = first_ns_;
+      frames.push_back(std::move(frame));
+    }
+    Clear();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<ProtocolDecoder> CreateOokDecoder(Napi::Env env, Napi::Object options,
+                                                  const std::vector<unsigned int>& offsets) {
+  unsigned int offset = 0;
+  bool active_low = false;
+  if (!ReadDecoderLine(env, options, offsets, false, offset, active_low)) {
+    return nullptr;
+  }
+
+  bool manchester = false;
+  Napi::Value encoding = options.Get("encoding");
+  if (encoding.IsString()) {
+    std::string name = encoding.As<Napi::String>().Utf8Value();
+    if (name == "manchester") {
+      manchester = true;
+    } else if (name != "pwm") {
+      Napi::TypeError::New(env, "OOK encoding must be 'pwm' or 'manchester'").ThrowAsJavaScriptException();
+      return nullptr;
+    }
+  } else if (!encoding.IsUndefined()) {
+    Napi::TypeError::New(env, "OOK encoding must be a string").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+
+  // For Manchester the short period is the half-bit, the long one a full bit
+  double short_us = ReadNumber(options, "shortUs", manchester ? 500 : 350);
+  double long_us = ReadNumber(options, "longUs", (manchester ? 2 : 3) * short_us);
+  double gap_us = ReadNumber(options, "gapUs", 5000);
+  double tolerance = ReadNumber(options, "tolerance", 0.3);
+  double min_bits = ReadNumber(options, "minBits", 8);
+  double max_bits = ReadNumber(options, "maxBits", 256);
+
+  if (tolerance <= 0 || tolerance >= 0.5 || min_bits < 1 || max_bits < min_bits) {
+    Napi::RangeError::New(env, "Invalid OOK options: expected 0 < tolerance < 0.5 and 1 <= minBits <= maxBits").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+  if (short_us <= 0 || long_us <= short_us * (1 + tolerance) / (1 - tolerance) || gap_us <= long_us) {
+    Napi::RangeError::New(env, "Invalid OOK timing: expected 0 < shortUs < longUs < gapUs with distinguishable periods").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+
+  return std::make_unique<OokDecoder>(
+    offset,
+    active_low,
+    manchester,
+    static_cast<uint64_t>(short_us * 1000),
+    static_cast<uint64_t>(long_us * 1000),
+    static_cast<uint64_t>(gap_us * 1000),
+    tolerance,
+    static_cast<size_t>(min_bits),
+    static_cast<size_t>(max_bits)
+  );
+}
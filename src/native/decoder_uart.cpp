@@ -0,0 +1,231 @@
+#include "decoder.h"
+#include "engine_utils.h"
+#include <algorithm>
+
+namespace {
+
+enum class Parity { kNone, kEven, kOdd };
+
+// Asynchronous serial receiver. The line idles at the mark level; a falling
+// edge to space starts a character, whose bits are sampled in the middle of
+// each bit period. Since the level only changes at edges, a sample is the
+// level after the last edge before the sample time, so no polling is needed:
+// pending sample points are resolved whenever an edge arrives or the line
+// has been quiet long enough. Received bytes are collected into chunks that
+// are emitted when the line goes idle or the chunk is full.
+class UartDecoder : public ProtocolDecoder {
+public:
+  UartDecoder(unsigned int offset, bool inverted, double baud, unsigned int data_bits, Parity parity,
+              unsigned int stop_bits, size_t max_chunk)
+    : offset_(offset), inverted_(inverted), bit_ns_(1e9 / baud), data_bits_(data_bits), parity_(parity),
+      stop_bits_(stop_bits), max_chunk_(max_chunk), mark_(true), last_ns_(0), state_(State::kIdle),
+      start_ns_(0), bit_(0), shift_(0), ones_(0), chunk_ns_(0), flush_ns_(0),
+      false_starts_(0), framing_errors_(0), parity_errors_(0) {
+    frame_bits_ = 1 + data_bits_ + (parity_ == Parity::kNone ? 0 : 1) + stop_bits_;
+  }
+
+  void OnEdge(const EdgeRecord& edge, std::vector<DecodedFrame>& frames) override {
+    if (edge.offset != offset_) {
+      return;
+    }
+
+    SampleUntil(edge.timestamp_ns, frames);
+
+    mark_ = edge.rising != inverted_;
+    last_ns_ = edge.timestamp_ns;
+
+    if (state_ == State::kIdle && !mark_) {
+      state_ = State::kFrame;
+      start_ns_ = edge.timestamp_ns;
+      bit_ = 0;
+      shift_ = 0;
+      ones_ = 0;
+      if (chunk_.empty()) {
+        chunk_ns_ = start_ns_;
+      }
+    } else if (state_ == State::kBreak && mark_) {
+      state_ = State::kIdle;
+    }
+  }
+
+  void OnIdle(uint64_t now_ns, std::vector<DecodedFrame>& frames) override {
+    // Edges up to a bit period old may still be queued in the kernel, so
+    // only sample points older than that are resolved here
+    uint64_t margin = static_cast<uint64_t>(bit_ns_);
+    if (now_ns > last_ns_ + margin) {
+      SampleUntil(now_ns - margin, frames);
+    }
+
+    if (!chunk_.empty() && state_ != State::kFrame && now_ns >= flush_ns_) {
+      Flush(frames);
+    }
+  }
+
+  uint64_t NextDeadline() const override {
+    // The last sample point of a frame resolves a bit period after it, a
+    // chunk is emitted once the line stayed quiet for two characters
+    if (state_ == State::kFrame) {
+      uint64_t margin = static_cast<uint64_t>(bit_ns_);
+      return std::max(SampleTime(frame_bits_ - 1), last_ns_) + margin + 1;
+    }
+    return chunk_.empty() ? 0 : flush_ns_;
+  }
+
+  void Reset() override {
+    state_ = State::kBreak;
+    mark_ = false;
+  }
+
+  void GetStats(std::vector<std::pair<std::string, uint64_t>>& stats) const override {
+    stats.emplace_back("falseStarts", false_starts_);
+    stats.emplace_back("framingErrors", framing_errors_);
+    stats.emplace_back("parityErrors", parity_errors_);
+  }
+
+private:
+  // kBreak waits for the mark level after a framing error or lost events
+  enum class State { kIdle, kFrame, kBreak };
+
+  unsigned int offset_;
+  bool inverted_;
+  double bit_ns_;
+  unsigned int data_bits_;
+  Parity parity_;
+  unsigned int stop_bits_;
+  unsigned int frame_bits_;
+  size_t max_chunk_;
+
+  bool mark_;
+  uint64_t last_ns_;
+  State state_;
+  uint64_t start_ns_;
+  unsigned int bit_;
+  uint32_t shift_;
+  unsigned int ones_;
+
+  std::vector<uint8_t> chunk_;
+  uint64_t chunk_ns_;
+  uint64_t flush_ns_;
+
+  uint64_t false_starts_;
+  uint64_t framing_errors_;
+  uint64_t parity_errors_;
+
+  uint64_t SampleTime(unsigned int bit) const {
+    return start_ns_ + static_cast<uint64_t>((bit + 0.5) * bit_ns_);
+  }
+
+  // Resolves the sample points before a time with the current level
+  void SampleUntil(uint64_t time_ns, std::vector<DecodedFrame>& frames) {
+    while (state_ == State::kFrame && SampleTime(bit_) < time_ns) {
+      Sample(mark_, frames);
+    }
+  }
+
+  void Sample(bool level, std::vector<DecodedFrame>& frames) {
+    unsigned int bit = bit_++;
+
+    if (bit == 0) {
+      // A glitch shorter than half a bit is not a start bit
+      if (level) {
+        false_starts_++;
+        state_ = State::kIdle;
+      }
+      return;
+    }
+
+    if (bit <= data_bits_) {
+      if (level) {
+        shift_ |= 1u << (bit - 1);
+        ones_++;
+      }
+      return;
+    }
+
+    if (parity_ != Parity::kNone && bit == data_bits_ + 1) {
+      if (level) {
+        ones_++;
+      }
+      return;
+    }
+
+    if (!level) {
+      framing_errors_++;
+      state_ = State::kBreak;
+      return;
+    }
+
+    if (bit + 1 < frame_bits_) {
+      return;
+    }
+
+    state_ = State::kIdle;
+    bool parity_ok = parity_ == Parity::kNone || (ones_ % 2 == 0) == (parity_ == Parity::kEven);
+    if (!parity_ok) {
+      parity_errors_++;
+      return;
+    }
+
+    chunk_.push_back(static_cast<uint8_t>(shift_));
+    flush_ns_ = SampleTime(bit) + static_cast<uint64_t>(2 * frame_bits_ * bit_ns_);
+    if (chunk_.size() >= max_chunk_) {
+      Flush(frames);
+    }
+  }
+
+  void Flush(std::vector<DecodedFrame>& frames) {
+    DecodedFrame frame;
+    frame.protocol = "uart";
+    frame.bits = chunk_.size() * 8;
+    frame.data.swap(chunk_);
+    frame.timestamp_ns = chunk_ns_;
+    frames.push_back(std::move(frame));
+  }
+};
+
+} // namespace
+
+std::unique_ptr<ProtocolDecoder> CreateUartDecoder(Napi::Env env, Napi::Object options,
+                                                   const std::vector<unsigned int>& offsets) {
+  unsigned int offset = 0;
+  bool inverted = false;
+  if (!ReadDecoderLine(env, options, offsets, false, offset, inverted)) {
+    return nullptr;
+  }
+
+  double baud = ReadNumber(options, "baud", 9600);
+  double data_bits = ReadNumber(options, "dataBits", 8);
+  double stop_bits = ReadNumber(options, "stopBits", 1);
+  double max_chunk = ReadNumber(options, "maxChunk", 256);
+  if (baud <= 0 || baud > 115200 || data_bits < 5 || data_bits > 8 || (stop_bits != 1 && stop_bits != 2) || max_chunk < 1) {
+    Napi::RangeError::New(env, "Invalid UART options: expected 0 < baud <= 115200, 5 <= dataBits <= 8, stopBits 1 or 2 and maxChunk >= 1").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+
+  Parity parity = Parity::kNone;
+  Napi::Value parity_value = options.Get("parity");
+  if (parity_value.IsString()) {
+    std::string name = parity_value.As<Napi::String>().Utf8Value();
+    if (name == "even") {
+      parity = Parity::kEven;
+    } else if (name == "odd") {
+      parity = Parity::kOdd;
+    } else if (name != "none") {
+      Napi::TypeError::New(env, "UART parity must be 'none', 'even' or 'odd'").ThrowAsJavaScriptException();
+      return nullptr;
+    }
+  } else if (!parity_value.IsUndefined()) {
+    Napi::TypeError::New(env, "UART parity must be a string").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+
+  return std::make_unique<UartDecoder>(
+    offset,
+    inverted,
+    baud,
+    static_cast<unsigned int>(data_bits),
+    parity,
+    static_cast<unsigned int>(stop_bits),
+    static_cast<size_t>(max_chunk)
+  );
+}
@@ -0,0 +1,166 @@
+#include "decoder.h"
+#include "engine_utils.h"
+#include <algorithm>
+
+namespace {
+
+// Wiegand: both lines idle high, a low pulse on D0 sends a 0 bit and a low
+// pulse on D1 a 1 bit. A frame ends when no pulse follows within the
+// inter-bit timeout.
+class WiegandDecoder : public ProtocolDecoder {
+public:
+  WiegandDecoder(unsigned int d0, unsigned int d1, uint64_t timeout_ns, bool parity, size_t min_bits, size_t max_bits)
+    : d0_(d0), d1_(d1), timeout_ns_(timeout_ns), parity_(parity), min_bits_(min_bits), max_bits_(max_bits),
+      first_ns_(0), last_ns_(0), overflow_(false), short_frames_(0), parity_errors_(0), overflows_(0) {
+  }
+
+  void OnEdge(const EdgeRecord& edge, std::vector<DecodedFrame>& frames) override {
+    if (edge.rising || (edge.offset != d0_ && edge.offset != d1_)) {
+      return;
+    }
+
+    if (!bits_.empty() && edge.timestamp_ns - last_ns_ >= timeout_ns_) {
+      Finish(frames);
+    }
+
+    if (bits_.empty()) {
+      first_ns_ = edge.timestamp_ns;
+    }
+    last_ns_ = edge.timestamp_ns;
+
+    if (bits_.size() >= max_bits_) {
+      overflow_ = true;
+      return;
+    }
+    bits_.push_back(edge.offset == d1_);
+  }
+
+  void OnIdle(uint64_t now_ns, std::vector<DecodedFrame>& frames) override {
+    if (!bits_.empty() && now_ns > last_ns_ && now_ns - last_ns_ >= timeout_ns_) {
+      Finish(frames);
+    }
+  }
+
+  uint64_t NextDeadline() const override {
+    return bits_.empty() ? 0 : last_ns_ + timeout_ns_;
+  }
+
+  void Reset() override {
+    bits_.clear();
+    overflow_ = false;
+  }
+
+  void GetStats(std::vector<std::pair<std::string, uint64_t>>& stats) const override {
+    stats.emplace_back("shortFrames", short_frames_);
+    stats.emplace_back("parityErrors", parity_errors_);
+    stats.emplace_back("overflows", overflows_);
+  }
+
+private:
+  unsigned int d0_;
+  unsigned int d1_;
+  uint64_t timeout_ns_;
+  bool parity_;
+  size_t min_bits_;
+  size_t max_bits_;
+
+  std::vector<bool> bits_;
+  uint64_t first_ns_;
+  uint64_t last_ns_;
+  bool overflow_;
+
+  uint64_t short_frames_;
+  uint64_t parity_errors_;
+  uint64_t overflows_;
+
+  // Even parity over the first half of the payload in the leading bit, odd
+  // parity over the second half in the trailing bit (26 and 34 bit formats)
+  bool CheckParity() const {
+    size_t n = bits_.size();
+    if (n % 2 != 0) {
+      return true;
+    }
+
+    size_t half = (n - 2) / 2;
+    bool even = bits_[0];
+    for (size_t i = 1; i <= half; i++) {
+      even = even != bits_[i];
+    }
+    bool odd = bits_[n - 1];
+    for (size_t i = half + 1; i < n - 1; i++) {
+      odd = odd != bits_[i];
+    }
+    return !even && odd;
+  }
+
+  uint64_t Field(size_t first, size_t count) const {
+    uint64_t value = 0;
+    for (size_t i = first; i < first + count; i++) {
+      value = (value << 1) | (bits_[i] ? 1 : 0);
+    }
+    return value;
+  }
+
+  void Finish(std::vector<DecodedFrame>& frames) {
+    size_t n = bits_.size();
+
+    if (overflow_) {
+      overflows_++;
+    } else if (n < min_bits_) {
+      short_frames_++;
+    } else if (parity_ && !CheckParity()) {
+      parity_errors_++;
+    } else {
+      DecodedFrame frame;
+      frame.protocol = "wiegand";
+      frame.bits = n;
+      frame.data = PackBits(bits_);
+      frame.timestamp_ns = first_ns_;
+
+      // Standard formats: facility code and card number between the parity bits
+      if (n == 26) {
+        frame.fields.emplace_back("facility", static_cast<double>(Field(1, 8)));
+        frame.fields.emplace_back("card", static_cast<double>(Field(9, 16)));
+      } else if (n == 34) {
+        frame.fields.emplace_back("facility", static_cast<double>(Field(1, 16)));
+        frame.fields.emplace_back("card", static_cast<double>(Field(17, 16)));
+      }
+      frames.push_back(std::move(frame));
+    }
+
+    Reset();
+  }
+};
+
+} // namespace
+
+std::unique_ptr<ProtocolDecoder> CreateWiegandDecoder(Napi::Env env, Napi::Object options,
+                                                      const std::vector<unsigned int>& offsets) {
+  int d0 = -1;
+  int d1 = -1;
+  if (!ReadLineOffset(env, options, "d0", offsets, true, d0) ||
+      !ReadLineOffset(env, options, "d1", offsets, true, d1)) {
+    return nullptr;
+  }
+  if (d0 == d1) {
+    Napi::RangeError::New(env, "D0 and D1 must be different lines").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+
+  double timeout_ms = ReadNumber(options, "timeoutMs", 25);
+  double min_bits = ReadNumber(options, "minBits", 4);
+  double max_bits = ReadNumber(options, "maxBits", 128);
+  if (timeout_ms <= 0 || min_bits < 1 || max_bits < min_bits) {
+    Napi::RangeError::New(env, "Invalid Wiegand options: expected timeoutMs > 0 and 1 <= minBits <= maxBits").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+
+  return std::make_unique<WiegandDecoder>(
+    static_cast<unsigned int>(d0),
+    static_cast<unsigned int>(d1),
+    static_cast<uint64_t>(timeout_ms * 1e6),
+    ReadBoolean(options, "parity", true),
+    static_cast<size_t>(min_bits),
+    static_cast<size_t>(max_bits)
+  );
+}
@@ -0,0 +1,227 @@
+#include "dht.h"
+#include "timing.h"
+#include "engine_utils.h"
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+Napi::FunctionReference DhtSensor::constructor;
+
+namespace {
+
+// Response bits are 50 us low followed by 26-28 us high for a 0 and 70 us
+// high for a 1
+const uint64_t kBitThresholdNs = 48000;
+const size_t kBits = 40;
+
+} // namespace
+
+Napi::Object DhtSensor::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "DhtSensor", {
+    InstanceMethod("read", &DhtSensor::Read),
+    InstanceMethod("getStats", &DhtSensor::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("DhtSensor", func);
+  return exports;
+}
+
+DhtSensor::DhtSensor(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<DhtSensor>(info), owner_(nullptr), line_(0), dht11_(false), pull_up_(true), start_ns_(0),
+    timeout_ns_(0), buffer_(128), reads_(0), checksum_errors_(0), timeouts_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  int line = -1;
+  if (!ReadLineOffset(env, options, "line", owner_->GetOffsets(), true, line)) {
+    return;
+  }
+  line_ = static_cast<unsigned int>(line);
+
+  Napi::Value model = options.Get("model");
+  if (model.IsString()) {
+    std::string name = model.As<Napi::String>().Utf8Value();
+    if (name == "dht11") {
+      dht11_ = true;
+    } else if (name != "dht22") {
+      Napi::TypeError::New(env, "Sensor model must be 'dht11' or 'dht22'").ThrowAsJavaScriptException();
+      return;
+    }
+  } else if (!model.IsUndefined()) {
+    Napi::TypeError::New(env, "Sensor model must be a string").ThrowAsJavaScriptException();
+    return;
+  }
+
+  pull_up_ = ReadBoolean(options, "pullUp", true);
+
+  // The DHT11 needs at least 18 ms to wake up, the DHT22 at least 1 ms
+  double start_us = ReadNumber(options, "startUs", dht11_ ? 20000 : 1100);
+  double timeout_ms = ReadNumber(options, "timeoutMs", 10);
+  if (start_us <= 0 || timeout_ms <= 0) {
+    Napi::RangeError::New(env, "Start pulse and timeout must be positive").ThrowAsJavaScriptException();
+    return;
+  }
+  start_ns_ = static_cast<uint64_t>(start_us * 1e3);
+  timeout_ns_ = static_cast<uint64_t>(timeout_ms * 1e6);
+}
+
+DhtSensor::~DhtSensor() {
+}
+
+DhtReading DhtSensor::Measure(const gpiod::line_config& drive_low, const gpiod::line_config& release) {
+  std::lock_guard<std::mutex> lock(owner_->BusMutex());
+
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!request) {
+    throw std::runtime_error("line request is not active");
+  }
+
+  DrainEdgeEvents(*request, buffer_);
+
+  // Start signal; edge detection is only possible while the line is an input
+  request->reconfigure_lines(drive_low);
+  PreciseSleepUntilNs(MonotonicNowNs() + start_ns_);
+  request->reconfigure_lines(release);
+
+  // Response: 80 us low, 80 us high, then 40 bits of two edges each
+  std::vector<uint64_t> widths;
+  widths.reserve(kBits + 2);
+  uint64_t rising_ns = 0;
+  bool high = false;
+  uint64_t timestamp_ns = 0;
+  uint64_t deadline = MonotonicNowNs() + timeout_ns_;
+
+  while (widths.size() < kBits + 1) {
+    uint64_t now = MonotonicNowNs();
+    if (now >= deadline || !request->wait_edge_events(std::chrono::nanoseconds(deadline - now))) {
+      break;
+    }
+
+    size_t count = request->read_edge_events(buffer_);
+    for (size_t i = 0; i < count; i++) {
+      const gpiod::edge_event& event = buffer_.get_event(i);
+      if (event.line_offset() != line_) {
+        continue;
+      }
+
+      uint64_t ns = event.timestamp_ns().ns();
+      if (timestamp_ns == 0) {
+        timestamp_ns = ns;
+      }
+      if (event.type() == gpiod::edge_event::event_type::RISING_EDGE) {
+        rising_ns = ns;
+        high = true;
+      } else if (high) {
+        widths.push_back(ns - rising_ns);
+        high = false;
+      }
+    }
+  }
+
+  // The rising edge of the release may be missed, so the data bits are the
+  // last 40 high pulses
+  if (widths.size() < kBits) {
+    timeouts_++;
+    throw std::runtime_error("incomplete response: " + std::to_string(widths.size()) + " of " +
+                             std::to_string(kBits) + " bits");
+  }
+
+  uint8_t bytes[5] = {0, 0, 0, 0, 0};
+  size_t first = widths.size() - kBits;
+  for (size_t i = 0; i < kBits; i++) {
+    if (widths[first + i] > kBitThresholdNs) {
+      bytes[i / 8] = static_cast<uint8_t>(bytes[i / 8] | (0x80 >> (i % 8)));
+    }
+  }
+
+  if (static_cast<uint8_t>(bytes[0] + bytes[1] + bytes[2] + bytes[3]) != bytes[4]) {
+    checksum_errors_++;
+    throw std::runtime_error("checksum mismatch");
+  }
+
+  DhtReading reading;
+  reading.timestamp_ns = timestamp_ns;
+  if (dht11_) {
+    reading.humidity = bytes[0] + bytes[1] / 10.0;
+    reading.temperature = bytes[2] + (bytes[3] & 0x7f) / 10.0;
+    if (bytes[3] & 0x80) {
+      reading.temperature = -reading.temperature;
+    }
+  } else {
+    reading.humidity = ((bytes[0] << 8) | bytes[1]) / 10.0;
+    reading.temperature = (((bytes[2] & 0x7f) << 8) | bytes[3]) / 10.0;
+    if (bytes[2] & 0x80) {
+      reading.temperature = -reading.temperature;
+    }
+  }
+
+  reads_++;
+  return reading;
+}
+
+Napi::Value DhtSensor::Read(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!owner_->GetRequest()) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto configs = std::make_shared<SingleWireConfigs>(BuildSingleWireConfigs(owner_, line_, pull_up_, true));
+  auto reading = std::make_shared<DhtReading>();
+  PromiseWorker* worker = new PromiseWorker(env, "GPIO DHT Read", info.This().As<Napi::Object>(), owner_,
+    [this, configs, reading]() {
+      try {
+        *reading = Measure(configs->drive_low, configs->release);
+      } catch (const std::exception& e) {
+        throw std::runtime_error("DHT read failed: " + std::string(e.what()));
+      }
+    },
+    [reading](Napi::Env env) -> Napi::Value {
+      Napi::Object result = Napi::Object::New(env);
+      result.Set("humidity", Napi::Number::New(env, reading->humidity));
+      result.Set("temperature", Napi::Number::New(env, reading->temperature));
+      result.Set("timestampNs", Napi::BigInt::New(env, reading->timestamp_ns));
+      return result;
+    }
+  );
+  if (!worker->ClaimEdgeEvents(env, "DhtSensor.read()")) {
+    delete worker;
+    return env.Undefined();
+  }
+  Napi::Promise promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value DhtSensor::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("reads", Napi::Number::New(env, static_cast<double>(reads_.load())));
+  result.Set("checksumErrors", Napi::Number::New(env, static_cast<double>(checksum_errors_.load())));
+  result.Set("timeouts", Napi::Number::New(env, static_cast<double>(timeouts_.load())));
+
+  return result;
+}
@@ -0,0 +1,54 @@
+#ifndef DHT_H
+#define DHT_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include "line_request.h"
+
+// Result of a DHT11/DHT22 reading
+struct DhtReading {
+  double humidity;
+  double temperature;
+  uint64_t timestamp_ns;
+};
+
+// Reads DHT11/DHT22 humidity and temperature sensors: the host pulls the
+// data line low to start a measurement, then switches it to an input and
+// decodes the 40 response bits from the widths of the high pulses
+class DhtSensor : public Napi::ObjectWrap<DhtSensor> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  DhtSensor(const Napi::CallbackInfo& info);
+  ~DhtSensor();
+
+  // Wrapped methods
+  Napi::Value Read(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  unsigned int line_;
+  bool dht11_;
+  bool pull_up_;
+  uint64_t start_ns_;
+  uint64_t timeout_ns_;
+
+  // Only used by the reading running on the worker thread
+  gpiod::edge_event_buffer buffer_;
+
+  std::atomic<uint64_t> reads_;
+  std::atomic<uint64_t> checksum_errors_;
+  std::atomic<uint64_t> timeouts_;
+
+  // Internal methods, called from the worker thread
+  DhtReading Measure(const gpiod::line_config& drive_low, const gpiod::line_config& release);
+};
+
+#endif // DHT_H
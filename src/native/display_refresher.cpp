@@ -0,0 +1,254 @@
+#include "display_refresher.h"
+#include "timing.h"
+#include "engine_utils.h"
+#include <algorithm>
+
+Napi::FunctionReference DisplayRefresher::constructor;
+
+Napi::Object DisplayRefresher::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "DisplayRefresher", {
+    InstanceMethod("setFrame", &DisplayRefresher::SetFrame),
+    InstanceMethod("start", &DisplayRefresher::Start),
+    InstanceMethod("stop", &DisplayRefresher::Stop),
+    InstanceMethod("getStats", &DisplayRefresher::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("DisplayRefresher", func);
+  return exports;
+}
+
+DisplayRefresher::DisplayRefresher(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<DisplayRefresher>(info), owner_(nullptr), digit_active_low_(false), segment_active_low_(false),
+    period_ns_(0), blank_ns_(0), spin_ns_(0), back_(0), middle_(1), front_(2), digit_(0), levels_known_(false),
+    cycles_(0), frames_(0), writes_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  if (!ReadLineOffsets(env, options, "digits", owner_->GetOffsets(), digits_) ||
+      !ReadLineOffsets(env, options, "segments", owner_->GetOffsets(), segments_)) {
+    return;
+  }
+  if (digits_.empty() || segments_.empty() || segments_.size() > 8) {
+    Napi::RangeError::New(env, "At least one digit line and 1 to 8 segment lines expected").ThrowAsJavaScriptException();
+    return;
+  }
+  for (unsigned int digit : digits_) {
+    if (std::find(segments_.begin(), segments_.end(), digit) != segments_.end()) {
+      Napi::RangeError::New(env, "Offset " + std::to_string(digit) + " is both a digit and a segment").ThrowAsJavaScriptException();
+      return;
+    }
+  }
+
+  digit_active_low_ = ReadBoolean(options, "digitActiveLow", false);
+  segment_active_low_ = ReadBoolean(options, "segmentActiveLow", false);
+
+  double rate_hz = ReadNumber(options, "rateHz", 1000);
+  double blank_us = ReadNumber(options, "blankUs", 0);
+  double spin_us = ReadNumber(options, "spinUs", 0);
+  if (rate_hz <= 0 || blank_us < 0 || spin_us < 0) {
+    Napi::RangeError::New(env, "Invalid refresh timing: rate must be positive, blank and spin time must not be negative").ThrowAsJavaScriptException();
+    return;
+  }
+  period_ns_ = static_cast<uint64_t>(1e9 / rate_hz);
+  blank_ns_ = static_cast<uint64_t>(blank_us * 1e3);
+  spin_ns_ = static_cast<uint64_t>(spin_us * 1e3);
+  if (blank_ns_ >= period_ns_) {
+    Napi::RangeError::New(env, "Blank time must be shorter than the digit period").ThrowAsJavaScriptException();
+    return;
+  }
+
+  for (auto& buffer : buffers_) {
+    buffer.assign(digits_.size(), 0);
+  }
+  levels_.assign(digits_.size() + segments_.size(), false);
+  next_ = levels_;
+  blank_ = levels_;
+  changes_.reserve(levels_.size());
+}
+
+DisplayRefresher::~DisplayRefresher() {
+  refresh_.Stop();
+}
+
+void DisplayRefresher::Write(gpiod::line_request& request, const std::vector<bool>& levels) {
+  // Only lines that change are written, all of them with one ioctl
+  changes_.clear();
+  for (size_t i = 0; i < levels.size(); i++) {
+    if (levels_known_ && levels[i] == levels_[i]) {
+      continue;
+    }
+
+    if (i < digits_.size()) {
+      changes_.emplace_back(digits_[i], ToValue(levels[i] != digit_active_low_));
+    } else {
+      changes_.emplace_back(segments_[i - digits_.size()], ToValue(levels[i] != segment_active_low_));
+    }
+  }
+
+  if (!changes_.empty()) {
+    request.set_values(changes_);
+    writes_++;
+  }
+  levels_ = levels;
+  levels_known_ = true;
+}
+
+bool DisplayRefresher::Tick() {
+  // New frames are only taken at the start of a cycle so every frame is
+  // shown completely
+  if (digit_ == 0) {
+    if (middle_.load() & kDirty) {
+      front_ = middle_.exchange(front_) & ~kDirty;
+      frames_++;
+    }
+    cycles_++;
+  }
+
+  std::fill(next_.begin(), next_.end(), false);
+  next_[digit_] = true;
+  uint8_t mask = buffers_[front_][digit_];
+  for (size_t s = 0; s < segments_.size(); s++) {
+    next_[digits_.size() + s] = ((mask >> s) & 1) != 0;
+  }
+
+  try {
+    std::lock_guard<std::mutex> lock(owner_->BusMutex());
+
+    std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+    if (!request) {
+      throw std::runtime_error("line request is not active");
+    }
+
+    // Optionally switch all digits off while the segments change to avoid
+    // ghosting of the previous digit
+    if (blank_ns_ > 0) {
+      blank_ = levels_;
+      std::fill(blank_.begin(), blank_.begin() + digits_.size(), false);
+      Write(*request, blank_);
+      PreciseSleepUntilNs(MonotonicNowNs() + blank_ns_);
+    }
+
+    Write(*request, next_);
+  } catch (const std::exception& e) {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    error_ = e.what();
+    return false;
+  }
+
+  owner_->InvalidateShadow();
+  digit_ = (digit_ + 1) % digits_.size();
+  return true;
+}
+
+void DisplayRefresher::Blank() {
+  std::lock_guard<std::mutex> lock(owner_->BusMutex());
+
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!request) {
+    return;
+  }
+
+  gpiod::line::value_mappings values;
+  for (unsigned int digit : digits_) {
+    values.emplace_back(digit, ToValue(digit_active_low_));
+  }
+  request->set_values(values);
+  owner_->InvalidateShadow();
+}
+
+Napi::Value DisplayRefresher::SetFrame(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsTypedArray() || info[0].As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+    Napi::TypeError::New(env, "Uint8Array expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Uint8Array frame = info[0].As<Napi::Uint8Array>();
+  if (frame.ElementLength() != digits_.size()) {
+    Napi::RangeError::New(env, "Frame must have one byte per digit (" + std::to_string(digits_.size()) + ")").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::copy(frame.Data(), frame.Data() + frame.ElementLength(), buffers_[back_].begin());
+  back_ = middle_.exchange(static_cast<uint8_t>(back_ | kDirty)) & ~kDirty;
+
+  return env.Undefined();
+}
+
+Napi::Value DisplayRefresher::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!owner_->GetRequest()) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  refresh_.Stop();
+  digit_ = 0;
+  levels_known_ = false;
+  {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    error_.clear();
+  }
+
+  std::string error = refresh_.Start(period_ns_, [this]() { return Tick(); }, spin_ns_);
+  if (!error.empty()) {
+    Napi::Error::New(env, "Failed to start refreshing: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value DisplayRefresher::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  refresh_.Stop();
+
+  try {
+    Blank();
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to blank display: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value DisplayRefresher::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("cycles", Napi::Number::New(env, static_cast<double>(cycles_.load())));
+  result.Set("frames", Napi::Number::New(env, static_cast<double>(frames_.load())));
+  result.Set("writes", Napi::Number::New(env, static_cast<double>(writes_.load())));
+  result.Set("running", Napi::Boolean::New(env, refresh_.IsRunning()));
+  result.Set("refresh", PeriodicStatsToObject(env, refresh_.GetStats()));
+
+  std::lock_guard<std::mutex> lock(error_mutex_);
+  result.Set("error", error_.empty() ? env.Null() : Napi::String::New(env, error_));
+
+  return result;
+}
@@ -0,0 +1,73 @@
+#ifndef DISPLAY_REFRESHER_H
+#define DISPLAY_REFRESHER_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+#include "periodic_task.h"
+
+// Multiplexed display refresher: one digit (or matrix row) is lit per tick,
+// its segment (or column) lines taken from a byte of the frame
+class DisplayRefresher : public Napi::ObjectWrap<DisplayRefresher> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  DisplayRefresher(const Napi::CallbackInfo& info);
+  ~DisplayRefresher();
+
+  // Wrapped methods
+  Napi::Value SetFrame(const Napi::CallbackInfo& info);
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  std::vector<unsigned int> digits_;
+  std::vector<unsigned int> segments_;
+  bool digit_active_low_;
+  bool segment_active_low_;
+  uint64_t period_ns_;
+  uint64_t blank_ns_;
+  uint64_t spin_ns_;
+
+  // Triple buffer: JS fills the back buffer and exchanges it with the
+  // middle one, the refresh thread picks the middle one up at the start of
+  // a cycle, so neither side ever waits or sees a torn frame
+  static const uint8_t kDirty = 4;
+  std::vector<uint8_t> buffers_[3];
+  uint8_t back_;
+  std::atomic<uint8_t> middle_;
+  uint8_t front_;
+
+  // Only used by the refresh thread
+  size_t digit_;
+  std::vector<bool> levels_;
+  std::vector<bool> next_;
+  std::vector<bool> blank_;
+  bool levels_known_;
+  gpiod::line::value_mappings changes_;
+  PeriodicTask refresh_;
+
+  std::atomic<uint64_t> cycles_;
+  std::atomic<uint64_t> frames_;
+  std::atomic<uint64_t> writes_;
+  std::mutex error_mutex_;
+  std::string error_;
+
+  // Internal methods
+  bool Tick();
+  void Write(gpiod::line_request& request, const std::vector<bool>& levels);
+  void Blank();
+};
+
+#endif // DISPLAY_REFRESHER_H
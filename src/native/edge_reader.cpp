@@ -0,0 +1,209 @@
+#include "edge_reader.h"
+#include "glitch_filter.h"
+#include "thread_options.h"
+#include "timing.h"
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+Napi::Object EdgeRecordToObject(Napi::Env env, const EdgeRecord& record) {
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("offset", Napi::Number::New(env, record.offset));
+  result.Set("type", Napi::String::New(env, record.rising ? "rising-edge" : "falling-edge"));
+  result.Set("timestampNs", Napi::BigInt::New(env, record.timestamp_ns));
+  result.Set("globalSeqno", Napi::Number::New(env, static_cast<double>(record.global_seqno)));
+  result.Set("lineSeqno", Napi::Number::New(env, static_cast<double>(record.line_seqno)));
+  return result;
+}
+
+EdgeReader::EdgeReader(std::shared_ptr<gpiod::line_request> request, EventHandler on_events, ErrorHandler on_error)
+  : EdgeReader(std::vector<std::shared_ptr<gpiod::line_request>>{request}, on_events, on_error) {
+}
+
+EdgeReader::EdgeReader(std::vector<std::shared_ptr<gpiod::line_request>> requests, EventHandler on_events, ErrorHandler on_error)
+  : requests_(requests), on_events_(on_events), on_error_(on_error), poll_interval_ms_(100), wake_ns_(0), running_(false),
+    stop_fd_(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK)) {
+}
+
+void EdgeReader::SetIdleHandler(IdleHandler on_idle, int interval_ms) {
+  on_idle_ = on_idle;
+  poll_interval_ms_ = interval_ms;
+}
+
+void EdgeReader::WakeAt(uint64_t deadline_ns) {
+  wake_ns_ = deadline_ns;
+}
+
+void EdgeReader::SetGlitchFilter(std::shared_ptr<GlitchFilter> filter) {
+  filter_ = filter;
+}
+
+EdgeReader::~EdgeReader() {
+  Stop();
+  if (stop_fd_ >= 0) {
+    close(stop_fd_);
+  }
+}
+
+std::string EdgeReader::Start() {
+  if (running_) {
+    return "";
+  }
+  if (stop_fd_ < 0) {
+    return "failed to create stop event";
+  }
+
+  // Drop a stop signal left over from a previous run
+  uint64_t count;
+  while (read(stop_fd_, &count, sizeof(count)) > 0) {
+  }
+
+  running_ = true;
+  thread_ = std::thread(&EdgeReader::Run, this);
+
+  std::string error = ApplyThreadOptions(thread_);
+  if (!error.empty()) {
+    Stop();
+  }
+  return error;
+}
+
+void EdgeReader::Stop() {
+  running_ = false;
+  if (stop_fd_ >= 0) {
+    uint64_t one = 1;
+    ssize_t written = write(stop_fd_, &one, sizeof(one));
+    (void)written;
+  }
+
+  if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+    thread_.join();
+  }
+}
+
+bool EdgeReader::IsRunning() const {
+  return running_;
+}
+
+void EdgeReader::Run() {
+  ::gpiod::edge_event_buffer buffer(64);
+  std::vector<EdgeRecord> batch;
+  batch.reserve(buffer.capacity() * requests_.size());
+  std::vector<EdgeRecord> filtered;
+
+  // The stop event is polled after the requests
+  std::vector<struct pollfd> fds(requests_.size() + 1);
+  for (size_t i = 0; i < requests_.size(); i++) {
+    fds[i].fd = requests_[i]->fd();
+    fds[i].events = POLLIN;
+  }
+  fds.back().fd = stop_fd_;
+  fds.back().events = POLLIN;
+
+  while (running_) {
+    try {
+      // Wake up at the poll interval, if any, and at the deadline requested
+      // by the handlers; a negative timeout sleeps until an event or Stop()
+      int64_t timeout_ns = poll_interval_ms_ >= 0 ? static_cast<int64_t>(poll_interval_ms_) * 1000000LL : -1;
+      uint64_t wake = wake_ns_;
+      if (filter_) {
+        uint64_t deadline = filter_->NextDeadline();
+        if (deadline != 0 && (wake == 0 || deadline < wake)) {
+          wake = deadline;
+        }
+      }
+      if (wake != 0) {
+        uint64_t now = MonotonicNowNs();
+        int64_t remaining = wake > now ? static_cast<int64_t>(wake - now) : 0;
+        timeout_ns = timeout_ns < 0 ? remaining : std::min(timeout_ns, remaining);
+      }
+      struct timespec timeout;
+      timeout.tv_sec = static_cast<time_t>(timeout_ns / 1000000000LL);
+      timeout.tv_nsec = static_cast<long>(timeout_ns % 1000000000LL);
+
+      int ready = ::ppoll(fds.data(), fds.size(), timeout_ns < 0 ? nullptr : &timeout, nullptr);
+      if (ready < 0 && errno != EINTR) {
+        throw std::system_error(errno, std::generic_category(), "poll failed");
+      }
+      if (!running_) {
+        continue;
+      }
+      wake_ns_ = 0;
+      if (ready <= 0) {
+        if (filter_) {
+          filtered.clear();
+          filter_->Expire(MonotonicNowNs(), filtered);
+          if (!filtered.empty()) {
+            on_events_(filtered);
+          }
+        }
+        if (on_idle_) {
+          on_idle_(MonotonicNowNs());
+        }
+        continue;
+      }
+
+      // A request that errors or hangs up stays ready forever, stop instead
+      // of spinning on it
+      for (const struct pollfd& fd : fds) {
+        if (fd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+          throw std::runtime_error(fd.revents & POLLNVAL ? "line request file descriptor is not open"
+                                                         : "line request file descriptor reported an error");
+        }
+      }
+
+      batch.clear();
+      for (size_t source = 0; source < requests_.size(); source++) {
+        if (!(fds[source].revents & POLLIN)) {
+          continue;
+        }
+
+        size_t count = requests_[source]->read_edge_events(buffer);
+        for (size_t i = 0; i < count; i++) {
+          const ::gpiod::edge_event& event = buffer.get_event(i);
+          EdgeRecord record;
+          record.source = source;
+          record.offset = event.line_offset();
+          record.rising = event.type() == ::gpiod::edge_event::event_type::RISING_EDGE;
+          record.timestamp_ns = event.timestamp_ns().ns();
+          record.global_seqno = event.global_seqno();
+          record.line_seqno = event.line_seqno();
+          batch.push_back(record);
+        }
+      }
+
+      // Events of a single request are already in order, only merged
+      // batches from several requests need sorting
+      if (requests_.size() > 1) {
+        std::stable_sort(batch.begin(), batch.end(), [](const EdgeRecord& a, const EdgeRecord& b) {
+          return a.timestamp_ns < b.timestamp_ns;
+        });
+      }
+
+      if (filter_) {
+        filtered.clear();
+        filter_->Process(batch, filtered);
+        filter_->Expire(MonotonicNowNs(), filtered);
+        if (!filtered.empty()) {
+          on_events_(filtered);
+        }
+      } else if (!batch.empty()) {
+        on_events_(batch);
+      }
+      if (on_idle_) {
+        on_idle_(MonotonicNowNs());
+      }
+    } catch (const std::exception& e) {
+      if (running_) {
+        running_ = false;
+        on_error_(e.what());
+      }
+    }
+  }
+
+  requests_.clear();
+}
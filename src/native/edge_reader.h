@@ -0,0 +1,83 @@
+#ifndef EDGE_READER_H
+#define EDGE_READER_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Copy of a gpiod::edge_event that can outlive the event buffer
+struct EdgeRecord {
+  size_t source;
+  unsigned int offset;
+  bool rising;
+  uint64_t timestamp_ns;
+  uint64_t global_seqno;
+  uint64_t line_seqno;
+};
+
+Napi::Object EdgeRecordToObject(Napi::Env env, const EdgeRecord& record);
+
+class GlitchFilter;
+
+// Background thread draining the edge events of one or more line requests in
+// batches; events of a batch are ordered by kernel timestamp and tagged with
+// the index of the request they came from. Batches are delivered as read, so
+// the order across requests only holds within a batch.
+class EdgeReader {
+public:
+  using EventHandler = std::function<void(const std::vector<EdgeRecord>&)>;
+  using ErrorHandler = std::function<void(const std::string&)>;
+  using IdleHandler = std::function<void(uint64_t now_ns)>;
+
+  EdgeReader(std::shared_ptr<gpiod::line_request> request, EventHandler on_events, ErrorHandler on_error);
+  EdgeReader(std::vector<std::shared_ptr<gpiod::line_request>> requests, EventHandler on_events, ErrorHandler on_error);
+  ~EdgeReader();
+
+  // Calls the handler after every wake-up of the reader thread, with or
+  // without events, and at least every interval_ms. A negative interval only
+  // wakes the thread for events and WakeAt deadlines. Must be set before
+  // Start().
+  void SetIdleHandler(IdleHandler on_idle, int interval_ms);
+
+  // Wakes the reader thread at a CLOCK_MONOTONIC deadline even if no event
+  // arrives, for handlers with their own timers; 0 cancels. Must be called
+  // from the handlers, the deadline is cleared before each call of them.
+  void WakeAt(uint64_t deadline_ns);
+
+  // Passes the edges through a glitch filter before the event handler sees
+  // them; the thread wakes up on its own for the filter deadlines. Must be
+  // set before Start().
+  void SetGlitchFilter(std::shared_ptr<GlitchFilter> filter);
+
+  // Returns an error message if the thread options could not be applied.
+  // The thread drops its references to the requests when it ends, so a
+  // reader can only be started once.
+  std::string Start();
+
+  // May be called from the handlers; the thread then ends without a join
+  void Stop();
+  bool IsRunning() const;
+
+private:
+  std::vector<std::shared_ptr<gpiod::line_request>> requests_;
+  EventHandler on_events_;
+  ErrorHandler on_error_;
+  IdleHandler on_idle_;
+  int poll_interval_ms_;
+  uint64_t wake_ns_;
+  std::shared_ptr<GlitchFilter> filter_;
+  std::thread thread_;
+  std::atomic<bool> running_;
+  // Signalled by Stop() so the thread does not have to time out first
+  int stop_fd_;
+
+  void Run();
+};
+
+#endif // EDGE_READER_H
@@ -0,0 +1,167 @@
+#include "engine_utils.h"
+#include <algorithm>
+#include <chrono>
+
+LineRequest* UnwrapLineRequest(Napi::Env env, Napi::Value value) {
+  if (!value.IsObject() || !value.As<Napi::Object>().InstanceOf(LineRequest::constructor.Value())) {
+    Napi::TypeError::New(env, "First argument must be a LineRequest instance").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+
+  LineRequest* request = Napi::ObjectWrap<LineRequest>::Unwrap(value.As<Napi::Object>());
+  if (!request->GetRequest()) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return nullptr;
+  }
+
+  return request;
+}
+
+bool ReadLineOffset(Napi::Env env, Napi::Object options, const char* name,
+                    const std::vector<unsigned int>& offsets, bool required, int& offset) {
+  offset = -1;
+  if (!options.Has(name) || options.Get(name).IsUndefined()) {
+    if (required) {
+      Napi::TypeError::New(env, std::string("Offset for ") + name + " expected").ThrowAsJavaScriptException();
+      return false;
+    }
+    return true;
+  }
+
+  if (!options.Get(name).IsNumber()) {
+    Napi::TypeError::New(env, std::string("Offset for ") + name + " must be a number").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  unsigned int value = options.Get(name).As<Napi::Number>().Uint32Value();
+  if (std::find(offsets.begin(), offsets.end(), value) == offsets.end()) {
+    Napi::RangeError::New(env, std::string("Offset for ") + name + " is not part of the request").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  offset = static_cast<int>(value);
+  return true;
+}
+
+bool ReadLineOffsets(Napi::Env env, Napi::Object options, const char* name,
+                     const std::vector<unsigned int>& offsets, std::vector<unsigned int>& result) {
+  result.clear();
+  if (!options.Has(name) || !options.Get(name).IsArray()) {
+    Napi::TypeError::New(env, std::string("Array of offsets for ") + name + " expected").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  Napi::Array array = options.Get(name).As<Napi::Array>();
+  for (uint32_t i = 0; i < array.Length(); i++) {
+    Napi::Value val = array[i];
+    if (!val.IsNumber()) {
+      Napi::TypeError::New(env, std::string("Offsets for ") + name + " must be numbers").ThrowAsJavaScriptException();
+      return false;
+    }
+
+    unsigned int offset = val.As<Napi::Number>().Uint32Value();
+    if (std::find(offsets.begin(), offsets.end(), offset) == offsets.end()) {
+      Napi::RangeError::New(env, std::string("Offset ") + std::to_string(offset) + " for " + name + " is not part of the request").ThrowAsJavaScriptException();
+      return false;
+    }
+    result.push_back(offset);
+  }
+
+  return true;
+}
+
+double ReadNumber(Napi::Object options, const char* name, double fallback) {
+  if (options.Has(name) && options.Get(name).IsNumber()) {
+    return options.Get(name).As<Napi::Number>().DoubleValue();
+  }
+  return fallback;
+}
+
+bool ReadBoolean(Napi::Object options, const char* name, bool fallback) {
+  if (options.Has(name) && options.Get(name).IsBoolean()) {
+    return options.Get(name).As<Napi::Boolean>().Value();
+  }
+  return fallback;
+}
+
+void DrainEdgeEvents(gpiod::line_request& request, gpiod::edge_event_buffer& buffer) {
+  while (request.wait_edge_events(std::chrono::nanoseconds(0))) {
+    request.read_edge_events(buffer);
+  }
+}
+
+bool ReadBitOrder(Napi::Env env, Napi::Object options, bool& lsb_first) {
+  lsb_first = false;
+  if (options.Has("bitOrder") && options.Get("bitOrder").IsString()) {
+    std::string order = options.Get("bitOrder").As<Napi::String>().Utf8Value();
+    if (order == "lsb-first") {
+      lsb_first = true;
+    } else if (order != "msb-first") {
+      Napi::TypeError::New(env, "Invalid bit order: must be 'msb-first' or 'lsb-first'").ThrowAsJavaScriptException();
+      return false;
+    }
+  }
+  return true;
+}
+
+SingleWireConfigs BuildSingleWireConfigs(LineRequest* owner, unsigned int line, bool pull_up, bool edges) {
+  gpiod::line_settings low;
+  low.set_direction(gpiod::line::direction::OUTPUT);
+  low.set_drive(gpiod::line::drive::OPEN_DRAIN);
+  low.set_output_value(gpiod::line::value::INACTIVE);
+
+  gpiod::line_settings release;
+  release.set_direction(gpiod::line::direction::INPUT);
+  release.set_bias(pull_up ? gpiod::line::bias::PULL_UP : gpiod::line::bias::AS_IS);
+  release.set_edge_detection(edges ? gpiod::line::edge::BOTH : gpiod::line::edge::NONE);
+
+  return {owner->BuildConfig({{line, low}}), owner->BuildConfig({{line, release}})};
+}
+
+Napi::Object PeriodicStatsToObject(Napi::Env env, const PeriodicTask::Stats& stats) {
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("ticks", Napi::Number::New(env, static_cast<double>(stats.ticks)));
+  result.Set("missed", Napi::Number::New(env, static_cast<double>(stats.missed)));
+  result.Set("maxLatenessNs", Napi::Number::New(env, static_cast<double>(stats.max_lateness_ns)));
+  result.Set("meanLatenessNs", Napi::Number::New(env, static_cast<double>(stats.mean_lateness_ns)));
+  return result;
+}
+
+PromiseWorker::PromiseWorker(Napi::Env env, const char* name, Napi::Object keep_alive, LineRequest* owner, Job job, Resolver resolver)
+  : Napi::AsyncWorker(env, name), deferred_(Napi::Promise::Deferred::New(env)), owner_(owner), job_(job), resolver_(resolver) {
+  keep_alive_ = Napi::Persistent(keep_alive);
+}
+
+Napi::Promise PromiseWorker::GetPromise() const {
+  return deferred_.Promise();
+}
+
+bool PromiseWorker::ClaimEdgeEvents(Napi::Env env, const std::string& name) {
+  return owner_->ClaimEdgeEvents(env, this, name);
+}
+
+void PromiseWorker::Execute() {
+  try {
+    job_();
+  } catch (const std::exception& e) {
+    SetError(e.what());
+  }
+}
+
+void PromiseWorker::OnOK() {
+  Napi::Env env = Env();
+  Napi::HandleScope scope(env);
+
+  owner_->InvalidateShadow();
+  owner_->ReleaseEdgeEvents(this);
+  deferred_.Resolve(resolver_(env));
+}
+
+void PromiseWorker::OnError(const Napi::Error& error) {
+  Napi::Env env = Env();
+  Napi::HandleScope scope(env);
+
+  owner_->InvalidateShadow();
+  owner_->ReleaseEdgeEvents(this);
+  deferred_.Reject(error.Value());
+}
@@ -0,0 +1,88 @@
+#ifndef ENGINE_UTILS_H
+#define ENGINE_UTILS_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <string>
+#include <vector>
+#include <functional>
+#include "line_request.h"
+#include "periodic_task.h"
+
+// Helpers shared by the native engines built on top of a LineRequest
+
+inline gpiod::line::value ToValue(bool active) {
+  return active ? gpiod::line::value::ACTIVE : gpiod::line::value::INACTIVE;
+}
+
+// Unwraps an active LineRequest argument, throws and returns nullptr otherwise
+LineRequest* UnwrapLineRequest(Napi::Env env, Napi::Value value);
+
+// Reads a line offset option that must be part of the request; offset is -1
+// if an optional option is not given. Throws and returns false on error.
+bool ReadLineOffset(Napi::Env env, Napi::Object options, const char* name,
+                    const std::vector<unsigned int>& offsets, bool required, int& offset);
+
+// Reads an array of line offsets that must be part of the request
+bool ReadLineOffsets(Napi::Env env, Napi::Object options, const char* name,
+                     const std::vector<unsigned int>& offsets, std::vector<unsigned int>& result);
+
+// Reads an optional numeric option
+double ReadNumber(Napi::Object options, const char* name, double fallback);
+
+// Reads an optional boolean option
+bool ReadBoolean(Napi::Object options, const char* name, bool fallback);
+
+// Discards all pending edge events of a request
+void DrainEdgeEvents(gpiod::line_request& request, gpiod::edge_event_buffer& buffer);
+
+// Reads the optional bitOrder option ('msb-first' or 'lsb-first')
+bool ReadBitOrder(Napi::Env env, Napi::Object options, bool& lsb_first);
+
+// Request configurations that switch one line of a single-wire bus between
+// driving low and released to its pull-up, for protocols where host and
+// device take turns on the same line
+struct SingleWireConfigs {
+  gpiod::line_config drive_low;
+  gpiod::line_config release;
+};
+
+// Builds the configurations from the current settings of the other lines of
+// the request; the released line is an input, optionally with pull-up bias
+// and edge detection on both edges. Must be called from the JavaScript thread.
+SingleWireConfigs BuildSingleWireConfigs(LineRequest* owner, unsigned int line, bool pull_up, bool edges);
+
+// Converts the timing statistics of a periodic task
+Napi::Object PeriodicStatsToObject(Napi::Env env, const PeriodicTask::Stats& stats);
+
+// Runs a blocking job on a worker thread and settles a promise with its
+// result. The job throws on failure; the output shadow of the owning request
+// is invalidated afterwards since the job drives the lines directly.
+class PromiseWorker : public Napi::AsyncWorker {
+public:
+  using Job = std::function<void()>;
+  using Resolver = std::function<Napi::Value(Napi::Env)>;
+
+  PromiseWorker(Napi::Env env, const char* name, Napi::Object keep_alive, LineRequest* owner, Job job, Resolver resolver);
+
+  Napi::Promise GetPromise() const;
+
+  // Holds the edge event claim of the owner until the promise settles.
+  // Throws and returns false if another consumer reads the edges; the
+  // worker must then be deleted instead of queued.
+  bool ClaimEdgeEvents(Napi::Env env, const std::string& name);
+
+protected:
+  void Execute() override;
+  void OnOK() override;
+  void OnError(const Napi::Error& error) override;
+
+private:
+  Napi::Promise::Deferred deferred_;
+  Napi::ObjectReference keep_alive_;
+  LineRequest* owner_;
+  Job job_;
+  Resolver resolver_;
+};
+
+#endif // ENGINE_UTILS_H
@@ -0,0 +1,178 @@
+#include "glitch_filter.h"
+#include "engine_utils.h"
+#include <algorithm>
+
+bool ReadGlitchFilterOptions(Napi::Env env, Napi::Object options, GlitchFilterOptions& result) {
+  double min_pulse_us = ReadNumber(options, "minPulseUs", 0);
+  double holdoff_us = ReadNumber(options, "holdoffUs", 0);
+  double window_us = ReadNumber(options, "windowUs", 0);
+  if (min_pulse_us < 0 || holdoff_us < 0 || window_us < 0) {
+    Napi::RangeError::New(env, "Glitch filter times must not be negative").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  result.min_pulse_ns = static_cast<uint64_t>(min_pulse_us * 1000);
+  result.holdoff_ns = static_cast<uint64_t>(holdoff_us * 1000);
+  result.window_ns = static_cast<uint64_t>(window_us * 1000);
+  return true;
+}
+
+Napi::Object GlitchStatsToObject(Napi::Env env, const GlitchFilter::Stats& stats) {
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("edges", Napi::Number::New(env, static_cast<double>(stats.edges)));
+  result.Set("suppressed", Napi::Number::New(env, static_cast<double>(stats.suppressed)));
+  return result;
+}
+
+GlitchFilter::GlitchFilter(const GlitchFilterOptions& options) : options_(options), edges_(0), delivered_(0) {
+}
+
+uint64_t GlitchFilter::DecisionNs(const LineState& line) const {
+  return line.start_ns + std::max(options_.min_pulse_ns, options_.window_ns);
+}
+
+void GlitchFilter::ExpireLine(LineState& line, uint64_t now_ns, std::vector<EdgeRecord>& out) {
+  while (true) {
+    if (!line.pending) {
+      if (line.raw == line.level) {
+        return;
+      }
+
+      // Check a change that is not yet delivered, once the hold-off is over.
+      // The level has been constant since the last edge, so the check may
+      // start in the past.
+      uint64_t start = std::max(line.raw_edge.timestamp_ns, line.not_before_ns);
+      if (now_ns < start) {
+        return;
+      }
+      line.pending = true;
+      line.candidate = line.raw_edge;
+      line.start_ns = start;
+      line.new_level_ns = 0;
+      line.broken = false;
+    }
+
+    uint64_t decision = DecisionNs(line);
+    if (now_ns < decision) {
+      return;
+    }
+
+    uint64_t new_level = line.new_level_ns;
+    uint64_t from = std::max(line.raw_edge.timestamp_ns, line.start_ns);
+    if (line.raw == line.candidate.rising && decision > from) {
+      new_level += decision - from;
+    }
+    uint64_t span = decision - line.start_ns;
+    line.pending = false;
+
+    if (span == 0 || 2 * new_level > span) {
+      line.level = line.candidate.rising;
+      line.not_before_ns = line.candidate.timestamp_ns + options_.holdoff_ns;
+      out.push_back(line.candidate);
+      delivered_++;
+    }
+    // A rejected change is checked again from its last edge if the line
+    // still differs from the delivered level
+  }
+}
+
+void GlitchFilter::Process(const std::vector<EdgeRecord>& edges, std::vector<EdgeRecord>& out) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t first = out.size();
+
+  for (const EdgeRecord& edge : edges) {
+    edges_++;
+    if (!options_.Enabled()) {
+      out.push_back(edge);
+      delivered_++;
+      continue;
+    }
+
+    auto key = std::make_pair(edge.source, edge.offset);
+    auto it = lines_.find(key);
+    if (it == lines_.end()) {
+      // The first edge tells the level before it
+      LineState state = {};
+      state.level = !edge.rising;
+      state.raw = state.level;
+      state.raw_edge = edge;
+      it = lines_.emplace(key, state).first;
+    }
+    LineState& line = it->second;
+    uint64_t t = edge.timestamp_ns;
+
+    // Decide what was due before this edge
+    ExpireLine(line, t, out);
+
+    if (line.pending) {
+      uint64_t from = std::max(line.raw_edge.timestamp_ns, line.start_ns);
+      if (line.raw == line.candidate.rising && t > from) {
+        line.new_level_ns += t - from;
+      }
+      if (edge.rising != line.candidate.rising && t < line.start_ns + options_.min_pulse_ns) {
+        line.broken = true;
+      }
+    }
+    line.raw = edge.rising;
+    line.raw_edge = edge;
+
+    // A pulse shorter than the minimum width is dropped with both its edges
+    if (line.pending && line.broken) {
+      line.pending = false;
+    }
+
+    ExpireLine(line, t, out);
+  }
+
+  std::stable_sort(out.begin() + first, out.end(), [](const EdgeRecord& a, const EdgeRecord& b) {
+    return a.timestamp_ns < b.timestamp_ns;
+  });
+}
+
+void GlitchFilter::Expire(uint64_t now_ns, std::vector<EdgeRecord>& out) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_t first = out.size();
+
+  for (auto& entry : lines_) {
+    ExpireLine(entry.second, now_ns, out);
+  }
+
+  std::stable_sort(out.begin() + first, out.end(), [](const EdgeRecord& a, const EdgeRecord& b) {
+    return a.timestamp_ns < b.timestamp_ns;
+  });
+}
+
+uint64_t GlitchFilter::NextDeadline() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  uint64_t deadline = 0;
+
+  for (const auto& entry : lines_) {
+    const LineState& line = entry.second;
+    uint64_t candidate = 0;
+    if (line.pending) {
+      candidate = DecisionNs(line);
+    } else if (line.raw != line.level) {
+      candidate = std::max(line.raw_edge.timestamp_ns, line.not_before_ns);
+    } else {
+      continue;
+    }
+    if (deadline == 0 || candidate < deadline) {
+      deadline = candidate;
+    }
+  }
+  return deadline;
+}
+
+GlitchFilter::Stats GlitchFilter::GetStats() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  // Edges that are neither delivered nor still being checked were suppressed
+  uint64_t pending = 0;
+  for (const auto& entry : lines_) {
+    if (entry.second.pending || entry.second.raw != entry.second.level) {
+      pending++;
+    }
+  }
+  uint64_t settled = delivered_ + pending;
+  return {edges_, edges_ > settled ? edges_ - settled : 0};
+}
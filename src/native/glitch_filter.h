@@ -0,0 +1,79 @@
+#ifndef GLITCH_FILTER_H
+#define GLITCH_FILTER_H
+
+#include <napi.h>
+#include <map>
+#include <mutex>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include "edge_reader.h"
+
+struct GlitchFilterOptions {
+  // A change has to hold this long without returning to the old level
+  uint64_t min_pulse_ns = 0;
+  // Changes within this time after a delivered edge are not delivered; the
+  // level at the end of the hold-off is delivered if it differs
+  uint64_t holdoff_ns = 0;
+  // A change is delivered if the line spent more than half of this window
+  // after the change at the new level
+  uint64_t window_ns = 0;
+
+  bool Enabled() const {
+    return min_pulse_ns > 0 || holdoff_ns > 0 || window_ns > 0;
+  }
+};
+
+// Reads the optional minPulseUs, holdoffUs and windowUs options. Throws and
+// returns false on error.
+bool ReadGlitchFilterOptions(Napi::Env env, Napi::Object options, GlitchFilterOptions& result);
+
+// Software replacement for kernel debounce on lines whose driver ignores the
+// debounce period. Works on kernel timestamps only: edges are held back until
+// they are confirmed, so the owner of the filter has to wake up at
+// NextDeadline() even if no further edge arrives. Delivered edges keep the
+// record (timestamp and sequence numbers) of the edge that started them.
+class GlitchFilter {
+public:
+  struct Stats {
+    uint64_t edges;
+    uint64_t suppressed;
+  };
+
+  explicit GlitchFilter(const GlitchFilterOptions& options);
+
+  // Appends the confirmed edges to out, ordered by timestamp
+  void Process(const std::vector<EdgeRecord>& edges, std::vector<EdgeRecord>& out);
+  // Confirms or rejects the changes whose decision time has passed
+  void Expire(uint64_t now_ns, std::vector<EdgeRecord>& out);
+  // CLOCK_MONOTONIC time of the next decision, 0 if nothing is pending
+  uint64_t NextDeadline() const;
+
+  Stats GetStats() const;
+
+private:
+  struct LineState {
+    bool level;            // delivered level
+    bool raw;              // current level
+    EdgeRecord raw_edge;   // last edge
+    bool pending;          // a change is being checked
+    EdgeRecord candidate;  // edge that started the change
+    uint64_t start_ns;     // start of the check
+    uint64_t new_level_ns; // time at the new level since the start, up to the last edge
+    bool broken;           // returned to the old level within the minimum pulse width
+    uint64_t not_before_ns; // end of the hold-off
+  };
+
+  GlitchFilterOptions options_;
+  mutable std::mutex mutex_;
+  std::map<std::pair<size_t, unsigned int>, LineState> lines_;
+  uint64_t edges_;
+  uint64_t delivered_;
+
+  uint64_t DecisionNs(const LineState& line) const;
+  void ExpireLine(LineState& line, uint64_t now_ns, std::vector<EdgeRecord>& out);
+};
+
+Napi::Object GlitchStatsToObject(Napi::Env env, const GlitchFilter::Stats& stats);
+
+#endif // GLITCH_FILTER_H
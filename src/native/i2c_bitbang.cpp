@@ -0,0 +1,335 @@
+#include "i2c_bitbang.h"
+#include "timing.h"
+#include "engine_utils.h"
+#include <mutex>
+#include <stdexcept>
+
+Napi::FunctionReference I2cBitbang::constructor;
+
+namespace {
+
+// Index of the lines in the bus offsets read with one get_values
+const size_t kSda = 0;
+const size_t kScl = 1;
+
+// Upper bound of one read, far above any register block of an I2C device
+const double kMaxReadLength = 65536;
+
+// Pause between the SCL samples of a clock stretch
+const uint64_t kStretchPollNs = 10000;
+
+std::string HexAddress(uint8_t address) {
+  const char* digits = "0123456789abcdef";
+  return std::string("0x") + digits[address >> 4] + digits[address & 0xf];
+}
+
+} // namespace
+
+Napi::Object I2cBitbang::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "I2cBitbang", {
+    InstanceMethod("writeRead", &I2cBitbang::WriteRead),
+    InstanceMethod("getStats", &I2cBitbang::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("I2cBitbang", func);
+  return exports;
+}
+
+I2cBitbang::I2cBitbang(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<I2cBitbang>(info), owner_(nullptr), sda_(0), scl_(0), half_period_ns_(0), stretch_timeout_ns_(0),
+    deadline_(0), transactions_(0), nacks_(0), stretches_(0), arbitration_lost_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  int sda = -1;
+  int scl = -1;
+  if (!ReadLineOffset(env, options, "sda", owner_->GetOffsets(), true, sda) ||
+      !ReadLineOffset(env, options, "scl", owner_->GetOffsets(), true, scl)) {
+    return;
+  }
+  if (sda == scl) {
+    Napi::RangeError::New(env, "SDA and SCL must be different lines").ThrowAsJavaScriptException();
+    return;
+  }
+  sda_ = static_cast<unsigned int>(sda);
+  scl_ = static_cast<unsigned int>(scl);
+  bus_ = {sda_, scl_};
+  levels_.resize(2);
+
+  double clock_hz = ReadNumber(options, "clockHz", 100000);
+  if (clock_hz <= 0) {
+    Napi::RangeError::New(env, "Clock frequency must be positive").ThrowAsJavaScriptException();
+    return;
+  }
+  half_period_ns_ = static_cast<uint64_t>(1e9 / (2 * clock_hz));
+
+  double stretch_timeout_us = ReadNumber(options, "stretchTimeoutUs", 10000);
+  if (stretch_timeout_us < 0) {
+    Napi::RangeError::New(env, "Clock stretch timeout must not be negative").ThrowAsJavaScriptException();
+    return;
+  }
+  stretch_timeout_ns_ = static_cast<uint64_t>(stretch_timeout_us * 1000);
+
+  // Release both lines, the pull-ups take the bus to idle
+  try {
+    owner_->WriteValues(env, {{sda_, gpiod::line::value::ACTIVE}, {scl_, gpiod::line::value::ACTIVE}});
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to initialize I2C lines: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return;
+  }
+}
+
+I2cBitbang::~I2cBitbang() {
+}
+
+void I2cBitbang::Wait() {
+  deadline_ += half_period_ns_;
+  PreciseSleepUntilNs(deadline_);
+}
+
+void I2cBitbang::SetSda(bool high) {
+  request_->set_value(sda_, ToValue(high));
+}
+
+void I2cBitbang::SetScl(bool high) {
+  request_->set_value(scl_, ToValue(high));
+}
+
+void I2cBitbang::ReleaseScl() {
+  SetScl(true);
+
+  // A slave may hold SCL low to stretch the clock
+  uint64_t timeout = MonotonicNowNs() + stretch_timeout_ns_;
+  bool stretched = false;
+  while (true) {
+    request_->get_values(bus_, levels_);
+    if (levels_[kScl] == gpiod::line::value::ACTIVE) {
+      break;
+    }
+    if (MonotonicNowNs() >= timeout) {
+      throw std::runtime_error("clock stretching timeout");
+    }
+    stretched = true;
+    SleepUntilNs(MonotonicNowNs() + kStretchPollNs);
+  }
+
+  if (stretched) {
+    stretches_++;
+    // Restart the bit timing from the end of the stretch
+    deadline_ = MonotonicNowNs();
+  }
+}
+
+void I2cBitbang::Start(bool repeated) {
+  if (repeated) {
+    SetSda(true);
+    Wait();
+    ReleaseScl();
+    Wait();
+  } else {
+    request_->get_values(bus_, levels_);
+    if (levels_[kSda] != gpiod::line::value::ACTIVE || levels_[kScl] != gpiod::line::value::ACTIVE) {
+      arbitration_lost_++;
+      throw std::runtime_error("bus busy");
+    }
+  }
+
+  SetSda(false);
+  Wait();
+  SetScl(false);
+  Wait();
+}
+
+void I2cBitbang::Stop() {
+  SetSda(false);
+  Wait();
+  ReleaseScl();
+  Wait();
+  SetSda(true);
+  Wait();
+}
+
+bool I2cBitbang::WriteBit(bool bit) {
+  SetSda(bit);
+  Wait();
+  ReleaseScl();
+
+  // levels_ was sampled while SCL was high; a released SDA that reads low
+  // means another master is driving the bus
+  bool sda = levels_[kSda] == gpiod::line::value::ACTIVE;
+  if (bit && !sda) {
+    arbitration_lost_++;
+    throw std::runtime_error("arbitration lost");
+  }
+
+  Wait();
+  SetScl(false);
+  return sda;
+}
+
+bool I2cBitbang::ReadBit() {
+  SetSda(true);
+  Wait();
+  ReleaseScl();
+  bool sda = levels_[kSda] == gpiod::line::value::ACTIVE;
+  Wait();
+  SetScl(false);
+  return sda;
+}
+
+bool I2cBitbang::WriteByte(uint8_t byte) {
+  for (int i = 7; i >= 0; i--) {
+    WriteBit(((byte >> i) & 1) != 0);
+  }
+
+  // ACK is the slave pulling SDA low
+  return !ReadBit();
+}
+
+uint8_t I2cBitbang::ReadByte(bool ack) {
+  uint8_t byte = 0;
+  for (int i = 0; i < 8; i++) {
+    byte = static_cast<uint8_t>((byte << 1) | (ReadBit() ? 1 : 0));
+  }
+
+  WriteBit(!ack);
+  return byte;
+}
+
+void I2cBitbang::Transaction(uint8_t address, const std::vector<uint8_t>& tx, size_t rx_len, std::vector<uint8_t>& rx) {
+  std::lock_guard<std::mutex> lock(owner_->BusMutex());
+
+  request_ = owner_->GetRequest();
+  if (!request_) {
+    throw std::runtime_error("line request is not active");
+  }
+
+  deadline_ = MonotonicNowNs();
+  bool started = false;
+
+  try {
+    // A transaction without data is an address probe
+    if (!tx.empty() || rx_len == 0) {
+      Start(false);
+      started = true;
+      if (!WriteByte(static_cast<uint8_t>(address << 1))) {
+        nacks_++;
+        throw std::runtime_error("no ACK from device " + HexAddress(address));
+      }
+      for (size_t i = 0; i < tx.size(); i++) {
+        if (!WriteByte(tx[i])) {
+          nacks_++;
+          throw std::runtime_error("no ACK for byte " + std::to_string(i) + " from device " + HexAddress(address));
+        }
+      }
+    }
+
+    if (rx_len > 0) {
+      Start(started);
+      started = true;
+      if (!WriteByte(static_cast<uint8_t>((address << 1) | 1))) {
+        nacks_++;
+        throw std::runtime_error("no ACK from device " + HexAddress(address));
+      }
+      rx.resize(rx_len);
+      for (size_t i = 0; i < rx_len; i++) {
+        rx[i] = ReadByte(i + 1 < rx_len);
+      }
+    }
+
+    Stop();
+    transactions_++;
+  } catch (...) {
+    // Try to leave the bus idle for the next transaction
+    if (started) {
+      try {
+        Stop();
+      } catch (...) {
+      }
+    }
+    request_.reset();
+    throw;
+  }
+
+  request_.reset();
+}
+
+Napi::Value I2cBitbang::WriteRead(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 3 || !info[0].IsNumber() || !info[1].IsTypedArray() || !info[2].IsNumber() ||
+      info[1].As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+    Napi::TypeError::New(env, "Address number, Uint8Array and read length expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  uint32_t address = info[0].As<Napi::Number>().Uint32Value();
+  if (address > 0x7f) {
+    Napi::RangeError::New(env, "I2C address must be a 7-bit address").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  double read_length = info[2].As<Napi::Number>().DoubleValue();
+  if (!(read_length >= 0 && read_length <= kMaxReadLength) || read_length != static_cast<size_t>(read_length)) {
+    Napi::RangeError::New(env, "Read length must be an integer from 0 to 65536").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!owner_->GetRequest()) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Uint8Array data = info[1].As<Napi::Uint8Array>();
+  std::vector<uint8_t> tx(data.Data(), data.Data() + data.ElementLength());
+  size_t rx_len = static_cast<size_t>(read_length);
+
+  auto rx = std::make_shared<std::vector<uint8_t>>();
+  PromiseWorker* worker = new PromiseWorker(env, "GPIO I2C Transaction", info.This().As<Napi::Object>(), owner_,
+    [this, address, tx, rx_len, rx]() {
+      try {
+        Transaction(static_cast<uint8_t>(address), tx, rx_len, *rx);
+      } catch (const std::exception& e) {
+        throw std::runtime_error("I2C transaction failed: " + std::string(e.what()));
+      }
+    },
+    [rx](Napi::Env env) -> Napi::Value {
+      return Napi::Buffer<uint8_t>::Copy(env, rx->data(), rx->size());
+    }
+  );
+  Napi::Promise promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value I2cBitbang::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("transactions", Napi::Number::New(env, static_cast<double>(transactions_.load())));
+  result.Set("nacks", Napi::Number::New(env, static_cast<double>(nacks_.load())));
+  result.Set("clockStretches", Napi::Number::New(env, static_cast<double>(stretches_.load())));
+  result.Set("arbitrationLost", Napi::Number::New(env, static_cast<double>(arbitration_lost_.load())));
+
+  return result;
+}
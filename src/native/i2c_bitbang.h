@@ -0,0 +1,58 @@
+#ifndef I2C_BITBANG_H
+#define I2C_BITBANG_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+
+class I2cBitbang : public Napi::ObjectWrap<I2cBitbang> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  I2cBitbang(const Napi::CallbackInfo& info);
+  ~I2cBitbang();
+
+  // Wrapped methods
+  Napi::Value WriteRead(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  unsigned int sda_;
+  unsigned int scl_;
+  uint64_t half_period_ns_;
+  uint64_t stretch_timeout_ns_;
+
+  // Only used by the transaction running on the worker thread
+  std::shared_ptr<gpiod::line_request> request_;
+  gpiod::line::offsets bus_;
+  gpiod::line::values levels_;
+  uint64_t deadline_;
+
+  std::atomic<uint64_t> transactions_;
+  std::atomic<uint64_t> nacks_;
+  std::atomic<uint64_t> stretches_;
+  std::atomic<uint64_t> arbitration_lost_;
+
+  // Internal methods, called from the worker thread
+  void Transaction(uint8_t address, const std::vector<uint8_t>& tx, size_t rx_len, std::vector<uint8_t>& rx);
+  void Wait();
+  void SetSda(bool high);
+  void SetScl(bool high);
+  void ReleaseScl();
+  void Start(bool repeated);
+  void Stop();
+  bool WriteBit(bool bit);
+  bool ReadBit();
+  bool WriteByte(uint8_t byte);
+  uint8_t ReadByte(bool ack);
+};
+
+#endif // I2C_BITBANG_H
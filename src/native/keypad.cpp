@@ -0,0 +1,378 @@
+#include "keypad.h"
+#include "timing.h"
+#include "thread_options.h"
+#include "engine_utils.h"
+#include <algorithm>
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+#include <poll.h>
+
+Napi::FunctionReference KeypadScanner::constructor;
+
+Napi::Object KeypadScanner::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "KeypadScanner", {
+    InstanceMethod("start", &KeypadScanner::Start),
+    InstanceMethod("stop", &KeypadScanner::Stop),
+    InstanceMethod("getPressed", &KeypadScanner::GetPressed),
+    InstanceMethod("getStats", &KeypadScanner::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("KeypadScanner", func);
+  return exports;
+}
+
+KeypadScanner::KeypadScanner(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<KeypadScanner>(info), owner_(nullptr), active_low_(true), ghost_blocking_(true), debounce_ns_(0),
+    scan_interval_ns_(0), settle_ns_(0), running_(false), started_(false), scans_(0), events_(0), ghost_scans_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  std::vector<unsigned int> rows;
+  std::vector<unsigned int> columns;
+  if (!ReadLineOffsets(env, options, "rows", owner_->GetOffsets(), rows) ||
+      !ReadLineOffsets(env, options, "columns", owner_->GetOffsets(), columns)) {
+    return;
+  }
+  if (rows.empty() || columns.empty()) {
+    Napi::RangeError::New(env, "At least one row and one column expected").ThrowAsJavaScriptException();
+    return;
+  }
+  for (unsigned int row : rows) {
+    if (std::find(columns.begin(), columns.end(), row) != columns.end()) {
+      Napi::RangeError::New(env, "Offset " + std::to_string(row) + " is both a row and a column").ThrowAsJavaScriptException();
+      return;
+    }
+  }
+  rows_ = gpiod::line::offsets(rows.begin(), rows.end());
+  columns_ = gpiod::line::offsets(columns.begin(), columns.end());
+
+  active_low_ = ReadBoolean(options, "activeLow", true);
+  ghost_blocking_ = ReadBoolean(options, "ghostBlocking", true);
+
+  double debounce_ms = ReadNumber(options, "debounceMs", 20);
+  double scan_interval_ms = ReadNumber(options, "scanIntervalMs", 5);
+  double settle_us = ReadNumber(options, "settleUs", 5);
+  if (debounce_ms < 0 || scan_interval_ms <= 0 || settle_us < 0) {
+    Napi::RangeError::New(env, "Invalid keypad timing: debounce and settle time must not be negative, scan interval must be positive").ThrowAsJavaScriptException();
+    return;
+  }
+  debounce_ns_ = static_cast<uint64_t>(debounce_ms * 1e6);
+  scan_interval_ns_ = static_cast<uint64_t>(scan_interval_ms * 1e6);
+  settle_ns_ = static_cast<uint64_t>(settle_us * 1e3);
+
+  keys_.assign(rows_.size() * columns_.size(), Key{false, false, 0});
+  matrix_.assign(keys_.size(), false);
+  column_values_.resize(columns_.size());
+}
+
+KeypadScanner::~KeypadScanner() {
+  StopScanning();
+}
+
+void KeypadScanner::SelectRows(gpiod::line_request& request, int row) {
+  // Selecting no particular row selects all of them, so any key press
+  // shows up on its column
+  gpiod::line::value_mappings values;
+  values.reserve(rows_.size());
+  for (size_t r = 0; r < rows_.size(); r++) {
+    bool selected = row < 0 || static_cast<size_t>(row) == r;
+    values.emplace_back(rows_[r], ToValue(selected != active_low_));
+  }
+  request.set_values(values);
+}
+
+bool KeypadScanner::AnyColumnActive(gpiod::line_request& request) {
+  request.get_values(columns_, column_values_);
+
+  gpiod::line::value active = ToValue(!active_low_);
+  return std::any_of(column_values_.begin(), column_values_.end(), [active](gpiod::line::value value) {
+    return value == active;
+  });
+}
+
+void KeypadScanner::ScanMatrix(gpiod::line_request& request) {
+  gpiod::line::value active = ToValue(!active_low_);
+
+  for (size_t r = 0; r < rows_.size(); r++) {
+    SelectRows(request, static_cast<int>(r));
+    if (settle_ns_ > 0) {
+      PreciseSleepUntilNs(MonotonicNowNs() + settle_ns_);
+    }
+
+    request.get_values(columns_, column_values_);
+    for (size_t c = 0; c < columns_.size(); c++) {
+      matrix_[r * columns_.size() + c] = column_values_[c] == active;
+    }
+  }
+
+  SelectRows(request, -1);
+}
+
+bool KeypadScanner::HasGhosts() const {
+  // Without diodes, three pressed corners of a rectangle make the fourth
+  // one read as pressed too, so two rows sharing two pressed columns are
+  // ambiguous
+  size_t num_columns = columns_.size();
+  for (size_t r1 = 0; r1 < rows_.size(); r1++) {
+    for (size_t r2 = r1 + 1; r2 < rows_.size(); r2++) {
+      size_t shared = 0;
+      for (size_t c = 0; c < num_columns; c++) {
+        if (matrix_[r1 * num_columns + c] && matrix_[r2 * num_columns + c] && ++shared >= 2) {
+          return true;
+        }
+      }
+    }
+  }
+  return false;
+}
+
+bool KeypadScanner::Debounce(uint64_t now, std::vector<KeyEvent>& events) {
+  bool busy = false;
+
+  // Every key is debounced on its own, so any number of keys can be held
+  for (size_t i = 0; i < keys_.size(); i++) {
+    Key& key = keys_[i];
+    if (matrix_[i] != key.raw) {
+      key.raw = matrix_[i];
+      key.changed_ns = now;
+    }
+
+    if (key.raw != key.stable && now - key.changed_ns >= debounce_ns_) {
+      key.stable = key.raw;
+      events.push_back(KeyEvent{i, key.stable, key.changed_ns});
+    }
+
+    busy = busy || key.raw || key.raw != key.stable;
+  }
+
+  if (!events.empty()) {
+    std::lock_guard<std::mutex> lock(pressed_mutex_);
+    pressed_.clear();
+    for (size_t i = 0; i < keys_.size(); i++) {
+      if (keys_[i].stable) {
+        pressed_.push_back(i);
+      }
+    }
+  }
+
+  return busy;
+}
+
+void KeypadScanner::Emit(const std::vector<KeyEvent>& events) {
+  if (events.empty()) {
+    return;
+  }
+  events_ += events.size();
+
+  size_t num_columns = columns_.size();
+  std::vector<KeyEvent> batch = events;
+  tsfn_.BlockingCall([batch, num_columns](Napi::Env env, Napi::Function jsCallback) {
+    for (const auto& key : batch) {
+      Napi::Object event = Napi::Object::New(env);
+      event.Set("index", Napi::Number::New(env, static_cast<double>(key.index)));
+      event.Set("row", Napi::Number::New(env, static_cast<double>(key.index / num_columns)));
+      event.Set("column", Napi::Number::New(env, static_cast<double>(key.index % num_columns)));
+      event.Set("type", Napi::String::New(env, key.down ? "key-down" : "key-up"));
+      event.Set("timestampNs", Napi::BigInt::New(env, key.timestamp_ns));
+      jsCallback.Call({env.Null(), event});
+    }
+  });
+}
+
+void KeypadScanner::Run() {
+  gpiod::edge_event_buffer buffer(16);
+  bool scanning = false;
+  bool selected = false;
+  uint64_t next_scan = 0;
+
+  while (running_) {
+    try {
+      if (!scanning) {
+        // Idle: all rows are selected and the thread sleeps until a column
+        // edge, checking the columns every 100 ms in case they were
+        // requested without edge detection
+        {
+          std::lock_guard<std::mutex> lock(owner_->BusMutex());
+          std::shared_ptr<gpiod::line_request> request = owner_->ActiveRequest();
+          if (!selected) {
+            SelectRows(*request, -1);
+            selected = true;
+          }
+          DrainEdgeEvents(*request, buffer);
+          scanning = AnyColumnActive(*request);
+        }
+        owner_->InvalidateShadow();
+
+        if (!scanning) {
+          // Only kept for the wait, which writes nothing
+          std::shared_ptr<gpiod::line_request> request = owner_->ActiveRequest();
+          struct pollfd pfd;
+          pfd.fd = request->fd();
+          pfd.events = POLLIN;
+          int ready = ::poll(&pfd, 1, 100);
+          if (ready < 0 && errno != EINTR) {
+            throw std::system_error(errno, std::generic_category(), "poll failed");
+          }
+          continue;
+        }
+        next_scan = MonotonicNowNs();
+      }
+
+      SleepUntilNs(next_scan);
+      if (!running_) {
+        break;
+      }
+
+      {
+        std::lock_guard<std::mutex> lock(owner_->BusMutex());
+        std::shared_ptr<gpiod::line_request> request = owner_->ActiveRequest();
+        ScanMatrix(*request);
+        DrainEdgeEvents(*request, buffer);
+      }
+      owner_->InvalidateShadow();
+      scans_++;
+
+      uint64_t now = MonotonicNowNs();
+      std::vector<KeyEvent> events;
+      if (ghost_blocking_ && HasGhosts()) {
+        // Keep the last unambiguous state until keys are released
+        ghost_scans_++;
+        scanning = true;
+      } else {
+        scanning = Debounce(now, events);
+      }
+      Emit(events);
+
+      next_scan += scan_interval_ns_;
+      if (next_scan < now) {
+        next_scan = now;
+      }
+    } catch (const std::exception& e) {
+      if (running_) {
+        running_ = false;
+        std::string message = e.what();
+        tsfn_.BlockingCall([message](Napi::Env env, Napi::Function jsCallback) {
+          jsCallback.Call({Napi::Error::New(env, message).Value(), env.Null()});
+        });
+      }
+    }
+  }
+}
+
+Napi::Value KeypadScanner::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsFunction()) {
+    Napi::TypeError::New(env, "Callback function expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!owner_->GetRequest()) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  StopScanning();
+
+  if (!owner_->ClaimEdgeEvents(env, this, "KeypadScanner")) {
+    return env.Undefined();
+  }
+
+  tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    info[0].As<Napi::Function>(),
+    "GPIO Keypad Callback",
+    0,
+    1
+  );
+  started_ = true;
+
+  // Keys held when scanning starts are reported as pressed
+  std::fill(keys_.begin(), keys_.end(), Key{false, false, 0});
+  {
+    std::lock_guard<std::mutex> lock(pressed_mutex_);
+    pressed_.clear();
+  }
+
+  running_ = true;
+  thread_ = std::thread(&KeypadScanner::Run, this);
+
+  std::string error = ApplyThreadOptions(thread_);
+  if (!error.empty()) {
+    StopScanning();
+    Napi::Error::New(env, "Failed to start scanning: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value KeypadScanner::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  StopScanning();
+
+  return env.Undefined();
+}
+
+void KeypadScanner::StopScanning() {
+  if (started_) {
+    started_ = false;
+    running_ = false;
+
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+
+    tsfn_.Release();
+  }
+
+  if (owner_) {
+    owner_->ReleaseEdgeEvents(this);
+  }
+}
+
+Napi::Value KeypadScanner::GetPressed(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  std::lock_guard<std::mutex> lock(pressed_mutex_);
+  Napi::Array result = Napi::Array::New(env, pressed_.size());
+  for (size_t i = 0; i < pressed_.size(); i++) {
+    result.Set(i, Napi::Number::New(env, static_cast<double>(pressed_[i])));
+  }
+
+  return result;
+}
+
+Napi::Value KeypadScanner::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("scans", Napi::Number::New(env, static_cast<double>(scans_.load())));
+  result.Set("events", Napi::Number::New(env, static_cast<double>(events_.load())));
+  result.Set("ghostScans", Napi::Number::New(env, static_cast<double>(ghost_scans_.load())));
+
+  return result;
+}
@@ -0,0 +1,84 @@
+#ifndef KEYPAD_H
+#define KEYPAD_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+
+// Row/column matrix keypad scanner. The rows are outputs, the columns are
+// inputs with pull resistors; a selected row is driven to the active level
+// and pressed keys pull their column to it.
+class KeypadScanner : public Napi::ObjectWrap<KeypadScanner> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  KeypadScanner(const Napi::CallbackInfo& info);
+  ~KeypadScanner();
+
+  // Wrapped methods
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value GetPressed(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  struct Key {
+    bool raw;
+    bool stable;
+    uint64_t changed_ns;
+  };
+
+  struct KeyEvent {
+    size_t index;
+    bool down;
+    uint64_t timestamp_ns;
+  };
+
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  gpiod::line::offsets rows_;
+  gpiod::line::offsets columns_;
+  bool active_low_;
+  bool ghost_blocking_;
+  uint64_t debounce_ns_;
+  uint64_t scan_interval_ns_;
+  uint64_t settle_ns_;
+
+  std::thread thread_;
+  std::atomic<bool> running_;
+  Napi::ThreadSafeFunction tsfn_;
+  bool started_;
+
+  // Only touched by the scan thread while it runs
+  std::vector<Key> keys_;
+  std::vector<bool> matrix_;
+  gpiod::line::values column_values_;
+
+  std::mutex pressed_mutex_;
+  std::vector<size_t> pressed_;
+
+  std::atomic<uint64_t> scans_;
+  std::atomic<uint64_t> events_;
+  std::atomic<uint64_t> ghost_scans_;
+
+  // Internal methods
+  void Run();
+  void SelectRows(gpiod::line_request& request, int row);
+  bool AnyColumnActive(gpiod::line_request& request);
+  void ScanMatrix(gpiod::line_request& request);
+  bool HasGhosts() const;
+  bool Debounce(uint64_t now, std::vector<KeyEvent>& events);
+  void Emit(const std::vector<KeyEvent>& events);
+  void StopScanning();
+};
+
+#endif // KEYPAD_H
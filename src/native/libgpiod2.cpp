@@ -3,6 +3,25 @@
 #include "line.h"
 #include "line_config.h"
 #include "line_request.h"
+#include "line_group.h"
+#include "vcd_writer.h"
+#include "spi_bitbang.h"
+#include "i2c_bitbang.h"
+#include "shift_register.h"
+#include "keypad.h"
+#include "display_refresher.h"
+#include "stepper.h"
+#include "servo.h"
+#include "pulse_meter.h"
+#include "decoder.h"
+#include "dht.h"
+#include "one_wire.h"
+#include "button.h"
+#include "one_shot.h"
+#include "bus_trigger.h"
+#include "supervisor.h"
+#include "watchdog.h"
+#include "thread_options.h"
 
 Napi::Object InitAll(Napi::Env env, Napi::Object exports) {
   // Register all classes
@@ -10,6 +29,28 @@ Napi::Object InitAll(Napi::Env env, Napi::Object exports) {
   Line::Init(env, exports);
   LineConfig::Init(env, exports);
   LineRequest::Init(env, exports);
+  LineGroup::Init(env, exports);
+  VcdWriter::Init(env, exports);
+  SpiBitbang::Init(env, exports);
+  I2cBitbang::Init(env, exports);
+  ShiftRegisterOut::Init(env, exports);
+  ShiftRegisterIn::Init(env, exports);
+  KeypadScanner::Init(env, exports);
+  DisplayRefresher::Init(env, exports);
+  StepperController::Init(env, exports);
+  ServoController::Init(env, exports);
+  PulseMeter::Init(env, exports);
+  Decoder::Init(env, exports);
+  DhtSensor::Init(env, exports);
+  OneWireBus::Init(env, exports);
+  ButtonClassifier::Init(env, exports);
+  DelayedOneShot::Init(env, exports);
+  BusTrigger::Init(env, exports);
+  HeartbeatSupervisor::Init(env, exports);
+  WatchdogKicker::Init(env, exports);
+
+  // Register module functions
+  InitThreadOptions(env, exports);
   
   return exports;
 }
@@ -1,4 +1,7 @@
 #include "line.h"
+#include "thread_options.h"
+#include "timing.h"
+#include <algorithm>
 #include <chrono>
 
 Napi::FunctionReference Line::constructor;
@@ -12,7 +15,9 @@ Napi::Object Line::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod("export", &Line::Export),
     InstanceMethod("unexport", &Line::Unexport),
     InstanceMethod("watch", &Line::Watch),
-    InstanceMethod("unwatch", &Line::Unwatch)
+    InstanceMethod("unwatch", &Line::Unwatch),
+    InstanceMethod("getWatchStats", &Line::GetWatchStats),
+    InstanceMethod("getValueCacheStats", &Line::GetValueCacheStats)
   });
 
   constructor = Napi::Persistent(func);
@@ -22,7 +27,9 @@ Napi::Object Line::Init(Napi::Env env, Napi::Object exports) {
   return exports;
 }
 
-Line::Line(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Line>(info), exported_(false), watching_(false) {
+Line::Line(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<Line>(info), exported_(false), watching_(false), cache_(0), cache_stale_(false),
+    cache_hits_(0), cache_reads_(0), cache_overruns_(0) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
 
@@ -65,8 +72,31 @@ Napi::Value Line::GetValue(const Napi::CallbackInfo& info) {
     return env.Null();
   }
 
+  // Watched lines can answer from the edge-tracked level without a syscall
+  bool cached = info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>().Value();
+  if (cached && watching_) {
+    int level = static_cast<int>(cache_.load() & 3) - 1;
+    if (level >= 0 && !cache_stale_.load()) {
+      cache_hits_++;
+      return Napi::Number::New(env, level);
+    }
+  }
+
   try {
+    // A stale or missing cache entry is refreshed by this read, unless an
+    // edge or an overrun arrived while it was in progress
+    uint64_t snapshot = cache_.load();
+    uint64_t overruns = cache_overruns_.load();
     gpiod::line::value value = request_->GetRequest()->get_value(offset_);
+    if (watching_) {
+      cache_reads_++;
+      if (cache_stale_.load() || (snapshot & 3) == 0) {
+        uint64_t refreshed = (snapshot & ~3ULL) | static_cast<uint64_t>(static_cast<int>(value) + 1);
+        if (cache_.compare_exchange_strong(snapshot, refreshed) && cache_overruns_.load() == overruns) {
+          cache_stale_ = false;
+        }
+      }
+    }
     return Napi::Number::New(env, static_cast<int>(value));
   } catch (const std::exception& e) {
     Napi::Error::New(env, "Failed to get line value: " + std::string(e.what())).ThrowAsJavaScriptException();
@@ -92,7 +122,7 @@ Napi::Value Line::SetValue(const Napi::CallbackInfo& info) {
   gpiod::line::value value = intValue ? gpiod::line::value::ACTIVE : gpiod::line::value::INACTIVE;
 
   try {
-    request_->GetRequest()->set_value(offset_, value);
+    request_->WriteValues(env, {{offset_, value}});
     return env.Undefined();
   } catch (const std::exception& e) {
     Napi::Error::New(env, "Failed to set line value: " + std::string(e.what())).ThrowAsJavaScriptException();
@@ -117,6 +147,7 @@ Napi::Value Line::Export(const Napi::CallbackInfo& info) {
   }
 
   // Unexport if already exported
+  StopWatchThread();
   if (exported_) {
     request_.reset();
     exported_ = false;
@@ -156,8 +187,30 @@ Napi::Value Line::Watch(const Napi::CallbackInfo& info) {
     return env.Undefined();
   }
 
+  GlitchFilterOptions filter_options;
+  if (info.Length() > 1 && info[1].IsObject() &&
+      !ReadGlitchFilterOptions(env, info[1].As<Napi::Object>(), filter_options)) {
+    return env.Undefined();
+  }
+
   // Stop any existing watch thread
   StopWatchThread();
+  filter_ = std::make_shared<GlitchFilter>(filter_options);
+
+  // Seed the value cache; edges from here on keep it current
+  try {
+    cache_ = static_cast<uint64_t>(static_cast<int>(request_->GetRequest()->get_value(offset_)) + 1);
+  } catch (const std::exception&) {
+    cache_ = 0;
+  }
+  cache_stale_ = false;
+  cache_reads_ = 1;
+  cache_hits_ = 0;
+  cache_overruns_ = 0;
+
+  if (!request_->ClaimEdgeEvents(env, this, "Line.watch()")) {
+    return env.Undefined();
+  }
 
   // Create a thread-safe function
   Napi::Function callback = info[0].As<Napi::Function>();
@@ -178,6 +231,13 @@ Napi::Value Line::Watch(const Napi::CallbackInfo& info) {
   watching_ = true;
   watch_thread_ = std::thread(&Line::WatchThread, this);
 
+  std::string error = ApplyThreadOptions(watch_thread_);
+  if (!error.empty()) {
+    StopWatchThread();
+    Napi::Error::New(env, "Failed to start watching: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
   return env.Undefined();
 }
 
@@ -199,19 +259,63 @@ void Line::WatchThread() {
   try {
     // Get a copy of the shared_ptr to the request
     std::shared_ptr<gpiod::line_request> request = request_->GetRequest();
-    ::gpiod::edge_event_buffer buffer(1);
+    ::gpiod::edge_event_buffer buffer(16);
+    std::vector<EdgeRecord> edges;
+    std::vector<EdgeRecord> delivered;
+    uint64_t last_seqno = 0;
     
     while (watching_) {
       try {
-        // Wait for an event with a timeout
+        // Wait for an event with a timeout, or until the glitch filter has
+        // to decide on a held back edge
+        std::chrono::nanoseconds timeout = std::chrono::milliseconds(100);
+        uint64_t deadline = filter_->NextDeadline();
+        if (deadline != 0) {
+          uint64_t now = MonotonicNowNs();
+          timeout = std::min(timeout, std::chrono::nanoseconds(deadline > now ? deadline - now : 0));
+        }
         
-        bool event_available = request->wait_edge_events(std::chrono::milliseconds(100));
+        bool event_available = request->wait_edge_events(timeout);
 
-        
-        if (watching_ && event_available) {
-          request->read_edge_events(buffer);
+        if (!watching_) {
+          continue;
+        }
+
+        edges.clear();
+        if (event_available) {
+          size_t count = request->read_edge_events(buffer);
+          for (size_t i = 0; i < count; i++) {
+            const ::gpiod::edge_event& event = buffer.get_event(i);
+            // Other lines of a shared request have their own sequence numbers
+            if (event.line_offset() != offset_) {
+              continue;
+            }
+
+            EdgeRecord record = {};
+            record.offset = event.line_offset();
+            record.rising = event.type() == ::gpiod::edge_event::event_type::RISING_EDGE;
+            record.timestamp_ns = event.timestamp_ns().ns();
+            record.line_seqno = event.line_seqno();
+            edges.push_back(record);
+
+            if (last_seqno != 0 && record.line_seqno != last_seqno + 1) {
+              // Counted first, so a concurrent refresh sees the overrun
+              cache_overruns_++;
+              cache_stale_ = true;
+            }
+            last_seqno = record.line_seqno;
+            uint64_t generation = (cache_.load() >> 2) + 1;
+            cache_ = generation << 2 | (record.rising ? 2 : 1);
+          }
+        }
+
+        delivered.clear();
+        filter_->Process(edges, delivered);
+        filter_->Expire(MonotonicNowNs(), delivered);
+
+        for (const EdgeRecord& record : delivered) {
           // Get the current value
-          int value = buffer.get_event(0).type() == ::gpiod::edge_event::event_type::RISING_EDGE ? 1 : 0;
+          int value = record.rising ? 1 : 0;
           
           // Call the JavaScript callback
           auto callback = [value](Napi::Env env, Napi::Function jsCallback) {
@@ -239,6 +343,26 @@ void Line::WatchThread() {
   }
 }
 
+Napi::Value Line::GetWatchStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  GlitchFilter::Stats stats = filter_ ? filter_->GetStats() : GlitchFilter::Stats{0, 0};
+  return GlitchStatsToObject(env, stats);
+}
+
+Napi::Value Line::GetValueCacheStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("hits", Napi::Number::New(env, static_cast<double>(cache_hits_.load())));
+  result.Set("reads", Napi::Number::New(env, static_cast<double>(cache_reads_.load())));
+  result.Set("overruns", Napi::Number::New(env, static_cast<double>(cache_overruns_.load())));
+  result.Set("stale", Napi::Boolean::New(env, cache_stale_.load()));
+  return result;
+}
+
 void Line::StopWatchThread() {
   if (watching_) {
     watching_ = false;
@@ -250,4 +374,8 @@ void Line::StopWatchThread() {
     
     tsfn_.Release();
   }
+
+  if (request_) {
+    request_->ReleaseEdgeEvents(this);
+  }
 }
@@ -10,6 +10,7 @@
 #include <condition_variable>
 #include "chip.h"
 #include "line_request.h"
+#include "glitch_filter.h"
 
 class Line : public Napi::ObjectWrap<Line> {
 public:
@@ -26,6 +27,8 @@ public:
   Napi::Value Unexport(const Napi::CallbackInfo& info);
   Napi::Value Watch(const Napi::CallbackInfo& info);
   Napi::Value Unwatch(const Napi::CallbackInfo& info);
+  Napi::Value GetWatchStats(const Napi::CallbackInfo& info);
+  Napi::Value GetValueCacheStats(const Napi::CallbackInfo& info);
 
 private:
   std::shared_ptr<Chip> chip_;
@@ -39,6 +42,19 @@ private:
   std::mutex watch_mutex_;
   std::condition_variable watch_cv_;
   Napi::ThreadSafeFunction tsfn_;
+  std::shared_ptr<GlitchFilter> filter_;
+
+  // Last known level of a watched line. Seeded by one read when watching
+  // starts and updated from every edge event of the line (before the glitch
+  // filter); stale when a gap in the line sequence numbers shows that the
+  // kernel dropped events. Packed as generation << 2 | (level + 1), with
+  // level -1 if unknown; every edge bumps the generation, so a read that
+  // raced an edge cannot overwrite the newer level.
+  std::atomic<uint64_t> cache_;
+  std::atomic<bool> cache_stale_;
+  std::atomic<uint64_t> cache_hits_;
+  std::atomic<uint64_t> cache_reads_;
+  std::atomic<uint64_t> cache_overruns_;
 
   // Internal methods
   void WatchThread();
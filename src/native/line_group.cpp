@@ -0,0 +1,407 @@
+#include "line_group.h"
+
+Napi::FunctionReference LineGroup::constructor;
+
+Napi::Object LineGroup::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "LineGroup", {
+    InstanceMethod("getLines", &LineGroup::GetLines),
+    InstanceMethod("getValues", &LineGroup::GetValues),
+    InstanceMethod("setValues", &LineGroup::SetValues),
+    InstanceMethod("getMask", &LineGroup::GetMask),
+    InstanceMethod("setMask", &LineGroup::SetMask),
+    InstanceMethod("watch", &LineGroup::Watch),
+    InstanceMethod("unwatch", &LineGroup::Unwatch),
+    InstanceMethod("getWatchStats", &LineGroup::GetWatchStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("LineGroup", func);
+  return exports;
+}
+
+LineGroup::LineGroup(const Napi::CallbackInfo& info) : Napi::ObjectWrap<LineGroup>(info), num_lines_(0), watching_(false) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    Napi::TypeError::New(env, "Array of LineRequest objects expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  Napi::Array requests = info[0].As<Napi::Array>();
+  for (uint32_t i = 0; i < requests.Length(); i++) {
+    Napi::Value val = requests[i];
+    if (!val.IsObject() || !val.As<Napi::Object>().InstanceOf(LineRequest::constructor.Value())) {
+      Napi::TypeError::New(env, "Requests array must contain only LineRequest instances").ThrowAsJavaScriptException();
+      return;
+    }
+
+    LineRequest* lineRequest = Napi::ObjectWrap<LineRequest>::Unwrap(val.As<Napi::Object>());
+    for (const auto& member : members_) {
+      if (member.owner == lineRequest) {
+        Napi::TypeError::New(env, "Requests array must not contain the same LineRequest twice").ThrowAsJavaScriptException();
+        return;
+      }
+    }
+    if (!lineRequest->GetRequest()) {
+      Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+      return;
+    }
+
+    Member member;
+    member.owner = lineRequest;
+    member.owner_ref = Napi::Persistent(val.As<Napi::Object>());
+    member.request = lineRequest->GetRequest();
+    member.first_index = num_lines_;
+
+    try {
+      member.chip = member.request->chip_name();
+    } catch (const std::exception& e) {
+      Napi::Error::New(env, "Failed to get chip name: " + std::string(e.what())).ThrowAsJavaScriptException();
+      return;
+    }
+
+    for (unsigned int offset : lineRequest->GetOffsets()) {
+      member.index[offset] = num_lines_++;
+      member.offsets.push_back(offset);
+    }
+    member.values.resize(member.offsets.size());
+    member.mappings.reserve(member.offsets.size());
+
+    members_.push_back(std::move(member));
+  }
+
+  if (members_.empty()) {
+    Napi::TypeError::New(env, "At least one LineRequest expected").ThrowAsJavaScriptException();
+    return;
+  }
+}
+
+LineGroup::~LineGroup() {
+  StopWatching();
+}
+
+bool LineGroup::CheckActive(Napi::Env env) {
+  // Pick up releases of the underlying requests
+  for (auto& member : members_) {
+    member.request = member.owner->GetRequest();
+    if (!member.request) {
+      Napi::Error::New(env, "Line request of chip " + member.chip + " is not active").ThrowAsJavaScriptException();
+      return false;
+    }
+  }
+  return true;
+}
+
+void LineGroup::ReadAll() {
+  // Issue the reads back to back to keep the skew between chips small
+  for (auto& member : members_) {
+    member.request->get_values(member.offsets, member.values);
+  }
+}
+
+Napi::Value LineGroup::GetLines(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Array result = Napi::Array::New(env, num_lines_);
+  for (const auto& member : members_) {
+    for (size_t i = 0; i < member.offsets.size(); i++) {
+      Napi::Object line = Napi::Object::New(env);
+      line.Set("chip", Napi::String::New(env, member.chip));
+      line.Set("offset", Napi::Number::New(env, static_cast<unsigned int>(member.offsets[i])));
+      result[static_cast<uint32_t>(member.first_index + i)] = line;
+    }
+  }
+
+  return result;
+}
+
+Napi::Value LineGroup::GetValues(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!CheckActive(env)) {
+    return env.Null();
+  }
+
+  try {
+    ReadAll();
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to get values: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  Napi::Array result = Napi::Array::New(env, num_lines_);
+  for (const auto& member : members_) {
+    for (size_t i = 0; i < member.values.size(); i++) {
+      result[static_cast<uint32_t>(member.first_index + i)] = Napi::Number::New(env, static_cast<int>(member.values[i]));
+    }
+  }
+
+  return result;
+}
+
+Napi::Value LineGroup::SetValues(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsArray()) {
+    Napi::TypeError::New(env, "Values array expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Array values = info[0].As<Napi::Array>();
+  if (values.Length() != num_lines_) {
+    Napi::RangeError::New(env, "Expected " + std::to_string(num_lines_) + " values").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!CheckActive(env)) {
+    return env.Undefined();
+  }
+
+  // Convert everything first so the ioctls can be issued back to back
+  for (auto& member : members_) {
+    for (size_t i = 0; i < member.values.size(); i++) {
+      Napi::Value val = values[static_cast<uint32_t>(member.first_index + i)];
+      if (!val.IsNumber()) {
+        Napi::TypeError::New(env, "Values array must contain only numbers").ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+      member.values[i] = val.As<Napi::Number>().Int32Value() ? gpiod::line::value::ACTIVE : gpiod::line::value::INACTIVE;
+    }
+    member.mappings.clear();
+    for (size_t i = 0; i < member.offsets.size(); i++) {
+      member.mappings.emplace_back(member.offsets[i], member.values[i]);
+    }
+  }
+
+  WriteMembers(env);
+  return env.Undefined();
+}
+
+Napi::Value LineGroup::GetMask(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (num_lines_ > 32) {
+    Napi::RangeError::New(env, "Bitmask operations support at most 32 lines").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  if (!CheckActive(env)) {
+    return env.Null();
+  }
+
+  try {
+    ReadAll();
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to get values: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  uint32_t mask = 0;
+  for (const auto& member : members_) {
+    for (size_t i = 0; i < member.values.size(); i++) {
+      if (member.values[i] == gpiod::line::value::ACTIVE) {
+        mask |= 1u << (member.first_index + i);
+      }
+    }
+  }
+
+  return Napi::Number::New(env, mask);
+}
+
+Napi::Value LineGroup::SetMask(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Mask and bits numbers expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (num_lines_ > 32) {
+    Napi::RangeError::New(env, "Bitmask operations support at most 32 lines").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!CheckActive(env)) {
+    return env.Undefined();
+  }
+
+  uint32_t mask = info[0].As<Napi::Number>().Uint32Value();
+  uint32_t bits = info[1].As<Napi::Number>().Uint32Value();
+
+  // Only the masked lines are written, members without masked lines are skipped
+  for (auto& member : members_) {
+    member.mappings.clear();
+    for (size_t i = 0; i < member.offsets.size(); i++) {
+      uint32_t bit = 1u << (member.first_index + i);
+      if (mask & bit) {
+        member.mappings.emplace_back(member.offsets[i], (bits & bit) ? gpiod::line::value::ACTIVE : gpiod::line::value::INACTIVE);
+      }
+    }
+  }
+
+  WriteMembers(env);
+  return env.Undefined();
+}
+
+void LineGroup::WriteMembers(Napi::Env env) {
+  // Writes go through the shadow of each member request, so it stays in
+  // step. All ioctls are issued before any observer runs, so observers can
+  // neither delay nor release a member that is still to be written.
+  std::vector<gpiod::line::value_mappings> changes(members_.size());
+  std::string error;
+  size_t written = 0;
+  for (; written < members_.size(); written++) {
+    Member& member = members_[written];
+    if (member.mappings.empty()) {
+      continue;
+    }
+    try {
+      changes[written] = member.owner->WriteShadowed(member.mappings);
+    } catch (const std::exception& e) {
+      error = e.what();
+      break;
+    }
+  }
+
+  for (size_t i = 0; i < written; i++) {
+    members_[i].owner->NotifyObserver(env, changes[i]);
+    if (env.IsExceptionPending()) {
+      return;
+    }
+  }
+
+  if (!error.empty()) {
+    Napi::Error::New(env, "Failed to set values: " + error).ThrowAsJavaScriptException();
+  }
+}
+
+Napi::Value LineGroup::Watch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsFunction()) {
+    Napi::TypeError::New(env, "Callback function expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!CheckActive(env)) {
+    return env.Undefined();
+  }
+
+  GlitchFilterOptions filter_options;
+  if (info.Length() > 1 && info[1].IsObject() &&
+      !ReadGlitchFilterOptions(env, info[1].As<Napi::Object>(), filter_options)) {
+    return env.Undefined();
+  }
+
+  StopWatching();
+
+  for (auto& member : members_) {
+    if (!member.owner->ClaimEdgeEvents(env, this, "LineGroup.watch()")) {
+      ReleaseEdgeClaims();
+      return env.Undefined();
+    }
+  }
+
+  tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    info[0].As<Napi::Function>(),
+    "GPIO Line Group Watch Callback",
+    0,
+    1
+  );
+
+  std::vector<std::shared_ptr<gpiod::line_request>> requests;
+  for (const auto& member : members_) {
+    requests.push_back(member.request);
+  }
+
+  reader_ = std::make_unique<EdgeReader>(
+    requests,
+    [this](const std::vector<EdgeRecord>& events) {
+      std::vector<EdgeRecord> batch = events;
+      auto callback = [this, batch](Napi::Env env, Napi::Function jsCallback) {
+        for (const auto& record : batch) {
+          const Member& member = members_[record.source];
+          auto it = member.index.find(record.offset);
+          if (it == member.index.end()) {
+            continue;
+          }
+
+          Napi::Object event = EdgeRecordToObject(env, record);
+          event.Set("index", Napi::Number::New(env, static_cast<double>(it->second)));
+          event.Set("chip", Napi::String::New(env, member.chip));
+          jsCallback.Call({env.Null(), event});
+        }
+      };
+      tsfn_.BlockingCall(callback);
+    },
+    [this](const std::string& error) {
+      auto callback = [error](Napi::Env env, Napi::Function jsCallback) {
+        jsCallback.Call({Napi::Error::New(env, error).Value(), env.Null()});
+      };
+      tsfn_.BlockingCall(callback);
+    }
+  );
+
+  filter_ = std::make_shared<GlitchFilter>(filter_options);
+  reader_->SetGlitchFilter(filter_);
+
+  watching_ = true;
+  std::string error = reader_->Start();
+  if (!error.empty()) {
+    StopWatching();
+    Napi::Error::New(env, "Failed to start watching: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value LineGroup::Unwatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  StopWatching();
+
+  return env.Undefined();
+}
+
+Napi::Value LineGroup::GetWatchStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  GlitchFilter::Stats stats = filter_ ? filter_->GetStats() : GlitchFilter::Stats{0, 0};
+  return GlitchStatsToObject(env, stats);
+}
+
+void LineGroup::StopWatching() {
+  if (watching_) {
+    watching_ = false;
+
+    if (reader_) {
+      reader_->Stop();
+      reader_.reset();
+    }
+
+    tsfn_.Release();
+  }
+
+  ReleaseEdgeClaims();
+}
+
+void LineGroup::ReleaseEdgeClaims() {
+  for (auto& member : members_) {
+    member.owner->ReleaseEdgeEvents(this);
+  }
+}
@@ -0,0 +1,63 @@
+#ifndef LINE_GROUP_H
+#define LINE_GROUP_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include <map>
+#include "line_request.h"
+#include "edge_reader.h"
+#include "glitch_filter.h"
+
+class LineGroup : public Napi::ObjectWrap<LineGroup> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  LineGroup(const Napi::CallbackInfo& info);
+  ~LineGroup();
+
+  // Wrapped methods
+  Napi::Value GetLines(const Napi::CallbackInfo& info);
+  Napi::Value GetValues(const Napi::CallbackInfo& info);
+  Napi::Value SetValues(const Napi::CallbackInfo& info);
+  Napi::Value GetMask(const Napi::CallbackInfo& info);
+  Napi::Value SetMask(const Napi::CallbackInfo& info);
+  Napi::Value Watch(const Napi::CallbackInfo& info);
+  Napi::Value Unwatch(const Napi::CallbackInfo& info);
+  Napi::Value GetWatchStats(const Napi::CallbackInfo& info);
+
+private:
+  // One request per underlying chip, lines are numbered across all members
+  struct Member {
+    LineRequest* owner;
+    Napi::ObjectReference owner_ref;
+    std::shared_ptr<gpiod::line_request> request;
+    std::string chip;
+    gpiod::line::offsets offsets;
+    std::map<unsigned int, size_t> index;
+    size_t first_index;
+    gpiod::line::values values;
+    gpiod::line::value_mappings mappings;
+  };
+
+  std::vector<Member> members_;
+  size_t num_lines_;
+
+  // Merged edge event stream
+  std::unique_ptr<EdgeReader> reader_;
+  std::shared_ptr<GlitchFilter> filter_;
+  Napi::ThreadSafeFunction tsfn_;
+  bool watching_;
+
+  // Internal methods
+  bool CheckActive(Napi::Env env);
+  void ReadAll();
+  void WriteMembers(Napi::Env env);
+  void StopWatching();
+  void ReleaseEdgeClaims();
+};
+
+#endif // LINE_GROUP_H
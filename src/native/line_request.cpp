@@ -1,4 +1,9 @@
 #include "line_request.h"
+#include "program.h"
+#include "pulse_meter.h"
+#include "engine_utils.h"
+#include <algorithm>
+#include <stdexcept>
 
 Napi::FunctionReference LineRequest::constructor;
 
@@ -8,6 +13,15 @@ Napi::Object LineRequest::Init(Napi::Env env, Napi::Object exports) {
   Napi::Function func = DefineClass(env, "LineRequest", {
     InstanceMethod("getValue", &LineRequest::GetValue),
     InstanceMethod("setValue", &LineRequest::SetValue),
+    InstanceMethod("getValues", &LineRequest::GetValues),
+    InstanceMethod("setValues", &LineRequest::SetValues),
+    InstanceMethod("setValuesAt", &LineRequest::SetValuesAt),
+    InstanceMethod("setOutputObserver", &LineRequest::SetOutputObserver),
+    InstanceMethod("setWriteElision", &LineRequest::SetWriteElision),
+    InstanceMethod("getWriteStats", &LineRequest::GetWriteStats),
+    InstanceMethod("execute", &LineRequest::Execute),
+    InstanceMethod("measurePulse", &LineRequest::MeasurePulse),
+    InstanceMethod("reconfigure", &LineRequest::Reconfigure),
     InstanceMethod("release", &LineRequest::Release)
   });
 
@@ -53,6 +67,7 @@ LineRequest::LineRequest(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Line
     return;
   }
   config_ = std::shared_ptr<LineConfig>(Napi::ObjectWrap<LineConfig>::Unwrap(configObj), [](LineConfig*){});
+  config_ref_ = Napi::Persistent(configObj);
 
   try {
     // Create the line request using request_builder
@@ -61,44 +76,22 @@ LineRequest::LineRequest(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Line
     // Set consumer name
     builder.set_consumer("libgpiod2-node");
     
-    // Get the line settings from the config
-    const auto& settings_map = config_->GetConfig()->get_line_settings();
-    
-    // If there are no specific line settings in the config, apply the global config
-    if (settings_map.empty()) {
-      // Set the global line configuration
+    if (config_->GetConfig()->get_line_settings().empty()) {
+      // Without per-line settings, apply the global config as is so that
+      // state outside the line settings, like output values, is kept
       builder.set_line_config(*config_->GetConfig());
-      
-      // Add each offset with default settings
       for (const auto& offset : offsets_) {
         gpiod::line_settings settings;
         builder.add_line_settings(offset, settings);
       }
     } else {
-      // Apply specific settings for each offset
-      for (const auto& offset : offsets_) {
-        // Check if there are settings for this offset in the config
-        auto settings_it = settings_map.find(offset);
-        
-        if (settings_it != settings_map.end()) {
-          // Use the existing settings from the config
-          builder.add_line_settings(offset, settings_it->second);
-        } else {
-          // If there are no settings for this offset but settings exist for other offsets,
-          // use the settings from offset 0 as a fallback (if it exists)
-          auto default_settings_it = settings_map.find(0);
-          if (default_settings_it != settings_map.end()) {
-            builder.add_line_settings(offset, default_settings_it->second);
-          } else {
-            // Otherwise, use the first available settings as a template
-            builder.add_line_settings(offset, settings_map.begin()->second);
-          }
-        }
-      }
+      // Resolve the settings of every requested line
+      gpiod::line_config line_config = BuildConfig();
+      builder.set_line_config(line_config);
     }
     
     // Request the lines
-    request_ = std::make_shared<gpiod::line_request>(builder.do_request());
+    std::atomic_store(&request_, std::make_shared<gpiod::line_request>(builder.do_request()));
   } catch (const std::exception& e) {
     Napi::Error::New(env, "Failed to request lines: " + std::string(e.what())).ThrowAsJavaScriptException();
     return;
@@ -106,9 +99,12 @@ LineRequest::LineRequest(const Napi::CallbackInfo& info) : Napi::ObjectWrap<Line
 }
 
 LineRequest::~LineRequest() {
+  // Pending writes keep the wrapper alive, so the scheduler is idle here
+  scheduler_.reset();
+
   if (request_) {
     try {
-      request_.reset();
+      std::atomic_store(&request_, std::shared_ptr<gpiod::line_request>());
     } catch (...) {
       // Ignore exceptions in destructor
     }
@@ -159,7 +155,7 @@ Napi::Value LineRequest::SetValue(const Napi::CallbackInfo& info) {
   }
 
   try {
-    request_->set_value(offset, value);
+    WriteValues(env, {{offset, value}});
     return env.Undefined();
   } catch (const std::exception& e) {
     Napi::Error::New(env, "Failed to set value: " + std::string(e.what())).ThrowAsJavaScriptException();
@@ -167,13 +163,475 @@ Napi::Value LineRequest::SetValue(const Napi::CallbackInfo& info) {
   }
 }
 
+Napi::Value LineRequest::GetValues(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!request_) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Null();
+  }
+
+  gpiod::line::offsets offsets;
+  if (info.Length() > 0 && info[0].IsArray()) {
+    Napi::Array offsetsArray = info[0].As<Napi::Array>();
+    for (uint32_t i = 0; i < offsetsArray.Length(); i++) {
+      Napi::Value val = offsetsArray[i];
+      if (!val.IsNumber()) {
+        Napi::TypeError::New(env, "Offsets array must contain only numbers").ThrowAsJavaScriptException();
+        return env.Null();
+      }
+      offsets.push_back(val.As<Napi::Number>().Uint32Value());
+    }
+  } else {
+    offsets.assign(offsets_.begin(), offsets_.end());
+  }
+
+  try {
+    gpiod::line::values values = request_->get_values(offsets);
+
+    Napi::Array result = Napi::Array::New(env, values.size());
+    for (size_t i = 0; i < values.size(); i++) {
+      result[static_cast<uint32_t>(i)] = Napi::Number::New(env, static_cast<int>(values[i]));
+    }
+    return result;
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to get values: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return env.Null();
+  }
+}
+
+Napi::Value LineRequest::SetValues(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsArray() || !info[1].IsArray()) {
+    Napi::TypeError::New(env, "Offsets and values arrays expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Array offsetsArray = info[0].As<Napi::Array>();
+  Napi::Array valuesArray = info[1].As<Napi::Array>();
+  if (offsetsArray.Length() != valuesArray.Length()) {
+    Napi::RangeError::New(env, "Offsets and values arrays must have the same length").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  gpiod::line::value_mappings mappings;
+  for (uint32_t i = 0; i < offsetsArray.Length(); i++) {
+    Napi::Value offset = offsetsArray[i];
+    Napi::Value value = valuesArray[i];
+    if (!offset.IsNumber() || !value.IsNumber()) {
+      Napi::TypeError::New(env, "Offsets and values arrays must contain only numbers").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    mappings.emplace_back(offset.As<Napi::Number>().Uint32Value(),
+      value.As<Napi::Number>().Int32Value() ? gpiod::line::value::ACTIVE : gpiod::line::value::INACTIVE);
+  }
+
+  if (!request_) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  try {
+    size_t changed = WriteValues(env, mappings);
+    return Napi::Number::New(env, static_cast<double>(changed));
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to set values: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+}
+
+Napi::Value LineRequest::SetValuesAt(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 4 || !info[0].IsBigInt() || !info[1].IsArray() || !info[2].IsArray() || !info[3].IsObject()) {
+    Napi::TypeError::New(env, "Time bigint, offsets and values arrays and options object expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  bool lossless = true;
+  uint64_t time_ns = info[0].As<Napi::BigInt>().Uint64Value(&lossless);
+  if (!lossless) {
+    Napi::RangeError::New(env, "Time must be a non-negative 64-bit nanosecond value").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Array offsetsArray = info[1].As<Napi::Array>();
+  Napi::Array valuesArray = info[2].As<Napi::Array>();
+  if (offsetsArray.Length() == 0 || offsetsArray.Length() != valuesArray.Length()) {
+    Napi::RangeError::New(env, "Offsets and values arrays must have the same, non-zero length").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Bad offsets are rejected now rather than when the write fires
+  gpiod::line::value_mappings mappings;
+  for (uint32_t i = 0; i < offsetsArray.Length(); i++) {
+    Napi::Value offset = offsetsArray[i];
+    Napi::Value value = valuesArray[i];
+    if (!offset.IsNumber() || !value.IsNumber()) {
+      Napi::TypeError::New(env, "Offsets and values arrays must contain only numbers").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    unsigned int line = offset.As<Napi::Number>().Uint32Value();
+    if (std::find(offsets_.begin(), offsets_.end(), line) == offsets_.end()) {
+      Napi::RangeError::New(env, "Offset " + std::to_string(line) + " is not part of the request").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    mappings.emplace_back(line, ToValue(value.As<Napi::Number>().Int32Value() != 0));
+  }
+
+  Napi::Object options = info[3].As<Napi::Object>();
+  std::string clock_name = "monotonic";
+  if (options.Has("clock") && options.Get("clock").IsString()) {
+    clock_name = options.Get("clock").As<Napi::String>().Utf8Value();
+  }
+  if (clock_name != "monotonic" && clock_name != "realtime") {
+    Napi::RangeError::New(env, "Clock must be 'monotonic' or 'realtime'").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  clockid_t clock = clock_name == "realtime" ? CLOCK_REALTIME : CLOCK_MONOTONIC;
+
+  double spin_us = ReadNumber(options, "spinUs", 50);
+  if (spin_us < 0) {
+    Napi::RangeError::New(env, "spinUs must not be negative").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  uint64_t spin_ns = static_cast<uint64_t>(spin_us * 1e3);
+
+  if (!request_) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!scheduler_) {
+    scheduler_ = std::make_unique<WriteScheduler>(this);
+    std::string error = scheduler_->Start(env);
+    if (!error.empty()) {
+      scheduler_.reset();
+      Napi::Error::New(env, "Failed to start write scheduler: " + error).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  WriteScheduler::Write write = {0, clock, time_ns, spin_ns, mappings};
+  return scheduler_->Schedule(env, info.This().As<Napi::Object>(), std::move(write));
+}
+
+Napi::Value LineRequest::SetOutputObserver(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !(info[0].IsFunction() || info[0].IsNull())) {
+    Napi::TypeError::New(env, "Observer function or null expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (info[0].IsFunction()) {
+    observer_ = Napi::Persistent(info[0].As<Napi::Function>());
+  } else {
+    observer_.Reset();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value LineRequest::SetWriteElision(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsBoolean()) {
+    Napi::TypeError::New(env, "Boolean expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::lock_guard<std::mutex> lock(shadow_mutex_);
+  write_elision_ = info[0].As<Napi::Boolean>().Value();
+
+  return env.Undefined();
+}
+
+Napi::Value LineRequest::GetWriteStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  std::lock_guard<std::mutex> lock(shadow_mutex_);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("writes", Napi::Number::New(env, static_cast<double>(writes_)));
+  result.Set("elided", Napi::Number::New(env, static_cast<double>(elided_)));
+  result.Set("ioctls", Napi::Number::New(env, static_cast<double>(ioctls_)));
+
+  return result;
+}
+
+Napi::Value LineRequest::Execute(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  std::vector<uint32_t> code;
+  if (info.Length() > 0 && info[0].IsArrayBuffer()) {
+    Napi::ArrayBuffer buffer = info[0].As<Napi::ArrayBuffer>();
+    if (buffer.ByteLength() % sizeof(uint32_t) != 0) {
+      Napi::RangeError::New(env, "Program ArrayBuffer length must be a multiple of 4 bytes").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    const uint32_t* words = static_cast<const uint32_t*>(buffer.Data());
+    code.assign(words, words + buffer.ByteLength() / sizeof(uint32_t));
+  } else if (info.Length() > 0 && info[0].IsTypedArray() &&
+             info[0].As<Napi::TypedArray>().TypedArrayType() == napi_uint32_array) {
+    Napi::Uint32Array words = info[0].As<Napi::Uint32Array>();
+    code.assign(words.Data(), words.Data() + words.ElementLength());
+  } else {
+    Napi::TypeError::New(env, "Program ArrayBuffer or Uint32Array expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!request_) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  size_t slots = 0;
+  bool waits_edges = false;
+  std::string error = ValidateProgram(code, offsets_.size(), slots, waits_edges);
+  if (!error.empty()) {
+    Napi::Error::New(env, "Invalid program: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  ProgramWorker* worker = new ProgramWorker(env, this, info.This().As<Napi::Object>(), code, slots, waits_edges);
+  if (waits_edges && !ClaimEdgeEvents(env, worker, "execute()")) {
+    delete worker;
+    return env.Undefined();
+  }
+  Napi::Promise promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value LineRequest::MeasurePulse(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  unsigned int trigger = 0;
+  unsigned int echo = 0;
+  uint64_t trigger_ns = 0;
+  uint64_t timeout_ns = 0;
+  if (!ReadPulseOptions(env, this, info[0], info[1], info[2], trigger, echo, trigger_ns, timeout_ns)) {
+    return env.Undefined();
+  }
+
+  if (!request_) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto width = std::make_shared<uint64_t>(0);
+  PromiseWorker* worker = new PromiseWorker(env, "GPIO Pulse Measurement", info.This().As<Napi::Object>(), this,
+    [this, trigger, echo, trigger_ns, timeout_ns, width]() {
+      gpiod::edge_event_buffer buffer(16);
+      try {
+        PulseMeasurement result = ::MeasurePulse(this, buffer, trigger, echo, trigger_ns, timeout_ns);
+        *width = result.falling_ns - result.rising_ns;
+      } catch (const std::exception& e) {
+        throw std::runtime_error("Pulse measurement failed: " + std::string(e.what()));
+      }
+    },
+    [width](Napi::Env env) -> Napi::Value {
+      return Napi::Number::New(env, static_cast<double>(*width));
+    }
+  );
+  if (!worker->ClaimEdgeEvents(env, "measurePulse()")) {
+    delete worker;
+    return env.Undefined();
+  }
+  Napi::Promise promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+size_t LineRequest::WriteValues(Napi::Env env, const gpiod::line::value_mappings& values) {
+  gpiod::line::value_mappings changes = WriteShadowed(values);
+  NotifyObserver(env, changes);
+  return changes.size();
+}
+
+gpiod::line::value_mappings LineRequest::WriteShadowed(const gpiod::line::value_mappings& values) {
+  gpiod::line::value_mappings changes;
+
+  {
+    // Engines hold the bus lock for whole jobs, so the JavaScript thread
+    // never waits for it. While a job runs the lines are written behind
+    // the shadow, which is then bypassed and forgotten.
+    std::unique_lock<std::mutex> bus_lock(bus_mutex_, std::try_to_lock);
+    std::lock_guard<std::mutex> lock(shadow_mutex_);
+    if (!request_) {
+      throw std::runtime_error("Line request is not active");
+    }
+    bool shadowed = bus_lock.owns_lock();
+    if (!shadowed) {
+      shadow_.clear();
+    }
+    writes_ += values.size();
+
+    gpiod::line::value_mappings writes;
+    for (const auto& mapping : values) {
+      auto it = shadow_.find(mapping.first);
+      bool changed = it == shadow_.end() || it->second != mapping.second;
+      if (!changed && write_elision_) {
+        elided_++;
+        continue;
+      }
+      if (changed) {
+        changes.push_back(mapping);
+      }
+      writes.push_back(mapping);
+    }
+
+    if (writes.empty()) {
+      return changes;
+    }
+
+    request_->set_values(writes);
+    ioctls_++;
+
+    // Only remember values the kernel accepted
+    if (shadowed) {
+      for (const auto& mapping : writes) {
+        shadow_[mapping.first] = mapping.second;
+      }
+    }
+  }
+
+  return changes;
+}
+
+void LineRequest::NotifyObserver(Napi::Env env, const gpiod::line::value_mappings& changes) {
+  if (!observer_.IsEmpty() && !changes.empty()) {
+    Napi::Array transitions = Napi::Array::New(env, changes.size());
+    for (size_t i = 0; i < changes.size(); i++) {
+      Napi::Object transition = Napi::Object::New(env);
+      transition.Set("offset", Napi::Number::New(env, static_cast<unsigned int>(changes[i].first)));
+      transition.Set("value", Napi::Number::New(env, static_cast<int>(changes[i].second)));
+      transitions[static_cast<uint32_t>(i)] = transition;
+    }
+    observer_.Call({transitions});
+  }
+}
+
+std::mutex& LineRequest::BusMutex() {
+  return bus_mutex_;
+}
+
+void LineRequest::InvalidateShadow() {
+  std::lock_guard<std::mutex> lock(shadow_mutex_);
+  shadow_.clear();
+}
+
+gpiod::line_config LineRequest::BuildConfig(const std::map<unsigned int, gpiod::line_settings>& overrides) const {
+  gpiod::line_config result;
+
+  // Get the line settings from the config
+  const auto& settings_map = config_->GetConfig()->get_line_settings();
+
+  for (const auto& offset : offsets_) {
+    auto override_it = overrides.find(offset);
+    if (override_it != overrides.end()) {
+      result.add_line_settings(offset, override_it->second);
+      continue;
+    }
+
+    // If there are no specific line settings in the config, use the defaults.
+    // The constructor applies such a config directly instead.
+    if (settings_map.empty()) {
+      result.add_line_settings(offset, gpiod::line_settings());
+      continue;
+    }
+
+    // Check if there are settings for this offset in the config
+    auto settings_it = settings_map.find(offset);
+    if (settings_it != settings_map.end()) {
+      result.add_line_settings(offset, settings_it->second);
+    } else {
+      // If there are no settings for this offset but settings exist for other offsets,
+      // use the settings from offset 0 as a fallback (if it exists)
+      auto default_settings_it = settings_map.find(0);
+      if (default_settings_it != settings_map.end()) {
+        result.add_line_settings(offset, default_settings_it->second);
+      } else {
+        // Otherwise, use the first available settings as a template
+        result.add_line_settings(offset, settings_map.begin()->second);
+      }
+    }
+  }
+
+  return result;
+}
+
+void LineRequest::ReconfigureLines(const gpiod::line_config& config) {
+  std::lock_guard<std::mutex> lock(bus_mutex_);
+  if (!request_) {
+    throw std::runtime_error("line request is not active");
+  }
+  request_->reconfigure_lines(config);
+  InvalidateShadow();
+}
+
+Napi::Value LineRequest::Reconfigure(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsObject() ||
+      !info[0].As<Napi::Object>().InstanceOf(LineConfig::constructor.Value())) {
+    Napi::TypeError::New(env, "LineConfig object expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!request_) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Object configObj = info[0].As<Napi::Object>();
+  std::shared_ptr<LineConfig> previous = config_;
+  config_ = std::shared_ptr<LineConfig>(Napi::ObjectWrap<LineConfig>::Unwrap(configObj), [](LineConfig*){});
+
+  try {
+    // The lines stay requested, so there is no window in which another
+    // consumer could take them and outputs keep driving
+    ReconfigureLines(BuildConfig());
+  } catch (const std::exception& e) {
+    config_ = previous;
+    Napi::Error::New(env, "Failed to reconfigure lines: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  config_ref_ = Napi::Persistent(configObj);
+  return env.Undefined();
+}
+
 Napi::Value LineRequest::Release(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
 
+  released_ = true;
+
+  // Writes still queued are rejected; one being issued finishes first
+  if (scheduler_) {
+    scheduler_->Cancel(env, "Scheduled write cancelled: line request was released");
+  }
+
   if (request_) {
     try {
-      request_.reset();
+      // Engines fetch the request under the bus lock for every write, so a
+      // write in progress is the last one; the lines are freed when it ends
+      std::atomic_store(&request_, std::shared_ptr<gpiod::line_request>());
+      InvalidateShadow();
       return env.Undefined();
     } catch (const std::exception& e) {
       Napi::Error::New(env, "Failed to release lines: " + std::string(e.what())).ThrowAsJavaScriptException();
@@ -184,6 +642,45 @@ Napi::Value LineRequest::Release(const Napi::CallbackInfo& info) {
   return env.Undefined();
 }
 
+bool LineRequest::ClaimEdgeEvents(Napi::Env env, const void* consumer, const std::string& name) {
+  if (edge_consumer_ && edge_consumer_ != consumer) {
+    Napi::Error::New(env, "Edge events of the request are already read by " + edge_consumer_name_ +
+      "; stop it before starting " + name).ThrowAsJavaScriptException();
+    return false;
+  }
+
+  edge_consumer_ = consumer;
+  edge_consumer_name_ = name;
+  return true;
+}
+
+void LineRequest::ReleaseEdgeEvents(const void* consumer) {
+  if (edge_consumer_ == consumer) {
+    edge_consumer_ = nullptr;
+    edge_consumer_name_.clear();
+  }
+}
+
 std::shared_ptr<gpiod::line_request> LineRequest::GetRequest() const {
-  return request_;
+  return std::atomic_load(&request_);
+}
+
+std::shared_ptr<gpiod::line_request> LineRequest::ActiveRequest() const {
+  std::shared_ptr<gpiod::line_request> request = GetRequest();
+  if (!request) {
+    throw std::runtime_error("line request is not active");
+  }
+  return request;
+}
+
+bool LineRequest::IsReleased() const {
+  return released_;
+}
+
+std::shared_ptr<Chip> LineRequest::GetChip() const {
+  return chip_;
+}
+
+const std::vector<unsigned int>& LineRequest::GetOffsets() const {
+  return offsets_;
 }
@@ -5,8 +5,14 @@
 #include <gpiod.hpp>
 #include <memory>
 #include <vector>
+#include <map>
+#include <string>
+#include <mutex>
+#include <atomic>
+#include <cstdint>
 #include "chip.h"
 #include "line_config.h"
+#include "write_scheduler.h"
 
 class LineRequest : public Napi::ObjectWrap<LineRequest> {
 public:
@@ -19,16 +25,94 @@ public:
   // Wrapped methods
   Napi::Value GetValue(const Napi::CallbackInfo& info);
   Napi::Value SetValue(const Napi::CallbackInfo& info);
+  Napi::Value GetValues(const Napi::CallbackInfo& info);
+  Napi::Value SetValues(const Napi::CallbackInfo& info);
+  Napi::Value SetValuesAt(const Napi::CallbackInfo& info);
+  Napi::Value SetOutputObserver(const Napi::CallbackInfo& info);
+  Napi::Value SetWriteElision(const Napi::CallbackInfo& info);
+  Napi::Value GetWriteStats(const Napi::CallbackInfo& info);
+  Napi::Value Execute(const Napi::CallbackInfo& info);
+  Napi::Value MeasurePulse(const Napi::CallbackInfo& info);
+  Napi::Value Reconfigure(const Napi::CallbackInfo& info);
   Napi::Value Release(const Napi::CallbackInfo& info);
 
-  // Internal methods
+  // Internal methods. GetRequest may be called from any thread; release()
+  // only drops the request from the JavaScript thread.
   std::shared_ptr<gpiod::line_request> GetRequest() const;
 
+  // Set by release(); long native jobs poll it to stop early
+  bool IsReleased() const;
+
+  // Gets the request for one write of an engine thread, throwing if it was
+  // released. Call it under the bus lock for every write and drop the
+  // result afterwards, so engines stop driving released lines.
+  std::shared_ptr<gpiod::line_request> ActiveRequest() const;
+  std::shared_ptr<Chip> GetChip() const;
+  const std::vector<unsigned int>& GetOffsets() const;
+
+  // Writes through the output shadow: the values are coalesced into one
+  // set_values call, skipping unchanged ones if write elision is enabled.
+  // Never waits for the bus lock; while an engine job holds it, the shadow
+  // is bypassed. Returns the number of lines that changed. Must be called
+  // from the JavaScript thread.
+  size_t WriteValues(Napi::Env env, const gpiod::line::value_mappings& values);
+
+  // The two halves of WriteValues, for callers that issue several writes
+  // back to back before any JavaScript runs: the write returns the changed
+  // values, which are then passed to the output observer
+  gpiod::line::value_mappings WriteShadowed(const gpiod::line::value_mappings& values);
+  void NotifyObserver(Napi::Env env, const gpiod::line::value_mappings& changes);
+
+  // Forgets the shadowed values, e.g. after native code drove the lines directly
+  void InvalidateShadow();
+
+  // Serializes native engines that drive the lines from worker threads
+  std::mutex& BusMutex();
+
+  // Reading edge events consumes them, so only one consumer may read the
+  // edges of the request at a time. Throws an error naming the current
+  // consumer and returns false if the claim is held by another one.
+  // Must be called from the JavaScript thread.
+  bool ClaimEdgeEvents(Napi::Env env, const void* consumer, const std::string& name);
+
+  // Gives up the claim if it is held by the consumer
+  void ReleaseEdgeEvents(const void* consumer);
+
+  // Resolves the settings of every requested line from the current
+  // LineConfig, with per-line overrides. Must be called from the JavaScript
+  // thread.
+  gpiod::line_config BuildConfig(const std::map<unsigned int, gpiod::line_settings>& overrides = {}) const;
+
+  // Changes the settings of the requested lines without releasing them.
+  // Takes the bus lock, so it must not be called while holding it.
+  void ReconfigureLines(const gpiod::line_config& config);
+
 private:
   std::shared_ptr<Chip> chip_;
   std::shared_ptr<LineConfig> config_;
+  Napi::ObjectReference config_ref_;
   std::vector<unsigned int> offsets_;
+  // Replaced with atomic stores, read from other threads with atomic loads
   std::shared_ptr<gpiod::line_request> request_;
+
+  // Output shadow register
+  std::mutex shadow_mutex_;
+  std::map<unsigned int, gpiod::line::value> shadow_;
+  bool write_elision_ = false;
+  uint64_t writes_ = 0;
+  uint64_t elided_ = 0;
+  uint64_t ioctls_ = 0;
+  Napi::FunctionReference observer_;
+
+  std::mutex bus_mutex_;
+  std::atomic<bool> released_{false};
+
+  // Started by the first setValuesAt call
+  std::unique_ptr<WriteScheduler> scheduler_;
+
+  // Current reader of the edge events
+  const void* edge_consumer_ = nullptr;
+  std::string edge_consumer_name_;
 };
 
 #endif // LINE_REQUEST_H
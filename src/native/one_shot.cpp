@@ -0,0 +1,273 @@
+#include "one_shot.h"
+#include "timing.h"
+#include "engine_utils.h"
+#include <algorithm>
+#include <stdexcept>
+
+Napi::FunctionReference DelayedOneShot::constructor;
+
+Napi::Object DelayedOneShot::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "DelayedOneShot", {
+    InstanceMethod("setDelay", &DelayedOneShot::SetDelay),
+    InstanceMethod("getDelay", &DelayedOneShot::GetDelay),
+    InstanceMethod("start", &DelayedOneShot::Start),
+    InstanceMethod("stop", &DelayedOneShot::Stop),
+    InstanceMethod("getStats", &DelayedOneShot::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("DelayedOneShot", func);
+  return exports;
+}
+
+DelayedOneShot::DelayedOneShot(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<DelayedOneShot>(info), owner_(nullptr), trigger_(0), output_(0), on_rising_(true),
+    on_falling_(false), width_ns_(0), max_delay_ns_(0), max_late_ns_(0), spin_ns_(0), delay_ns_(-1), triggers_(0),
+    pulses_(0), missed_(0), max_jitter_ns_(0), total_jitter_ns_(0), last_trigger_ns_(0), period_ns_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  int trigger = -1;
+  int output = -1;
+  if (!ReadLineOffset(env, options, "trigger", owner_->GetOffsets(), true, trigger) ||
+      !ReadLineOffset(env, options, "output", owner_->GetOffsets(), true, output)) {
+    return;
+  }
+  if (trigger == output) {
+    Napi::RangeError::New(env, "Trigger and output must be different lines").ThrowAsJavaScriptException();
+    return;
+  }
+  trigger_ = static_cast<unsigned int>(trigger);
+  output_ = static_cast<unsigned int>(output);
+
+  std::string edge = "rising";
+  if (options.Has("edge") && options.Get("edge").IsString()) {
+    edge = options.Get("edge").As<Napi::String>().Utf8Value();
+  }
+  if (edge != "rising" && edge != "falling" && edge != "both") {
+    Napi::RangeError::New(env, "Edge must be 'rising', 'falling' or 'both'").ThrowAsJavaScriptException();
+    return;
+  }
+  on_rising_ = edge != "falling";
+  on_falling_ = edge != "rising";
+
+  double width_us = ReadNumber(options, "widthUs", 100);
+  double max_delay_us = ReadNumber(options, "maxDelayUs", 10000);
+  double max_late_us = ReadNumber(options, "maxLateUs", 200);
+  double spin_us = ReadNumber(options, "spinUs", 100);
+  if (width_us <= 0 || max_delay_us < 0 || max_late_us < 0 || spin_us < 0) {
+    Napi::RangeError::New(env, "Invalid one-shot timing: expected widthUs > 0 and maxDelayUs, maxLateUs, spinUs >= 0").ThrowAsJavaScriptException();
+    return;
+  }
+  width_ns_ = static_cast<uint64_t>(width_us * 1e3);
+  max_delay_ns_ = static_cast<uint64_t>(max_delay_us * 1e3);
+  max_late_ns_ = static_cast<uint64_t>(max_late_us * 1e3);
+  spin_ns_ = static_cast<uint64_t>(spin_us * 1e3);
+}
+
+DelayedOneShot::~DelayedOneShot() {
+  StopPulsing();
+}
+
+void DelayedOneShot::OnEvents(const std::vector<EdgeRecord>& edges) {
+  for (const EdgeRecord& edge : edges) {
+    if (edge.offset != trigger_ || !(edge.rising ? on_rising_ : on_falling_)) {
+      continue;
+    }
+
+    int64_t delay = delay_ns_.load(std::memory_order_relaxed);
+    uint64_t target = edge.timestamp_ns + static_cast<uint64_t>(std::max<int64_t>(delay, 0));
+    bool late = MonotonicNowNs() > target + max_late_ns_;
+
+    {
+      std::lock_guard<std::mutex> lock(stats_mutex_);
+      triggers_++;
+      if (last_trigger_ns_ != 0 && edge.timestamp_ns > last_trigger_ns_) {
+        period_ns_ = edge.timestamp_ns - last_trigger_ns_;
+      }
+      last_trigger_ns_ = edge.timestamp_ns;
+      // A pulse that cannot start in time would fire at the wrong phase
+      if (delay >= 0 && late) {
+        missed_++;
+      }
+    }
+
+    if (delay >= 0 && !late) {
+      Fire(target);
+    }
+  }
+}
+
+void DelayedOneShot::Fire(uint64_t target_ns) {
+  // Fetched for each edge, so no pulse starts or ends on released lines
+  PreciseSleepUntilNs(target_ns, spin_ns_);
+  uint64_t start;
+  {
+    std::lock_guard<std::mutex> lock(owner_->BusMutex());
+    std::shared_ptr<gpiod::line_request> request = owner_->ActiveRequest();
+    start = MonotonicNowNs();
+    request->set_value(output_, gpiod::line::value::ACTIVE);
+  }
+
+  PreciseSleepUntilNs(start + width_ns_, spin_ns_);
+  {
+    std::lock_guard<std::mutex> lock(owner_->BusMutex());
+    owner_->ActiveRequest()->set_value(output_, gpiod::line::value::INACTIVE);
+  }
+  owner_->InvalidateShadow();
+
+  uint64_t jitter = start > target_ns ? start - target_ns : 0;
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  pulses_++;
+  max_jitter_ns_ = std::max(max_jitter_ns_, jitter);
+  total_jitter_ns_ += jitter;
+}
+
+void DelayedOneShot::OutputLow() {
+  std::lock_guard<std::mutex> lock(owner_->BusMutex());
+
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!request) {
+    return;
+  }
+  request->set_value(output_, gpiod::line::value::INACTIVE);
+  owner_->InvalidateShadow();
+}
+
+Napi::Value DelayedOneShot::SetDelay(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !(info[0].IsNumber() || info[0].IsNull())) {
+    Napi::TypeError::New(env, "Delay number or null expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // null stops the pulses, delays are clamped to maxDelayUs
+  if (info[0].IsNull()) {
+    delay_ns_.store(-1, std::memory_order_relaxed);
+    return env.Null();
+  }
+  double delay_us = info[0].As<Napi::Number>().DoubleValue();
+  int64_t delay_ns = static_cast<int64_t>(std::min<double>(std::max<double>(delay_us * 1e3, 0), max_delay_ns_));
+  delay_ns_.store(delay_ns, std::memory_order_relaxed);
+
+  return Napi::Number::New(env, delay_ns / 1e3);
+}
+
+Napi::Value DelayedOneShot::GetDelay(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  int64_t delay_ns = delay_ns_.load(std::memory_order_relaxed);
+  return delay_ns < 0 ? env.Null() : Napi::Number::New(env, delay_ns / 1e3);
+}
+
+Napi::Value DelayedOneShot::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!request) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  StopPulsing();
+
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    triggers_ = 0;
+    pulses_ = 0;
+    missed_ = 0;
+    max_jitter_ns_ = 0;
+    total_jitter_ns_ = 0;
+    last_trigger_ns_ = 0;
+    period_ns_ = 0;
+    error_.clear();
+  }
+
+  if (!owner_->ClaimEdgeEvents(env, this, "DelayedOneShot")) {
+    return env.Undefined();
+  }
+
+  reader_ = std::make_unique<EdgeReader>(
+    request,
+    [this](const std::vector<EdgeRecord>& edges) { OnEvents(edges); },
+    [this](const std::string& error) {
+      std::lock_guard<std::mutex> lock(stats_mutex_);
+      error_ = error;
+    }
+  );
+
+  std::string error = reader_->Start();
+  if (!error.empty()) {
+    StopPulsing();
+    Napi::Error::New(env, "Failed to start one-shot thread: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value DelayedOneShot::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  StopPulsing();
+
+  try {
+    OutputLow();
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to stop one-shot pulses: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+void DelayedOneShot::StopPulsing() {
+  if (reader_) {
+    reader_->Stop();
+    reader_.reset();
+  }
+
+  if (owner_) {
+    owner_->ReleaseEdgeEvents(this);
+  }
+}
+
+Napi::Value DelayedOneShot::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("running", Napi::Boolean::New(env, reader_ && reader_->IsRunning()));
+
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  result.Set("triggers", Napi::Number::New(env, static_cast<double>(triggers_)));
+  result.Set("pulses", Napi::Number::New(env, static_cast<double>(pulses_)));
+  result.Set("missed", Napi::Number::New(env, static_cast<double>(missed_)));
+  result.Set("maxJitterNs", Napi::Number::New(env, static_cast<double>(max_jitter_ns_)));
+  result.Set("meanJitterNs", Napi::Number::New(env, pulses_ > 0 ? static_cast<double>(total_jitter_ns_ / pulses_) : 0));
+  result.Set("periodNs", Napi::Number::New(env, static_cast<double>(period_ns_)));
+  result.Set("error", error_.empty() ? env.Null() : Napi::String::New(env, error_));
+
+  return result;
+}
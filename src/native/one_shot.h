@@ -0,0 +1,69 @@
+#ifndef ONE_SHOT_H
+#define ONE_SHOT_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+#include "edge_reader.h"
+
+// Delayed one-shot: every trigger edge (e.g. a mains zero-cross) schedules an
+// output pulse at a delay from the kernel timestamp of the edge. The pulse is
+// timed with absolute sleeps on the edge reader thread; JavaScript only
+// changes the delay, as a lock-free store picked up by the next trigger.
+class DelayedOneShot : public Napi::ObjectWrap<DelayedOneShot> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  DelayedOneShot(const Napi::CallbackInfo& info);
+  ~DelayedOneShot();
+
+  // Wrapped methods
+  Napi::Value SetDelay(const Napi::CallbackInfo& info);
+  Napi::Value GetDelay(const Napi::CallbackInfo& info);
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  unsigned int trigger_;
+  unsigned int output_;
+  bool on_rising_;
+  bool on_falling_;
+  uint64_t width_ns_;
+  uint64_t max_delay_ns_;
+  uint64_t max_late_ns_;
+  uint64_t spin_ns_;
+
+  // Delay in ns, -1 for no pulses
+  std::atomic<int64_t> delay_ns_;
+
+  std::unique_ptr<EdgeReader> reader_;
+
+  std::mutex stats_mutex_;
+  uint64_t triggers_;
+  uint64_t pulses_;
+  uint64_t missed_;
+  uint64_t max_jitter_ns_;
+  uint64_t total_jitter_ns_;
+  uint64_t last_trigger_ns_;
+  uint64_t period_ns_;
+  std::string error_;
+
+  // Internal methods, OnEvents is called from the reader thread
+  void OnEvents(const std::vector<EdgeRecord>& edges);
+  void Fire(uint64_t target_ns);
+  void StopPulsing();
+  void OutputLow();
+};
+
+#endif // ONE_SHOT_H
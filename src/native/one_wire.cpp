@@ -0,0 +1,229 @@
+#include "one_wire.h"
+#include "timing.h"
+#include "engine_utils.h"
+#include <mutex>
+#include <stdexcept>
+
+Napi::FunctionReference OneWireBus::constructor;
+
+namespace {
+
+// Standard speed slot timing in nanoseconds
+const uint64_t kResetLowNs = 480000;
+const uint64_t kPresenceSampleNs = 70000;
+const uint64_t kResetRecoveryNs = 480000;
+const uint64_t kWriteOneLowNs = 6000;
+const uint64_t kWriteZeroLowNs = 60000;
+const uint64_t kReadLowNs = 6000;
+const uint64_t kReadSampleNs = 15000;
+const uint64_t kSlotNs = 70000;
+
+} // namespace
+
+Napi::Object OneWireBus::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "OneWireBus", {
+    InstanceMethod("reset", &OneWireBus::Reset),
+    InstanceMethod("transfer", &OneWireBus::Transfer),
+    InstanceMethod("getStats", &OneWireBus::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("OneWireBus", func);
+  return exports;
+}
+
+OneWireBus::OneWireBus(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<OneWireBus>(info), owner_(nullptr), line_(0), pull_up_(true), drive_low_(nullptr),
+    release_(nullptr), resets_(0), no_presence_(0), bytes_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  int line = -1;
+  if (!ReadLineOffset(env, options, "line", owner_->GetOffsets(), true, line)) {
+    return;
+  }
+  line_ = static_cast<unsigned int>(line);
+  pull_up_ = ReadBoolean(options, "pullUp", true);
+}
+
+OneWireBus::~OneWireBus() {
+}
+
+// Slots are timed from the return of the reconfigure that pulls the line
+// low, so the ioctl latency only stretches the low time of the slot
+
+bool OneWireBus::ResetPulse() {
+  request_->reconfigure_lines(*drive_low_);
+  uint64_t start = MonotonicNowNs();
+  PreciseSleepUntilNs(start + kResetLowNs);
+  request_->reconfigure_lines(*release_);
+
+  uint64_t released = MonotonicNowNs();
+  PreciseSleepUntilNs(released + kPresenceSampleNs);
+  bool presence = request_->get_value(line_) == gpiod::line::value::INACTIVE;
+  SleepUntilNs(released + kResetRecoveryNs);
+
+  resets_++;
+  if (!presence) {
+    no_presence_++;
+  }
+  return presence;
+}
+
+void OneWireBus::WriteBit(bool bit) {
+  request_->reconfigure_lines(*drive_low_);
+  uint64_t start = MonotonicNowNs();
+  PreciseSleepUntilNs(start + (bit ? kWriteOneLowNs : kWriteZeroLowNs));
+  request_->reconfigure_lines(*release_);
+  PreciseSleepUntilNs(start + kSlotNs);
+}
+
+bool OneWireBus::ReadBit() {
+  request_->reconfigure_lines(*drive_low_);
+  uint64_t start = MonotonicNowNs();
+  PreciseSleepUntilNs(start + kReadLowNs);
+  request_->reconfigure_lines(*release_);
+  PreciseSleepUntilNs(start + kReadSampleNs);
+  bool bit = request_->get_value(line_) == gpiod::line::value::ACTIVE;
+  PreciseSleepUntilNs(start + kSlotNs);
+  return bit;
+}
+
+bool OneWireBus::Transaction(const SingleWireConfigs& configs, bool reset, const std::vector<uint8_t>& tx, size_t rx_len,
+                             std::vector<uint8_t>& rx) {
+  std::lock_guard<std::mutex> lock(owner_->BusMutex());
+
+  request_ = owner_->GetRequest();
+  if (!request_) {
+    throw std::runtime_error("line request is not active");
+  }
+  drive_low_ = &configs.drive_low;
+  release_ = &configs.release;
+
+  try {
+    bool presence = Slots(reset, tx, rx_len, rx);
+    request_.reset();
+    return presence;
+  } catch (...) {
+    request_.reset();
+    throw;
+  }
+}
+
+bool OneWireBus::Slots(bool reset, const std::vector<uint8_t>& tx, size_t rx_len, std::vector<uint8_t>& rx) {
+  if (reset && !ResetPulse()) {
+    return false;
+  }
+
+  // Bytes go LSB first
+  for (uint8_t byte : tx) {
+    for (int bit = 0; bit < 8; bit++) {
+      WriteBit(((byte >> bit) & 1) != 0);
+    }
+  }
+
+  rx.assign(rx_len, 0);
+  for (size_t i = 0; i < rx_len; i++) {
+    for (int bit = 0; bit < 8; bit++) {
+      if (ReadBit()) {
+        rx[i] = static_cast<uint8_t>(rx[i] | (1u << bit));
+      }
+    }
+  }
+
+  bytes_ += tx.size() + rx_len;
+  return true;
+}
+
+Napi::Value OneWireBus::Queue(Napi::Env env, const Napi::CallbackInfo& info, bool reset, std::vector<uint8_t> tx,
+                              size_t rx_len) {
+  if (!owner_->GetRequest()) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto configs = std::make_shared<SingleWireConfigs>(BuildSingleWireConfigs(owner_, line_, pull_up_, false));
+  auto rx = std::make_shared<std::vector<uint8_t>>();
+  auto presence = std::make_shared<bool>(false);
+  bool reset_only = reset && tx.empty() && rx_len == 0;
+
+  PromiseWorker* worker = new PromiseWorker(env, "GPIO 1-Wire Transaction", info.This().As<Napi::Object>(), owner_,
+    [this, configs, reset, tx, rx_len, rx, presence, reset_only]() {
+      try {
+        *presence = Transaction(*configs, reset, tx, rx_len, *rx);
+      } catch (const std::exception& e) {
+        throw std::runtime_error("1-Wire transaction failed: " + std::string(e.what()));
+      }
+      if (!*presence && !reset_only) {
+        throw std::runtime_error("1-Wire transaction failed: no device present");
+      }
+    },
+    [rx, presence, reset_only](Napi::Env env) -> Napi::Value {
+      if (reset_only) {
+        return Napi::Boolean::New(env, *presence);
+      }
+      return Napi::Buffer<uint8_t>::Copy(env, rx->data(), rx->size());
+    }
+  );
+  Napi::Promise promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value OneWireBus::Reset(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  return Queue(env, info, true, {}, 0);
+}
+
+Napi::Value OneWireBus::Transfer(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsTypedArray() ||
+      info[0].As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array || !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Uint8Array and receive length expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Uint8Array data = info[0].As<Napi::Uint8Array>();
+  std::vector<uint8_t> tx(data.Data(), data.Data() + data.ElementLength());
+  int64_t rx_len = info[1].As<Napi::Number>().Int64Value();
+  if (rx_len < 0 || (tx.empty() && rx_len == 0)) {
+    Napi::RangeError::New(env, "Nothing to transfer").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  bool reset = info.Length() < 3 || !info[2].IsBoolean() || info[2].As<Napi::Boolean>().Value();
+
+  return Queue(env, info, reset, std::move(tx), static_cast<size_t>(rx_len));
+}
+
+Napi::Value OneWireBus::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("resets", Napi::Number::New(env, static_cast<double>(resets_.load())));
+  result.Set("noPresence", Napi::Number::New(env, static_cast<double>(no_presence_.load())));
+  result.Set("bytes", Napi::Number::New(env, static_cast<double>(bytes_.load())));
+
+  return result;
+}
@@ -0,0 +1,57 @@
+#ifndef ONE_WIRE_H
+#define ONE_WIRE_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+
+struct SingleWireConfigs;
+
+// 1-Wire bus master (DS18B20 and similar). The data line is switched between
+// driving low and released to the external pull-up with fast reconfigure, so
+// the line can be read back on any GPIO chip, even one without open-drain
+// output support.
+class OneWireBus : public Napi::ObjectWrap<OneWireBus> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  OneWireBus(const Napi::CallbackInfo& info);
+  ~OneWireBus();
+
+  // Wrapped methods
+  Napi::Value Reset(const Napi::CallbackInfo& info);
+  Napi::Value Transfer(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  unsigned int line_;
+  bool pull_up_;
+
+  // Only used by the transaction running on the worker thread
+  std::shared_ptr<gpiod::line_request> request_;
+  const gpiod::line_config* drive_low_;
+  const gpiod::line_config* release_;
+
+  std::atomic<uint64_t> resets_;
+  std::atomic<uint64_t> no_presence_;
+  std::atomic<uint64_t> bytes_;
+
+  // Internal methods, called from the worker thread
+  bool Transaction(const SingleWireConfigs& configs, bool reset, const std::vector<uint8_t>& tx, size_t rx_len,
+                   std::vector<uint8_t>& rx);
+  bool Slots(bool reset, const std::vector<uint8_t>& tx, size_t rx_len, std::vector<uint8_t>& rx);
+  bool ResetPulse();
+  void WriteBit(bool bit);
+  bool ReadBit();
+  Napi::Value Queue(Napi::Env env, const Napi::CallbackInfo& info, bool reset, std::vector<uint8_t> tx, size_t rx_len);
+};
+
+#endif // ONE_WIRE_H
@@ -0,0 +1,112 @@
+#include "periodic_task.h"
+#include "thread_options.h"
+#include "timing.h"
+
+PeriodicTask::PeriodicTask()
+  : running_(false), period_ns_(0), spin_ns_(0), ticks_(0), missed_(0), max_lateness_ns_(0), total_lateness_ns_(0) {
+}
+
+PeriodicTask::~PeriodicTask() {
+  Stop();
+}
+
+std::string PeriodicTask::Start(uint64_t period_ns, Tick tick, uint64_t spin_ns) {
+  Stop();
+
+  tick_ = tick;
+  period_ns_ = period_ns;
+  spin_ns_ = spin_ns;
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    ticks_ = 0;
+    missed_ = 0;
+    max_lateness_ns_ = 0;
+    total_lateness_ns_ = 0;
+  }
+
+  running_ = true;
+  thread_ = std::thread(&PeriodicTask::Run, this);
+
+  std::string error = ApplyThreadOptions(thread_);
+  if (!error.empty()) {
+    Stop();
+  }
+  return error;
+}
+
+void PeriodicTask::Stop() {
+  running_ = false;
+
+  if (thread_.joinable() && thread_.get_id() != std::this_thread::get_id()) {
+    thread_.join();
+  }
+}
+
+bool PeriodicTask::IsRunning() const {
+  return running_;
+}
+
+void PeriodicTask::SetPeriod(uint64_t period_ns) {
+  period_ns_ = period_ns;
+}
+
+uint64_t PeriodicTask::GetPeriod() const {
+  return period_ns_;
+}
+
+PeriodicTask::Stats PeriodicTask::GetStats() const {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+
+  Stats stats;
+  stats.ticks = ticks_;
+  stats.missed = missed_;
+  stats.max_lateness_ns = max_lateness_ns_;
+  stats.mean_lateness_ns = ticks_ > 0 ? total_lateness_ns_ / ticks_ : 0;
+  return stats;
+}
+
+void PeriodicTask::Run() {
+  uint64_t deadline = MonotonicNowNs();
+
+  while (running_) {
+    if (spin_ns_ > 0) {
+      PreciseSleepUntilNs(deadline, spin_ns_);
+    } else {
+      SleepUntilNs(deadline);
+    }
+    if (!running_) {
+      break;
+    }
+
+    uint64_t now = MonotonicNowNs();
+    uint64_t lateness = now > deadline ? now - deadline : 0;
+
+    bool keep_running = tick_();
+
+    uint64_t period = period_ns_;
+    uint64_t skipped = 0;
+    deadline += period;
+
+    // Skip deadlines that already passed rather than running late ticks
+    // back to back
+    now = MonotonicNowNs();
+    if (now > deadline && period > 0) {
+      skipped = (now - deadline) / period + 1;
+      deadline += skipped * period;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(stats_mutex_);
+      ticks_++;
+      missed_ += skipped;
+      total_lateness_ns_ += lateness;
+      if (lateness > max_lateness_ns_) {
+        max_lateness_ns_ = lateness;
+      }
+    }
+
+    if (!keep_running) {
+      running_ = false;
+    }
+  }
+}
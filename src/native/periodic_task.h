@@ -0,0 +1,57 @@
+#ifndef PERIODIC_TASK_H
+#define PERIODIC_TASK_H
+
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <functional>
+#include <string>
+#include <cstdint>
+
+// Background thread running a tick at a fixed rate. Ticks are scheduled on
+// absolute CLOCK_MONOTONIC deadlines so the period does not drift with the
+// tick duration; ticks that are too late are dropped instead of bunched up.
+class PeriodicTask {
+public:
+  // Returns false to end the task
+  using Tick = std::function<bool()>;
+
+  struct Stats {
+    uint64_t ticks;
+    uint64_t missed;
+    uint64_t max_lateness_ns;
+    uint64_t mean_lateness_ns;
+  };
+
+  PeriodicTask();
+  ~PeriodicTask();
+
+  // Returns an error message if the thread options could not be applied.
+  // The last spin_ns before each deadline are busy-waited for lower jitter.
+  std::string Start(uint64_t period_ns, Tick tick, uint64_t spin_ns = 0);
+  void Stop();
+  bool IsRunning() const;
+
+  // Takes effect from the next deadline on
+  void SetPeriod(uint64_t period_ns);
+  uint64_t GetPeriod() const;
+
+  Stats GetStats() const;
+
+private:
+  Tick tick_;
+  std::thread thread_;
+  std::atomic<bool> running_;
+  std::atomic<uint64_t> period_ns_;
+  uint64_t spin_ns_;
+
+  mutable std::mutex stats_mutex_;
+  uint64_t ticks_;
+  uint64_t missed_;
+  uint64_t max_lateness_ns_;
+  uint64_t total_lateness_ns_;
+
+  void Run();
+};
+
+#endif // PERIODIC_TASK_H
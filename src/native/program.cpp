@@ -0,0 +1,324 @@
+#include "program.h"
+#include "timing.h"
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <stdexcept>
+
+namespace {
+
+// Number of operand words following each opcode
+int OperandCount(uint32_t opcode) {
+  switch (opcode) {
+    case OP_END:
+    case OP_ENDLOOP:
+      return 0;
+    case OP_READ:
+    case OP_DELAY:
+    case OP_LOOP:
+      return 1;
+    case OP_SET:
+      return 2;
+    case OP_WAIT_EDGE:
+      return 3;
+    default:
+      return -1;
+  }
+}
+
+uint64_t SaturatingAdd(uint64_t a, uint64_t b) {
+  return a > UINT64_MAX - b ? UINT64_MAX : a + b;
+}
+
+uint64_t SaturatingMultiply(uint64_t a, uint64_t b) {
+  return b != 0 && a > UINT64_MAX / b ? UINT64_MAX : a * b;
+}
+
+// Released requests are noticed at least this often while a program waits
+const uint64_t kCancelPollNs = 10000000;
+
+} // namespace
+
+std::string ValidateProgram(const std::vector<uint32_t>& code, size_t num_lines, size_t& slots, bool& waits_edges) {
+  uint32_t line_mask = num_lines >= 32 ? 0xffffffffu : ((1u << num_lines) - 1);
+  size_t depth = 0;
+  slots = 0;
+
+  // Repetitions of the current block, and the cost of a run with loops
+  // unrolled
+  std::vector<uint64_t> repeats = {1};
+  uint64_t steps = 0;
+  uint64_t duration_ns = 0;
+
+  if (num_lines > 32) {
+    return "Programs support requests with at most 32 lines";
+  }
+
+  size_t pc = 0;
+  while (pc < code.size()) {
+    uint32_t opcode = code[pc];
+    int operands = OperandCount(opcode);
+    if (operands < 0) {
+      return "Invalid opcode " + std::to_string(opcode) + " at word " + std::to_string(pc);
+    }
+    if (pc + operands >= code.size()) {
+      return "Truncated instruction at word " + std::to_string(pc);
+    }
+
+    const uint32_t* args = code.data() + pc + 1;
+    steps = SaturatingAdd(steps, repeats.back());
+    switch (opcode) {
+      case OP_SET:
+        if (args[0] & ~line_mask) {
+          return "SET mask selects lines outside the request at word " + std::to_string(pc);
+        }
+        break;
+      case OP_DELAY:
+        duration_ns = SaturatingAdd(duration_ns, SaturatingMultiply(repeats.back(), args[0]));
+        break;
+      case OP_READ:
+        if (args[0] >= kMaxProgramSlots) {
+          return "Slot index out of range at word " + std::to_string(pc);
+        }
+        slots = std::max(slots, static_cast<size_t>(args[0]) + 1);
+        break;
+      case OP_WAIT_EDGE:
+        if (args[0] == 0 || (args[0] & ~line_mask)) {
+          return "WAIT_EDGE mask must select lines of the request at word " + std::to_string(pc);
+        }
+        if (args[2] >= kMaxProgramSlots) {
+          return "Slot index out of range at word " + std::to_string(pc);
+        }
+        slots = std::max(slots, static_cast<size_t>(args[2]) + 1);
+        waits_edges = true;
+        duration_ns = SaturatingAdd(duration_ns, SaturatingMultiply(repeats.back(), args[1]));
+        break;
+      case OP_LOOP:
+        if (args[0] == 0) {
+          return "LOOP count must be positive at word " + std::to_string(pc);
+        }
+        if (++depth > kMaxProgramLoopDepth) {
+          return "Loops nested too deeply at word " + std::to_string(pc);
+        }
+        repeats.push_back(SaturatingMultiply(repeats.back(), args[0]));
+        break;
+      case OP_ENDLOOP:
+        if (depth == 0) {
+          return "ENDLOOP without LOOP at word " + std::to_string(pc);
+        }
+        depth--;
+        repeats.pop_back();
+        break;
+      default:
+        break;
+    }
+
+    if (opcode == OP_END) {
+      break;
+    }
+    pc += 1 + operands;
+  }
+
+  if (depth != 0) {
+    return "LOOP without ENDLOOP";
+  }
+  if (steps > kMaxProgramSteps) {
+    return "Program runs more than " + std::to_string(kMaxProgramSteps) + " instructions";
+  }
+  if (duration_ns > kMaxProgramDurationNs) {
+    return "Program delays and edge timeouts exceed " + std::to_string(kMaxProgramDurationNs / 1000000000ULL) + " s";
+  }
+
+  return "";
+}
+
+ProgramWorker::ProgramWorker(Napi::Env env, LineRequest* owner, Napi::Object owner_obj, std::vector<uint32_t> code, size_t slots,
+                             bool waits_edges)
+  : Napi::AsyncWorker(env, "GPIO Program"), deferred_(Napi::Promise::Deferred::New(env)), owner_(owner),
+    offsets_(owner->GetOffsets()), code_(code), results_(slots, 0),
+    waits_edges_(waits_edges) {
+  // Keep the request object alive while the program runs
+  owner_ref_ = Napi::Persistent(owner_obj);
+}
+
+Napi::Promise ProgramWorker::GetPromise() const {
+  return deferred_.Promise();
+}
+
+void ProgramWorker::Execute() {
+  struct Loop {
+    size_t start;
+    uint32_t remaining;
+  };
+
+  std::unique_lock<std::mutex> lock(owner_->BusMutex(), std::defer_lock);
+  size_t pc = 0;
+
+  try {
+    Acquire(lock);
+
+    // Edges that happened before the program started are not of interest.
+    // Programs without WAIT_EDGE leave them to the current edge consumer.
+    if (waits_edges_) {
+      ::gpiod::edge_event_buffer buffer(64);
+      while (request_->wait_edge_events(std::chrono::nanoseconds(0))) {
+        request_->read_edge_events(buffer);
+      }
+    }
+
+    std::vector<Loop> loops;
+    gpiod::line::value_mappings mappings;
+    mappings.reserve(offsets_.size());
+
+    while (pc < code_.size()) {
+      if (owner_->IsReleased()) {
+        throw std::runtime_error("line request was released");
+      }
+
+      uint32_t opcode = code_[pc];
+      const uint32_t* args = code_.data() + pc + 1;
+      size_t next = pc + 1 + OperandCount(opcode);
+
+      switch (opcode) {
+        case OP_END:
+          return;
+        case OP_SET:
+          mappings.clear();
+          for (size_t i = 0; i < offsets_.size(); i++) {
+            if (args[0] & (1u << i)) {
+              mappings.emplace_back(offsets_[i], (args[1] & (1u << i)) ? gpiod::line::value::ACTIVE : gpiod::line::value::INACTIVE);
+            }
+          }
+          if (!mappings.empty()) {
+            request_->set_values(mappings);
+          }
+          break;
+        case OP_READ: {
+          gpiod::line::values values = request_->get_values();
+          uint32_t bits = 0;
+          for (size_t i = 0; i < values.size(); i++) {
+            if (values[i] == gpiod::line::value::ACTIVE) {
+              bits |= 1u << i;
+            }
+          }
+          results_[args[0]] = bits;
+          break;
+        }
+        case OP_DELAY:
+          Delay(lock, args[0]);
+          break;
+        case OP_WAIT_EDGE:
+          WaitEdge(lock, args[0], args[1], results_[args[2]]);
+          break;
+        case OP_LOOP:
+          loops.push_back({next, args[0]});
+          break;
+        case OP_ENDLOOP:
+          if (--loops.back().remaining > 0) {
+            next = loops.back().start;
+          } else {
+            loops.pop_back();
+          }
+          break;
+      }
+
+      pc = next;
+    }
+  } catch (const std::exception& e) {
+    SetError("Program failed at word " + std::to_string(pc) + ": " + std::string(e.what()));
+  }
+}
+
+void ProgramWorker::Acquire(std::unique_lock<std::mutex>& lock) {
+  lock.lock();
+  request_ = owner_->GetRequest();
+  if (!request_) {
+    throw std::runtime_error("line request was released");
+  }
+}
+
+void ProgramWorker::Delay(std::unique_lock<std::mutex>& lock, uint32_t ns) {
+  uint64_t deadline = MonotonicNowNs() + ns;
+  if (ns < kProgramYieldNs) {
+    PreciseSleepUntilNs(deadline);
+    return;
+  }
+
+  lock.unlock();
+  request_.reset();
+  while (!owner_->IsReleased() && MonotonicNowNs() + kCancelPollNs < deadline) {
+    SleepUntilNs(MonotonicNowNs() + kCancelPollNs);
+  }
+  if (!owner_->IsReleased()) {
+    PreciseSleepUntilNs(deadline);
+  }
+  Acquire(lock);
+}
+
+void ProgramWorker::WaitEdge(std::unique_lock<std::mutex>& lock, uint32_t mask, uint32_t timeout_ns, uint32_t& result) {
+  ::gpiod::edge_event_buffer buffer(1);
+  uint64_t deadline = MonotonicNowNs() + timeout_ns;
+
+  // The edge claim keeps other readers away while the bus is let go
+  bool yield = timeout_ns >= kProgramYieldNs;
+  if (yield) {
+    lock.unlock();
+  }
+
+  std::map<unsigned int, uint32_t> index;
+  for (size_t i = 0; i < offsets_.size(); i++) {
+    index[offsets_[i]] = static_cast<uint32_t>(i);
+  }
+
+  result = 0;
+  while (!owner_->IsReleased()) {
+    uint64_t now = MonotonicNowNs();
+    if (now >= deadline) {
+      break;
+    }
+
+    uint64_t wait = std::min(deadline - now, kCancelPollNs);
+    if (!request_->wait_edge_events(std::chrono::nanoseconds(wait))) {
+      continue;
+    }
+
+    // Read one event at a time so later WAIT_EDGE instructions see the rest
+    request_->read_edge_events(buffer, 1);
+    const ::gpiod::edge_event& event = buffer.get_event(0);
+    auto it = index.find(event.line_offset());
+    if (it != index.end() && (mask & (1u << it->second))) {
+      result = (it->second + 1) | (event.type() == ::gpiod::edge_event::event_type::RISING_EDGE ? 0x80000000u : 0);
+      break;
+    }
+  }
+
+  if (yield) {
+    request_.reset();
+    Acquire(lock);
+  }
+}
+
+void ProgramWorker::OnOK() {
+  Napi::Env env = Env();
+  Napi::HandleScope scope(env);
+
+  // The program drove the lines behind the output shadow
+  owner_->InvalidateShadow();
+  owner_->ReleaseEdgeEvents(this);
+
+  Napi::Uint32Array result = Napi::Uint32Array::New(env, results_.size());
+  for (size_t i = 0; i < results_.size(); i++) {
+    result[i] = results_[i];
+  }
+  deferred_.Resolve(result);
+}
+
+void ProgramWorker::OnError(const Napi::Error& error) {
+  Napi::Env env = Env();
+  Napi::HandleScope scope(env);
+
+  owner_->InvalidateShadow();
+  owner_->ReleaseEdgeEvents(this);
+  deferred_.Reject(error.Value());
+}
@@ -0,0 +1,70 @@
+#ifndef PROGRAM_H
+#define PROGRAM_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+
+// GPIO micro-programs are sequences of 32-bit words. Masks select lines by
+// their index in the request offsets, so programs cover up to 32 lines.
+enum ProgramOpcode : uint32_t {
+  OP_END = 0x00,        // END
+  OP_SET = 0x01,        // SET mask bits: write the masked lines with one set_values
+  OP_READ = 0x02,       // READ slot: store all line values as a bitmask in slot
+  OP_DELAY = 0x03,      // DELAY ns: sleep for ns nanoseconds
+  OP_WAIT_EDGE = 0x04,  // WAIT_EDGE mask timeout_ns slot: store (index + 1) | rising << 31, or 0 on timeout
+  OP_LOOP = 0x05,       // LOOP count: repeat the block up to the matching ENDLOOP count times
+  OP_ENDLOOP = 0x06     // ENDLOOP
+};
+
+const size_t kMaxProgramSlots = 256;
+const size_t kMaxProgramLoopDepth = 8;
+
+// Bounds on a whole run, with loops unrolled: executed instructions and the
+// sum of DELAY times and WAIT_EDGE timeouts
+const uint64_t kMaxProgramSteps = 1ULL << 26;
+const uint64_t kMaxProgramDurationNs = 60000000000ULL;
+
+// DELAY and WAIT_EDGE instructions at least this long let go of the bus;
+// shorter ones keep it so bit sequences are not interleaved with other writes
+const uint64_t kProgramYieldNs = 1000000;
+
+// Checks a program against the number of requested lines; returns an error
+// message or an empty string, the number of result slots it writes and
+// whether it waits for edges
+std::string ValidateProgram(const std::vector<uint32_t>& code, size_t num_lines, size_t& slots, bool& waits_edges);
+
+// Runs a program on a worker thread and resolves with the result slots
+class ProgramWorker : public Napi::AsyncWorker {
+public:
+  ProgramWorker(Napi::Env env, LineRequest* owner, Napi::Object owner_obj, std::vector<uint32_t> code, size_t slots,
+                bool waits_edges);
+
+  Napi::Promise GetPromise() const;
+
+protected:
+  void Execute() override;
+  void OnOK() override;
+  void OnError(const Napi::Error& error) override;
+
+private:
+  Napi::Promise::Deferred deferred_;
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+  // Fetched under the bus lock whenever the program (re)acquires it
+  std::shared_ptr<gpiod::line_request> request_;
+  std::vector<unsigned int> offsets_;
+  std::vector<uint32_t> code_;
+  std::vector<uint32_t> results_;
+  bool waits_edges_;
+
+  void Acquire(std::unique_lock<std::mutex>& lock);
+  void Delay(std::unique_lock<std::mutex>& lock, uint32_t ns);
+  void WaitEdge(std::unique_lock<std::mutex>& lock, uint32_t mask, uint32_t timeout_ns, uint32_t& result);
+};
+
+#endif // PROGRAM_H
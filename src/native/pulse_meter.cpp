@@ -0,0 +1,252 @@
+#include "pulse_meter.h"
+#include "timing.h"
+#include "engine_utils.h"
+#include <algorithm>
+#include <chrono>
+
+Napi::FunctionReference PulseMeter::constructor;
+
+PulseMeasurement MeasurePulse(LineRequest* owner, gpiod::edge_event_buffer& buffer, unsigned int trigger,
+                              unsigned int echo, uint64_t trigger_ns, uint64_t timeout_ns) {
+  // The bus is only held for the trigger pulse; the edge claim keeps other
+  // readers away from the echo
+  std::shared_ptr<gpiod::line_request> request;
+  {
+    std::lock_guard<std::mutex> lock(owner->BusMutex());
+    request = owner->ActiveRequest();
+
+    // Only edges caused by this trigger count
+    DrainEdgeEvents(*request, buffer);
+
+    request->set_value(trigger, gpiod::line::value::ACTIVE);
+    PreciseSleepUntilNs(MonotonicNowNs() + trigger_ns);
+    request->set_value(trigger, gpiod::line::value::INACTIVE);
+  }
+
+  uint64_t deadline = MonotonicNowNs() + timeout_ns;
+  bool started = false;
+  PulseMeasurement result = {0, 0};
+
+  while (true) {
+    uint64_t now = MonotonicNowNs();
+    if (now >= deadline || !request->wait_edge_events(std::chrono::nanoseconds(deadline - now))) {
+      throw PulseTimeout(started ? "echo did not end in time" : "no echo in time");
+    }
+
+    size_t count = request->read_edge_events(buffer);
+    for (size_t i = 0; i < count; i++) {
+      const gpiod::edge_event& event = buffer.get_event(i);
+      if (event.line_offset() != echo) {
+        continue;
+      }
+
+      bool rising = event.type() == gpiod::edge_event::event_type::RISING_EDGE;
+      if (rising && !started) {
+        started = true;
+        result.rising_ns = event.timestamp_ns().ns();
+      } else if (!rising && started) {
+        result.falling_ns = event.timestamp_ns().ns();
+        return result;
+      }
+    }
+  }
+}
+
+bool ReadPulseOptions(Napi::Env env, LineRequest* owner, Napi::Value trigger, Napi::Value echo, Napi::Value options,
+                      unsigned int& trigger_offset, unsigned int& echo_offset, uint64_t& trigger_ns, uint64_t& timeout_ns) {
+  if (!trigger.IsNumber() || !echo.IsNumber()) {
+    Napi::TypeError::New(env, "Trigger and echo offsets expected").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  trigger_offset = trigger.As<Napi::Number>().Uint32Value();
+  echo_offset = echo.As<Napi::Number>().Uint32Value();
+  const std::vector<unsigned int>& offsets = owner->GetOffsets();
+  if (std::find(offsets.begin(), offsets.end(), trigger_offset) == offsets.end() ||
+      std::find(offsets.begin(), offsets.end(), echo_offset) == offsets.end()) {
+    Napi::RangeError::New(env, "Trigger and echo offsets must be part of the request").ThrowAsJavaScriptException();
+    return false;
+  }
+  if (trigger_offset == echo_offset) {
+    Napi::RangeError::New(env, "Trigger and echo must be different lines").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  double trigger_us = 10;
+  double timeout_ms = 50;
+  if (options.IsObject()) {
+    trigger_us = ReadNumber(options.As<Napi::Object>(), "triggerUs", trigger_us);
+    timeout_ms = ReadNumber(options.As<Napi::Object>(), "timeoutMs", timeout_ms);
+  }
+  if (trigger_us <= 0 || timeout_ms <= 0) {
+    Napi::RangeError::New(env, "Trigger width and timeout must be positive").ThrowAsJavaScriptException();
+    return false;
+  }
+  trigger_ns = static_cast<uint64_t>(trigger_us * 1e3);
+  timeout_ns = static_cast<uint64_t>(timeout_ms * 1e6);
+
+  return true;
+}
+
+Napi::Object PulseMeter::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "PulseMeter", {
+    InstanceMethod("start", &PulseMeter::Start),
+    InstanceMethod("stop", &PulseMeter::Stop),
+    InstanceMethod("getStats", &PulseMeter::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("PulseMeter", func);
+  return exports;
+}
+
+PulseMeter::PulseMeter(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<PulseMeter>(info), owner_(nullptr), trigger_(0), echo_(0), trigger_ns_(0), timeout_ns_(0),
+    period_ns_(0), buffer_(16), started_(false), measurements_(0), timeouts_(0), last_width_ns_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 4 || !info[0].IsObject() || !info[3].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object, trigger and echo offsets and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  if (!ReadPulseOptions(env, owner_, info[1], info[2], info[3], trigger_, echo_, trigger_ns_, timeout_ns_)) {
+    return;
+  }
+
+  double rate_hz = ReadNumber(info[3].As<Napi::Object>(), "rateHz", 10);
+  if (rate_hz <= 0) {
+    Napi::RangeError::New(env, "Measurement rate must be positive").ThrowAsJavaScriptException();
+    return;
+  }
+  period_ns_ = static_cast<uint64_t>(1e9 / rate_hz);
+  if (timeout_ns_ + trigger_ns_ >= period_ns_) {
+    Napi::RangeError::New(env, "Timeout must be shorter than the measurement period").ThrowAsJavaScriptException();
+    return;
+  }
+}
+
+PulseMeter::~PulseMeter() {
+  StopMeasuring();
+}
+
+bool PulseMeter::Tick() {
+  try {
+    PulseMeasurement result = MeasurePulse(owner_, buffer_, trigger_, echo_, trigger_ns_, timeout_ns_);
+    owner_->InvalidateShadow();
+
+    uint64_t width = result.falling_ns - result.rising_ns;
+    measurements_++;
+    last_width_ns_ = width;
+
+    tsfn_.BlockingCall([result, width](Napi::Env env, Napi::Function jsCallback) {
+      Napi::Object measurement = Napi::Object::New(env);
+      measurement.Set("widthNs", Napi::Number::New(env, static_cast<double>(width)));
+      measurement.Set("timestampNs", Napi::BigInt::New(env, result.rising_ns));
+      jsCallback.Call({env.Null(), measurement});
+    });
+  } catch (const PulseTimeout&) {
+    owner_->InvalidateShadow();
+    timeouts_++;
+
+    uint64_t now = MonotonicNowNs();
+    tsfn_.BlockingCall([now](Napi::Env env, Napi::Function jsCallback) {
+      Napi::Object measurement = Napi::Object::New(env);
+      measurement.Set("widthNs", env.Null());
+      measurement.Set("timestampNs", Napi::BigInt::New(env, now));
+      jsCallback.Call({env.Null(), measurement});
+    });
+  } catch (const std::exception& e) {
+    std::string message = e.what();
+    tsfn_.BlockingCall([message](Napi::Env env, Napi::Function jsCallback) {
+      jsCallback.Call({Napi::Error::New(env, message).Value(), env.Null()});
+    });
+    return false;
+  }
+
+  return true;
+}
+
+Napi::Value PulseMeter::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsFunction()) {
+    Napi::TypeError::New(env, "Callback function expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!owner_->GetRequest()) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  StopMeasuring();
+
+  if (!owner_->ClaimEdgeEvents(env, this, "PulseMeter")) {
+    return env.Undefined();
+  }
+
+  tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    info[0].As<Napi::Function>(),
+    "GPIO Pulse Meter Callback",
+    0,
+    1
+  );
+  started_ = true;
+
+  std::string error = task_.Start(period_ns_, [this]() { return Tick(); });
+  if (!error.empty()) {
+    StopMeasuring();
+    Napi::Error::New(env, "Failed to start measuring: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value PulseMeter::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  StopMeasuring();
+
+  return env.Undefined();
+}
+
+void PulseMeter::StopMeasuring() {
+  if (started_) {
+    started_ = false;
+    task_.Stop();
+    tsfn_.Release();
+  }
+
+  if (owner_) {
+    owner_->ReleaseEdgeEvents(this);
+  }
+}
+
+Napi::Value PulseMeter::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("measurements", Napi::Number::New(env, static_cast<double>(measurements_.load())));
+  result.Set("timeouts", Napi::Number::New(env, static_cast<double>(timeouts_.load())));
+  result.Set("lastWidthNs", Napi::Number::New(env, static_cast<double>(last_width_ns_.load())));
+  result.Set("timing", PeriodicStatsToObject(env, task_.GetStats()));
+
+  return result;
+}
@@ -0,0 +1,77 @@
+#ifndef PULSE_METER_H
+#define PULSE_METER_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <cstdint>
+#include "line_request.h"
+#include "periodic_task.h"
+
+// Kernel timestamps of the edges delimiting an echo pulse
+struct PulseMeasurement {
+  uint64_t rising_ns;
+  uint64_t falling_ns;
+};
+
+// Thrown when the echo does not start or end in time
+class PulseTimeout : public std::runtime_error {
+public:
+  explicit PulseTimeout(const std::string& message) : std::runtime_error(message) {}
+};
+
+// Emits a trigger pulse and measures the following echo pulse from the edge
+// events of the echo line. Takes the bus lock of the request; throws
+// PulseTimeout on a missing echo and other exceptions on I/O errors.
+PulseMeasurement MeasurePulse(LineRequest* owner, gpiod::edge_event_buffer& buffer, unsigned int trigger,
+                              unsigned int echo, uint64_t trigger_ns, uint64_t timeout_ns);
+
+// Repeats pulse measurements at a fixed rate
+class PulseMeter : public Napi::ObjectWrap<PulseMeter> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  PulseMeter(const Napi::CallbackInfo& info);
+  ~PulseMeter();
+
+  // Wrapped methods
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  unsigned int trigger_;
+  unsigned int echo_;
+  uint64_t trigger_ns_;
+  uint64_t timeout_ns_;
+  uint64_t period_ns_;
+
+  // Only used by the measurement thread
+  gpiod::edge_event_buffer buffer_;
+  PeriodicTask task_;
+  Napi::ThreadSafeFunction tsfn_;
+  bool started_;
+
+  std::atomic<uint64_t> measurements_;
+  std::atomic<uint64_t> timeouts_;
+  std::atomic<uint64_t> last_width_ns_;
+
+  // Internal methods
+  bool Tick();
+  void StopMeasuring();
+};
+
+// Reads the trigger/echo offsets and timing options shared by
+// LineRequest.measurePulse and PulseMeter; throws and returns false on error
+bool ReadPulseOptions(Napi::Env env, LineRequest* owner, Napi::Value trigger, Napi::Value echo, Napi::Value options,
+                      unsigned int& trigger_offset, unsigned int& echo_offset, uint64_t& trigger_ns, uint64_t& timeout_ns);
+
+#endif // PULSE_METER_H
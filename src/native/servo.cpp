@@ -0,0 +1,267 @@
+#include "servo.h"
+#include "timing.h"
+#include "engine_utils.h"
+#include <algorithm>
+
+Napi::FunctionReference ServoController::constructor;
+
+Napi::Object ServoController::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "ServoController", {
+    InstanceMethod("setPulseWidth", &ServoController::SetPulseWidth),
+    InstanceMethod("getPulseWidth", &ServoController::GetPulseWidth),
+    InstanceMethod("start", &ServoController::Start),
+    InstanceMethod("stop", &ServoController::Stop),
+    InstanceMethod("getStats", &ServoController::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("ServoController", func);
+  return exports;
+}
+
+ServoController::ServoController(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<ServoController>(info), owner_(nullptr), period_ns_(0), spin_ns_(0), min_width_ns_(0),
+    max_width_ns_(0), frames_(0), falling_edges_(0), max_jitter_ns_(0), total_jitter_ns_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  if (!ReadLineOffsets(env, options, "channels", owner_->GetOffsets(), channels_)) {
+    return;
+  }
+  if (channels_.empty()) {
+    Napi::RangeError::New(env, "At least one servo channel expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  double period_us = ReadNumber(options, "periodUs", 20000);
+  double min_us = ReadNumber(options, "minUs", 500);
+  double max_us = ReadNumber(options, "maxUs", 2500);
+  double spin_us = ReadNumber(options, "spinUs", 100);
+  if (min_us < 0 || max_us < min_us || max_us >= period_us || spin_us < 0) {
+    Napi::RangeError::New(env, "Invalid servo timing: expected 0 <= minUs <= maxUs < periodUs and spinUs >= 0").ThrowAsJavaScriptException();
+    return;
+  }
+  period_ns_ = static_cast<uint64_t>(period_us * 1e3);
+  min_width_ns_ = static_cast<uint32_t>(min_us * 1e3);
+  max_width_ns_ = static_cast<uint32_t>(max_us * 1e3);
+  spin_ns_ = static_cast<uint64_t>(spin_us * 1e3);
+
+  widths_.reset(new std::atomic<uint32_t>[channels_.size()]);
+  for (size_t i = 0; i < channels_.size(); i++) {
+    widths_[i] = 0;
+  }
+  pulses_.reserve(channels_.size());
+  edges_.reserve(channels_.size());
+}
+
+ServoController::~ServoController() {
+  task_.Stop();
+}
+
+bool ServoController::Tick() {
+  // Take one consistent set of widths for the whole frame
+  pulses_.clear();
+  for (size_t i = 0; i < channels_.size(); i++) {
+    uint32_t width = widths_[i].load(std::memory_order_relaxed);
+    if (width > 0) {
+      pulses_.push_back(Pulse{width, i});
+    }
+  }
+  if (pulses_.empty()) {
+    return true;
+  }
+  std::sort(pulses_.begin(), pulses_.end(), [](const Pulse& a, const Pulse& b) {
+    return a.width_ns < b.width_ns;
+  });
+
+  uint64_t jitter_max = 0;
+  uint64_t jitter_total = 0;
+
+  try {
+    // All rising edges with one ioctl
+    edges_.clear();
+    for (const Pulse& pulse : pulses_) {
+      edges_.emplace_back(channels_[pulse.channel], gpiod::line::value::ACTIVE);
+    }
+    uint64_t start;
+    {
+      std::lock_guard<std::mutex> lock(owner_->BusMutex());
+      std::shared_ptr<gpiod::line_request> request = owner_->ActiveRequest();
+      start = MonotonicNowNs();
+      request->set_values(edges_);
+    }
+
+    // Falling edges in order; pulses that are due by the time one is
+    // written share its ioctl
+    size_t next = 0;
+    while (next < pulses_.size()) {
+      uint64_t deadline = start + pulses_[next].width_ns;
+      PreciseSleepUntilNs(deadline, spin_ns_);
+
+      edges_.clear();
+      uint64_t now;
+      {
+        std::lock_guard<std::mutex> lock(owner_->BusMutex());
+        std::shared_ptr<gpiod::line_request> request = owner_->ActiveRequest();
+        now = MonotonicNowNs();
+        while (next < pulses_.size() && start + pulses_[next].width_ns <= now) {
+          edges_.emplace_back(channels_[pulses_[next].channel], gpiod::line::value::INACTIVE);
+          uint64_t jitter = now - (start + pulses_[next].width_ns);
+          jitter_max = std::max(jitter_max, jitter);
+          jitter_total += jitter;
+          next++;
+        }
+        request->set_values(edges_);
+      }
+    }
+  } catch (const std::exception& e) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    error_ = e.what();
+    return false;
+  }
+
+  owner_->InvalidateShadow();
+
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  frames_++;
+  falling_edges_ += pulses_.size();
+  max_jitter_ns_ = std::max(max_jitter_ns_, jitter_max);
+  total_jitter_ns_ += jitter_total;
+  return true;
+}
+
+void ServoController::AllLow() {
+  std::lock_guard<std::mutex> lock(owner_->BusMutex());
+
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!request) {
+    return;
+  }
+
+  gpiod::line::value_mappings values;
+  for (unsigned int channel : channels_) {
+    values.emplace_back(channel, gpiod::line::value::INACTIVE);
+  }
+  request->set_values(values);
+  owner_->InvalidateShadow();
+}
+
+Napi::Value ServoController::SetPulseWidth(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+    Napi::TypeError::New(env, "Channel index and pulse width expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  uint32_t channel = info[0].As<Napi::Number>().Uint32Value();
+  if (channel >= channels_.size()) {
+    Napi::RangeError::New(env, "Channel index out of range").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Width 0 switches the channel off, others are clamped to the servo range
+  double width_us = info[1].As<Napi::Number>().DoubleValue();
+  uint32_t width_ns = 0;
+  if (width_us > 0) {
+    width_ns = static_cast<uint32_t>(std::min<double>(std::max<double>(width_us * 1e3, min_width_ns_), max_width_ns_));
+  }
+  widths_[channel].store(width_ns, std::memory_order_relaxed);
+
+  return Napi::Number::New(env, width_ns / 1e3);
+}
+
+Napi::Value ServoController::GetPulseWidth(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Channel index expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  uint32_t channel = info[0].As<Napi::Number>().Uint32Value();
+  if (channel >= channels_.size()) {
+    Napi::RangeError::New(env, "Channel index out of range").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return Napi::Number::New(env, widths_[channel].load(std::memory_order_relaxed) / 1e3);
+}
+
+Napi::Value ServoController::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!owner_->GetRequest()) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    frames_ = 0;
+    falling_edges_ = 0;
+    max_jitter_ns_ = 0;
+    total_jitter_ns_ = 0;
+    error_.clear();
+  }
+
+  std::string error = task_.Start(period_ns_, [this]() { return Tick(); }, spin_ns_);
+  if (!error.empty()) {
+    Napi::Error::New(env, "Failed to start servo thread: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value ServoController::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  task_.Stop();
+
+  try {
+    AllLow();
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to stop servo pulses: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value ServoController::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("running", Napi::Boolean::New(env, task_.IsRunning()));
+  result.Set("rising", PeriodicStatsToObject(env, task_.GetStats()));
+
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  result.Set("frames", Napi::Number::New(env, static_cast<double>(frames_)));
+  result.Set("maxFallingJitterNs", Napi::Number::New(env, static_cast<double>(max_jitter_ns_)));
+  result.Set("meanFallingJitterNs", Napi::Number::New(env, falling_edges_ > 0 ? static_cast<double>(total_jitter_ns_ / falling_edges_) : 0));
+  result.Set("error", error_.empty() ? env.Null() : Napi::String::New(env, error_));
+
+  return result;
+}
@@ -0,0 +1,67 @@
+#ifndef SERVO_H
+#define SERVO_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+#include "periodic_task.h"
+
+// Servo pulse generator: every period all channels rise together and fall
+// one after another, shortest pulse first, all from one timing thread
+class ServoController : public Napi::ObjectWrap<ServoController> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  ServoController(const Napi::CallbackInfo& info);
+  ~ServoController();
+
+  // Wrapped methods
+  Napi::Value SetPulseWidth(const Napi::CallbackInfo& info);
+  Napi::Value GetPulseWidth(const Napi::CallbackInfo& info);
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  struct Pulse {
+    uint64_t width_ns;
+    size_t channel;
+  };
+
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  std::vector<unsigned int> channels_;
+  uint64_t period_ns_;
+  uint64_t spin_ns_;
+  uint32_t min_width_ns_;
+  uint32_t max_width_ns_;
+
+  // Pulse widths in ns, 0 for no pulse; written by JS, read once per frame
+  std::unique_ptr<std::atomic<uint32_t>[]> widths_;
+
+  // Only used by the timing thread
+  std::vector<Pulse> pulses_;
+  gpiod::line::value_mappings edges_;
+  PeriodicTask task_;
+
+  std::mutex stats_mutex_;
+  uint64_t frames_;
+  uint64_t falling_edges_;
+  uint64_t max_jitter_ns_;
+  uint64_t total_jitter_ns_;
+  std::string error_;
+
+  // Internal methods
+  bool Tick();
+  void AllLow();
+};
+
+#endif // SERVO_H
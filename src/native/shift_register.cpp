@@ -0,0 +1,554 @@
+#include "shift_register.h"
+#include "timing.h"
+#include "engine_utils.h"
+#include <algorithm>
+#include <stdexcept>
+
+Napi::FunctionReference ShiftRegisterOut::constructor;
+Napi::FunctionReference ShiftRegisterIn::constructor;
+
+namespace {
+
+// Reads the options shared by both chain types
+bool ReadChainOptions(Napi::Env env, Napi::Object options, size_t& length, bool& lsb_first, uint64_t& half_period_ns) {
+  double value = ReadNumber(options, "length", 0);
+  if (value < 1 || value != static_cast<double>(static_cast<size_t>(value))) {
+    Napi::RangeError::New(env, "Chain length must be a positive number of bytes").ThrowAsJavaScriptException();
+    return false;
+  }
+  length = static_cast<size_t>(value);
+
+  if (!ReadBitOrder(env, options, lsb_first)) {
+    return false;
+  }
+
+  // Without a clock rate the chain is clocked as fast as the ioctls go
+  double clock_hz = ReadNumber(options, "clockHz", 0);
+  if (clock_hz < 0) {
+    Napi::RangeError::New(env, "Clock frequency must not be negative").ThrowAsJavaScriptException();
+    return false;
+  }
+  half_period_ns = clock_hz > 0 ? static_cast<uint64_t>(1e9 / (2 * clock_hz)) : 0;
+
+  return true;
+}
+
+bool ReadRefreshPeriod(Napi::Env env, Napi::Value value, uint64_t& period_ns) {
+  if (!value.IsNumber() || value.As<Napi::Number>().DoubleValue() <= 0) {
+    Napi::RangeError::New(env, "Refresh rate must be a positive number of Hz").ThrowAsJavaScriptException();
+    return false;
+  }
+  period_ns = static_cast<uint64_t>(1e9 / value.As<Napi::Number>().DoubleValue());
+  return true;
+}
+
+// Waits for the next half clock period, if the chain is paced at all
+void Pace(uint64_t& deadline, uint64_t half_period_ns) {
+  if (half_period_ns > 0) {
+    deadline += half_period_ns;
+    PreciseSleepUntilNs(deadline);
+  }
+}
+
+unsigned int BitShift(unsigned int bit, bool lsb_first) {
+  return lsb_first ? bit : 7 - bit;
+}
+
+} // namespace
+
+// ShiftRegisterOut
+
+Napi::Object ShiftRegisterOut::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "ShiftRegisterOut", {
+    InstanceMethod("set", &ShiftRegisterOut::Set),
+    InstanceMethod("write", &ShiftRegisterOut::Write),
+    InstanceMethod("startRefresh", &ShiftRegisterOut::StartRefresh),
+    InstanceMethod("stopRefresh", &ShiftRegisterOut::StopRefresh),
+    InstanceMethod("getStats", &ShiftRegisterOut::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("ShiftRegisterOut", func);
+  return exports;
+}
+
+ShiftRegisterOut::ShiftRegisterOut(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<ShiftRegisterOut>(info), owner_(nullptr), data_(0), clock_(0), latch_(0), length_(0),
+    lsb_first_(false), half_period_ns_(0), shifts_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  int data = -1;
+  int clock = -1;
+  int latch = -1;
+  if (!ReadLineOffset(env, options, "data", owner_->GetOffsets(), true, data) ||
+      !ReadLineOffset(env, options, "clock", owner_->GetOffsets(), true, clock) ||
+      !ReadLineOffset(env, options, "latch", owner_->GetOffsets(), true, latch)) {
+    return;
+  }
+  if (data == clock || data == latch || clock == latch) {
+    Napi::RangeError::New(env, "Data, clock and latch must be different lines").ThrowAsJavaScriptException();
+    return;
+  }
+  data_ = static_cast<unsigned int>(data);
+  clock_ = static_cast<unsigned int>(clock);
+  latch_ = static_cast<unsigned int>(latch);
+
+  if (!ReadChainOptions(env, options, length_, lsb_first_, half_period_ns_)) {
+    return;
+  }
+  frame_.assign(length_, 0);
+  refresh_frame_.assign(length_, 0);
+
+  // Park clock and latch low so the first rising edges shift and latch
+  try {
+    owner_->WriteValues(env, {{clock_, gpiod::line::value::INACTIVE}, {latch_, gpiod::line::value::INACTIVE}});
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to initialize shift register lines: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return;
+  }
+}
+
+ShiftRegisterOut::~ShiftRegisterOut() {
+  refresh_.Stop();
+}
+
+bool ShiftRegisterOut::ReadFrame(Napi::Env env, Napi::Value value, std::vector<uint8_t>& frame) {
+  if (!value.IsTypedArray() || value.As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+    Napi::TypeError::New(env, "Uint8Array expected").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  Napi::Uint8Array data = value.As<Napi::Uint8Array>();
+  if (data.ElementLength() != length_) {
+    Napi::RangeError::New(env, "Frame must be " + std::to_string(length_) + " bytes long").ThrowAsJavaScriptException();
+    return false;
+  }
+
+  frame.assign(data.Data(), data.Data() + data.ElementLength());
+  return true;
+}
+
+void ShiftRegisterOut::Shift(const std::vector<uint8_t>& frame) {
+  std::lock_guard<std::mutex> lock(owner_->BusMutex());
+
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!request) {
+    throw std::runtime_error("line request is not active");
+  }
+
+  gpiod::line::value_mappings bit = {{clock_, gpiod::line::value::INACTIVE}, {data_, gpiod::line::value::INACTIVE}};
+  uint64_t deadline = MonotonicNowNs();
+
+  // The first bit shifted in ends up in the last register, so byte 0 of
+  // the frame lands in the register nearest to the data line
+  for (size_t i = frame.size(); i-- > 0;) {
+    for (unsigned int b = 0; b < 8; b++) {
+      // Lower the clock and present the next bit with one ioctl
+      bit[1].second = ToValue(((frame[i] >> BitShift(b, lsb_first_)) & 1) != 0);
+      request->set_values(bit);
+      Pace(deadline, half_period_ns_);
+
+      request->set_value(clock_, gpiod::line::value::ACTIVE);
+      Pace(deadline, half_period_ns_);
+    }
+  }
+
+  request->set_values({{clock_, gpiod::line::value::INACTIVE}, {latch_, gpiod::line::value::ACTIVE}});
+  Pace(deadline, half_period_ns_);
+  request->set_value(latch_, gpiod::line::value::INACTIVE);
+
+  shifts_++;
+}
+
+Napi::Value ShiftRegisterOut::Set(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  std::vector<uint8_t> frame;
+  if (!ReadFrame(env, info[0], frame)) {
+    return env.Undefined();
+  }
+
+  std::lock_guard<std::mutex> lock(frame_mutex_);
+  frame_.swap(frame);
+
+  return env.Undefined();
+}
+
+Napi::Value ShiftRegisterOut::Write(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  std::vector<uint8_t> frame;
+  if (!ReadFrame(env, info[0], frame)) {
+    return env.Undefined();
+  }
+
+  if (!owner_->GetRequest()) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(frame_mutex_);
+    frame_ = frame;
+  }
+
+  PromiseWorker* worker = new PromiseWorker(env, "GPIO Shift Register Write", info.This().As<Napi::Object>(), owner_,
+    [this, frame]() {
+      try {
+        Shift(frame);
+      } catch (const std::exception& e) {
+        throw std::runtime_error("Shift register write failed: " + std::string(e.what()));
+      }
+    },
+    [](Napi::Env env) -> Napi::Value {
+      return env.Undefined();
+    }
+  );
+  Napi::Promise promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value ShiftRegisterOut::StartRefresh(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  uint64_t period_ns = 0;
+  if (info.Length() < 1 || !ReadRefreshPeriod(env, info[0], period_ns)) {
+    return env.Undefined();
+  }
+
+  if (!owner_->GetRequest()) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    error_.clear();
+  }
+
+  std::string error = refresh_.Start(period_ns, [this]() {
+    {
+      std::lock_guard<std::mutex> lock(frame_mutex_);
+      std::copy(frame_.begin(), frame_.end(), refresh_frame_.begin());
+    }
+
+    try {
+      Shift(refresh_frame_);
+      owner_->InvalidateShadow();
+    } catch (const std::exception& e) {
+      std::lock_guard<std::mutex> lock(error_mutex_);
+      error_ = e.what();
+      return false;
+    }
+    return true;
+  });
+
+  if (!error.empty()) {
+    Napi::Error::New(env, "Failed to start refreshing: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value ShiftRegisterOut::StopRefresh(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  refresh_.Stop();
+
+  return env.Undefined();
+}
+
+Napi::Value ShiftRegisterOut::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("shifts", Napi::Number::New(env, static_cast<double>(shifts_.load())));
+  result.Set("refreshing", Napi::Boolean::New(env, refresh_.IsRunning()));
+  result.Set("refresh", PeriodicStatsToObject(env, refresh_.GetStats()));
+
+  std::lock_guard<std::mutex> lock(error_mutex_);
+  result.Set("error", error_.empty() ? env.Null() : Napi::String::New(env, error_));
+
+  return result;
+}
+
+// ShiftRegisterIn
+
+Napi::Object ShiftRegisterIn::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "ShiftRegisterIn", {
+    InstanceMethod("read", &ShiftRegisterIn::Read),
+    InstanceMethod("getLatest", &ShiftRegisterIn::GetLatest),
+    InstanceMethod("startRefresh", &ShiftRegisterIn::StartRefresh),
+    InstanceMethod("stopRefresh", &ShiftRegisterIn::StopRefresh),
+    InstanceMethod("getStats", &ShiftRegisterIn::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("ShiftRegisterIn", func);
+  return exports;
+}
+
+ShiftRegisterIn::ShiftRegisterIn(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<ShiftRegisterIn>(info), owner_(nullptr), load_(0), clock_(0), data_(0), length_(0),
+    lsb_first_(false), half_period_ns_(0), has_latest_(false), refreshing_(false), shifts_(0), changes_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  int load = -1;
+  int clock = -1;
+  int data = -1;
+  if (!ReadLineOffset(env, options, "load", owner_->GetOffsets(), true, load) ||
+      !ReadLineOffset(env, options, "clock", owner_->GetOffsets(), true, clock) ||
+      !ReadLineOffset(env, options, "data", owner_->GetOffsets(), true, data)) {
+    return;
+  }
+  if (data == clock || data == load || clock == load) {
+    Napi::RangeError::New(env, "Load, clock and data must be different lines").ThrowAsJavaScriptException();
+    return;
+  }
+  load_ = static_cast<unsigned int>(load);
+  clock_ = static_cast<unsigned int>(clock);
+  data_ = static_cast<unsigned int>(data);
+
+  if (!ReadChainOptions(env, options, length_, lsb_first_, half_period_ns_)) {
+    return;
+  }
+  latest_.assign(length_, 0);
+  refresh_frame_.assign(length_, 0);
+
+  // Park load high (shift mode) and clock low
+  try {
+    owner_->WriteValues(env, {{load_, gpiod::line::value::ACTIVE}, {clock_, gpiod::line::value::INACTIVE}});
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to initialize shift register lines: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return;
+  }
+}
+
+ShiftRegisterIn::~ShiftRegisterIn() {
+  StopRefreshing();
+}
+
+void ShiftRegisterIn::Shift(std::vector<uint8_t>& frame) {
+  std::lock_guard<std::mutex> lock(owner_->BusMutex());
+
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!request) {
+    throw std::runtime_error("line request is not active");
+  }
+
+  uint64_t deadline = MonotonicNowNs();
+
+  // Latch the parallel inputs
+  request->set_value(load_, gpiod::line::value::INACTIVE);
+  Pace(deadline, half_period_ns_);
+  request->set_value(load_, gpiod::line::value::ACTIVE);
+  Pace(deadline, half_period_ns_);
+
+  // The register nearest to the data line comes out first
+  for (size_t i = 0; i < frame.size(); i++) {
+    uint8_t byte = 0;
+    for (unsigned int b = 0; b < 8; b++) {
+      if (request->get_value(data_) == gpiod::line::value::ACTIVE) {
+        byte = static_cast<uint8_t>(byte | (1 << BitShift(b, lsb_first_)));
+      }
+
+      request->set_value(clock_, gpiod::line::value::ACTIVE);
+      Pace(deadline, half_period_ns_);
+      request->set_value(clock_, gpiod::line::value::INACTIVE);
+      Pace(deadline, half_period_ns_);
+    }
+    frame[i] = byte;
+  }
+
+  shifts_++;
+}
+
+void ShiftRegisterIn::StoreLatest(const std::vector<uint8_t>& frame) {
+  std::lock_guard<std::mutex> lock(latest_mutex_);
+  std::copy(frame.begin(), frame.end(), latest_.begin());
+  has_latest_ = true;
+}
+
+Napi::Value ShiftRegisterIn::Read(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!owner_->GetRequest()) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  auto frame = std::make_shared<std::vector<uint8_t>>(length_);
+  PromiseWorker* worker = new PromiseWorker(env, "GPIO Shift Register Read", info.This().As<Napi::Object>(), owner_,
+    [this, frame]() {
+      try {
+        Shift(*frame);
+        StoreLatest(*frame);
+      } catch (const std::exception& e) {
+        throw std::runtime_error("Shift register read failed: " + std::string(e.what()));
+      }
+    },
+    [frame](Napi::Env env) -> Napi::Value {
+      return Napi::Buffer<uint8_t>::Copy(env, frame->data(), frame->size());
+    }
+  );
+  Napi::Promise promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value ShiftRegisterIn::GetLatest(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  std::lock_guard<std::mutex> lock(latest_mutex_);
+  if (!has_latest_) {
+    return env.Null();
+  }
+
+  return Napi::Buffer<uint8_t>::Copy(env, latest_.data(), latest_.size());
+}
+
+Napi::Value ShiftRegisterIn::StartRefresh(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  uint64_t period_ns = 0;
+  if (info.Length() < 2 || !info[1].IsFunction()) {
+    Napi::TypeError::New(env, "Refresh rate and callback function expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  if (!ReadRefreshPeriod(env, info[0], period_ns)) {
+    return env.Undefined();
+  }
+
+  if (!owner_->GetRequest()) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  StopRefreshing();
+
+  tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    info[1].As<Napi::Function>(),
+    "GPIO Shift Register Refresh Callback",
+    0,
+    1
+  );
+  refreshing_ = true;
+
+  // The first refresh always reports, later ones only when an input changed
+  auto first = std::make_shared<bool>(true);
+  std::string error = refresh_.Start(period_ns, [this, first]() {
+    try {
+      Shift(refresh_frame_);
+      owner_->InvalidateShadow();
+    } catch (const std::exception& e) {
+      std::string message = e.what();
+      tsfn_.BlockingCall([message](Napi::Env env, Napi::Function jsCallback) {
+        jsCallback.Call({Napi::Error::New(env, message).Value(), env.Null()});
+      });
+      return false;
+    }
+
+    bool changed;
+    {
+      std::lock_guard<std::mutex> lock(latest_mutex_);
+      changed = *first || !std::equal(refresh_frame_.begin(), refresh_frame_.end(), latest_.begin());
+    }
+    *first = false;
+
+    if (changed) {
+      StoreLatest(refresh_frame_);
+      changes_++;
+
+      std::vector<uint8_t> frame = refresh_frame_;
+      tsfn_.BlockingCall([frame](Napi::Env env, Napi::Function jsCallback) {
+        jsCallback.Call({env.Null(), Napi::Buffer<uint8_t>::Copy(env, frame.data(), frame.size())});
+      });
+    }
+    return true;
+  });
+
+  if (!error.empty()) {
+    StopRefreshing();
+    Napi::Error::New(env, "Failed to start refreshing: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value ShiftRegisterIn::StopRefresh(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  StopRefreshing();
+
+  return env.Undefined();
+}
+
+void ShiftRegisterIn::StopRefreshing() {
+  if (refreshing_) {
+    refreshing_ = false;
+    refresh_.Stop();
+    tsfn_.Release();
+  }
+}
+
+Napi::Value ShiftRegisterIn::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("shifts", Napi::Number::New(env, static_cast<double>(shifts_.load())));
+  result.Set("changes", Napi::Number::New(env, static_cast<double>(changes_.load())));
+  result.Set("refreshing", Napi::Boolean::New(env, refresh_.IsRunning()));
+  result.Set("refresh", PeriodicStatsToObject(env, refresh_.GetStats()));
+
+  return result;
+}
@@ -0,0 +1,104 @@
+#ifndef SHIFT_REGISTER_H
+#define SHIFT_REGISTER_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+#include "periodic_task.h"
+
+// Serial-in/parallel-out chain (74HC595): data, shift clock and storage latch
+class ShiftRegisterOut : public Napi::ObjectWrap<ShiftRegisterOut> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  ShiftRegisterOut(const Napi::CallbackInfo& info);
+  ~ShiftRegisterOut();
+
+  // Wrapped methods
+  Napi::Value Set(const Napi::CallbackInfo& info);
+  Napi::Value Write(const Napi::CallbackInfo& info);
+  Napi::Value StartRefresh(const Napi::CallbackInfo& info);
+  Napi::Value StopRefresh(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  unsigned int data_;
+  unsigned int clock_;
+  unsigned int latch_;
+  size_t length_;
+  bool lsb_first_;
+  uint64_t half_period_ns_;
+
+  std::mutex frame_mutex_;
+  std::vector<uint8_t> frame_;
+
+  // Only used by the refresh thread
+  std::vector<uint8_t> refresh_frame_;
+  PeriodicTask refresh_;
+
+  std::atomic<uint64_t> shifts_;
+  std::mutex error_mutex_;
+  std::string error_;
+
+  // Internal methods
+  bool ReadFrame(Napi::Env env, Napi::Value value, std::vector<uint8_t>& frame);
+  void Shift(const std::vector<uint8_t>& frame);
+};
+
+// Parallel-in/serial-out chain (74HC165): parallel load, clock and data
+class ShiftRegisterIn : public Napi::ObjectWrap<ShiftRegisterIn> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  ShiftRegisterIn(const Napi::CallbackInfo& info);
+  ~ShiftRegisterIn();
+
+  // Wrapped methods
+  Napi::Value Read(const Napi::CallbackInfo& info);
+  Napi::Value GetLatest(const Napi::CallbackInfo& info);
+  Napi::Value StartRefresh(const Napi::CallbackInfo& info);
+  Napi::Value StopRefresh(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  unsigned int load_;
+  unsigned int clock_;
+  unsigned int data_;
+  size_t length_;
+  bool lsb_first_;
+  uint64_t half_period_ns_;
+
+  std::mutex latest_mutex_;
+  std::vector<uint8_t> latest_;
+  bool has_latest_;
+
+  // Only used by the refresh thread
+  std::vector<uint8_t> refresh_frame_;
+  PeriodicTask refresh_;
+  Napi::ThreadSafeFunction tsfn_;
+  bool refreshing_;
+
+  std::atomic<uint64_t> shifts_;
+  std::atomic<uint64_t> changes_;
+
+  // Internal methods
+  void Shift(std::vector<uint8_t>& frame);
+  void StoreLatest(const std::vector<uint8_t>& frame);
+  void StopRefreshing();
+};
+
+#endif // SHIFT_REGISTER_H
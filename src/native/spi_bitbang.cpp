@@ -0,0 +1,244 @@
+#include "spi_bitbang.h"
+#include "timing.h"
+#include "engine_utils.h"
+#include <mutex>
+#include <stdexcept>
+
+Napi::FunctionReference SpiBitbang::constructor;
+
+Napi::Object SpiBitbang::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "SpiBitbang", {
+    InstanceMethod("transfer", &SpiBitbang::Transfer),
+    InstanceMethod("getStats", &SpiBitbang::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("SpiBitbang", func);
+  return exports;
+}
+
+SpiBitbang::SpiBitbang(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<SpiBitbang>(info), owner_(nullptr), sck_(0), mosi_(-1), miso_(-1), cs_(-1), cpol_(false),
+    cpha_(false), lsb_first_(false), cs_active_high_(false), clock_hz_(0), half_period_ns_(0), transfers_(0), bytes_(0), achieved_hz_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  const std::vector<unsigned int>& offsets = owner_->GetOffsets();
+
+  int sck = -1;
+  if (!ReadLineOffset(env, options, "sck", offsets, true, sck) ||
+      !ReadLineOffset(env, options, "mosi", offsets, false, mosi_) ||
+      !ReadLineOffset(env, options, "miso", offsets, false, miso_) ||
+      !ReadLineOffset(env, options, "cs", offsets, false, cs_)) {
+    return;
+  }
+  sck_ = static_cast<unsigned int>(sck);
+
+  double mode_value = ReadNumber(options, "mode", 0);
+  if (mode_value < 0 || mode_value > 3) {
+    Napi::RangeError::New(env, "SPI mode must be between 0 and 3").ThrowAsJavaScriptException();
+    return;
+  }
+  uint32_t mode = static_cast<uint32_t>(mode_value);
+  cpol_ = (mode & 2) != 0;
+  cpha_ = (mode & 1) != 0;
+
+  if (!ReadBitOrder(env, options, lsb_first_)) {
+    return;
+  }
+
+  cs_active_high_ = ReadBoolean(options, "csActiveHigh", false);
+
+  clock_hz_ = ReadNumber(options, "clockHz", 100000);
+  if (clock_hz_ <= 0) {
+    Napi::RangeError::New(env, "Clock frequency must be positive").ThrowAsJavaScriptException();
+    return;
+  }
+  half_period_ns_ = static_cast<uint64_t>(1e9 / (2 * clock_hz_));
+
+  // Park the bus: clock idle, chip select inactive
+  gpiod::line::value_mappings idle = {{sck_, ToValue(cpol_)}};
+  if (cs_ >= 0) {
+    idle.emplace_back(static_cast<unsigned int>(cs_), ToValue(!cs_active_high_));
+  }
+
+  try {
+    owner_->WriteValues(env, idle);
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to initialize SPI lines: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return;
+  }
+}
+
+SpiBitbang::~SpiBitbang() {
+}
+
+LineRequest* SpiBitbang::GetOwner() const {
+  return owner_;
+}
+
+void SpiBitbang::Run(const std::vector<uint8_t>& tx, std::vector<uint8_t>& rx) {
+  std::lock_guard<std::mutex> lock(owner_->BusMutex());
+
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!request) {
+    throw std::runtime_error("Line request is not active");
+  }
+
+  rx.assign(tx.size(), 0);
+  size_t num_bits = tx.size() * 8;
+  if (num_bits == 0) {
+    return;
+  }
+
+  auto tx_bit = [&](size_t bit) {
+    uint8_t byte = tx[bit / 8];
+    unsigned int shift = lsb_first_ ? (bit % 8) : (7 - bit % 8);
+    return ((byte >> shift) & 1) != 0;
+  };
+
+  auto store_rx_bit = [&](size_t bit, bool value) {
+    if (value) {
+      unsigned int shift = lsb_first_ ? (bit % 8) : (7 - bit % 8);
+      rx[bit / 8] |= static_cast<uint8_t>(1u << shift);
+    }
+  };
+
+  auto sample = [&]() {
+    return miso_ >= 0 && request->get_value(static_cast<unsigned int>(miso_)) == gpiod::line::value::ACTIVE;
+  };
+
+  // One set_values per clock edge, MOSI changes together with SCK
+  gpiod::line::value_mappings edge;
+  edge.reserve(3);
+  auto drive = [&](bool sck_active, int mosi_bit) {
+    edge.clear();
+    edge.emplace_back(sck_, ToValue(sck_active ? !cpol_ : cpol_));
+    if (mosi_ >= 0 && mosi_bit >= 0) {
+      edge.emplace_back(static_cast<unsigned int>(mosi_), ToValue(mosi_bit != 0));
+    }
+    request->set_values(edge);
+  };
+
+  if (cs_ >= 0) {
+    request->set_value(static_cast<unsigned int>(cs_), ToValue(cs_active_high_));
+  }
+
+  uint64_t start = MonotonicNowNs();
+  try {
+    uint64_t deadline = start;
+
+    if (!cpha_) {
+      // Data is valid before the leading edge and sampled on it
+      drive(false, tx_bit(0));
+      for (size_t bit = 0; bit < num_bits; bit++) {
+        deadline += half_period_ns_;
+        PreciseSleepUntilNs(deadline);
+        drive(true, -1);
+        store_rx_bit(bit, sample());
+
+        deadline += half_period_ns_;
+        PreciseSleepUntilNs(deadline);
+        drive(false, bit + 1 < num_bits ? tx_bit(bit + 1) : -1);
+      }
+    } else {
+      // Data is shifted out on the leading edge and sampled on the trailing one
+      for (size_t bit = 0; bit < num_bits; bit++) {
+        drive(true, tx_bit(bit));
+
+        deadline += half_period_ns_;
+        PreciseSleepUntilNs(deadline);
+        drive(false, -1);
+        store_rx_bit(bit, sample());
+
+        deadline += half_period_ns_;
+        PreciseSleepUntilNs(deadline);
+      }
+    }
+  } catch (...) {
+    // Do not leave the device selected when a write fails mid-transfer
+    if (cs_ >= 0) {
+      try {
+        request->set_value(static_cast<unsigned int>(cs_), ToValue(!cs_active_high_));
+      } catch (const std::exception&) {
+      }
+    }
+    throw;
+  }
+
+  uint64_t elapsed = MonotonicNowNs() - start;
+
+  if (cs_ >= 0) {
+    request->set_value(static_cast<unsigned int>(cs_), ToValue(!cs_active_high_));
+  }
+
+  transfers_++;
+  bytes_ += tx.size();
+  achieved_hz_ = elapsed > 0 ? static_cast<double>(num_bits) * 1e9 / static_cast<double>(elapsed) : 0;
+}
+
+Napi::Value SpiBitbang::Transfer(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsTypedArray() ||
+      info[0].As<Napi::TypedArray>().TypedArrayType() != napi_uint8_array) {
+    Napi::TypeError::New(env, "Uint8Array expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!owner_->GetRequest()) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Uint8Array data = info[0].As<Napi::Uint8Array>();
+  std::vector<uint8_t> tx(data.Data(), data.Data() + data.ElementLength());
+
+  auto rx = std::make_shared<std::vector<uint8_t>>();
+  PromiseWorker* worker = new PromiseWorker(env, "GPIO SPI Transfer", info.This().As<Napi::Object>(), owner_,
+    [this, tx, rx]() {
+      try {
+        Run(tx, *rx);
+      } catch (const std::exception& e) {
+        throw std::runtime_error("SPI transfer failed: " + std::string(e.what()));
+      }
+    },
+    [rx](Napi::Env env) -> Napi::Value {
+      return Napi::Buffer<uint8_t>::Copy(env, rx->data(), rx->size());
+    }
+  );
+  Napi::Promise promise = worker->GetPromise();
+  worker->Queue();
+
+  return promise;
+}
+
+Napi::Value SpiBitbang::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("transfers", Napi::Number::New(env, static_cast<double>(transfers_.load())));
+  result.Set("bytes", Napi::Number::New(env, static_cast<double>(bytes_.load())));
+  result.Set("targetClockHz", Napi::Number::New(env, clock_hz_));
+  result.Set("achievedClockHz", Napi::Number::New(env, achieved_hz_.load()));
+
+  return result;
+}
@@ -0,0 +1,48 @@
+#ifndef SPI_BITBANG_H
+#define SPI_BITBANG_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+
+class SpiBitbang : public Napi::ObjectWrap<SpiBitbang> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  SpiBitbang(const Napi::CallbackInfo& info);
+  ~SpiBitbang();
+
+  // Wrapped methods
+  Napi::Value Transfer(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+  // Internal methods, called from the transfer worker
+  void Run(const std::vector<uint8_t>& tx, std::vector<uint8_t>& rx);
+  LineRequest* GetOwner() const;
+
+private:
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  unsigned int sck_;
+  int mosi_;
+  int miso_;
+  int cs_;
+  bool cpol_;
+  bool cpha_;
+  bool lsb_first_;
+  bool cs_active_high_;
+  double clock_hz_;
+  uint64_t half_period_ns_;
+
+  std::atomic<uint64_t> transfers_;
+  std::atomic<uint64_t> bytes_;
+  std::atomic<double> achieved_hz_;
+};
+
+#endif // SPI_BITBANG_H
@@ -0,0 +1,511 @@
+#include "stepper.h"
+#include "timing.h"
+#include "thread_options.h"
+#include "engine_utils.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+Napi::FunctionReference StepperController::constructor;
+
+namespace {
+
+// Longest acceleration ramp that is planned, in steps
+const size_t kMaxRampSteps = 1000000;
+
+// Deadlines closer than this are busy-waited for
+const uint64_t kSpinNs = 50000;
+
+} // namespace
+
+Napi::Object StepperController::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "StepperController", {
+    InstanceMethod("moveTo", &StepperController::MoveTo),
+    InstanceMethod("stop", &StepperController::Stop),
+    InstanceMethod("abort", &StepperController::Abort),
+    InstanceMethod("getPosition", &StepperController::GetPosition),
+    InstanceMethod("setPosition", &StepperController::SetPosition),
+    InstanceMethod("isMoving", &StepperController::IsMoving),
+    InstanceMethod("getStats", &StepperController::GetStats),
+    InstanceMethod("close", &StepperController::Close)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("StepperController", func);
+  return exports;
+}
+
+StepperController::StepperController(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<StepperController>(info), owner_(nullptr), step_(0), dir_(0), invert_dir_(false), pulse_ns_(0),
+    dir_setup_ns_(0), max_speed_(0), acceleration_(0), profile_(Profile::TRAPEZOIDAL), running_(false), stop_(false),
+    abort_(false), moving_(false), next_id_(1), position_(0), steps_(0), moves_(0), max_lateness_ns_(0),
+    ramp_speed_(0), ramp_acceleration_(0), ramp_profile_(Profile::TRAPEZOIDAL), last_dir_known_(false), last_dir_(false) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  int step = -1;
+  int dir = -1;
+  if (!ReadLineOffset(env, options, "step", owner_->GetOffsets(), true, step) ||
+      !ReadLineOffset(env, options, "dir", owner_->GetOffsets(), true, dir)) {
+    return;
+  }
+  if (step == dir) {
+    Napi::RangeError::New(env, "Step and direction must be different lines").ThrowAsJavaScriptException();
+    return;
+  }
+  step_ = static_cast<unsigned int>(step);
+  dir_ = static_cast<unsigned int>(dir);
+
+  invert_dir_ = ReadBoolean(options, "invertDir", false);
+
+  double pulse_us = ReadNumber(options, "pulseUs", 2);
+  double dir_setup_us = ReadNumber(options, "dirSetupUs", 5);
+  if (pulse_us <= 0 || dir_setup_us < 0) {
+    Napi::RangeError::New(env, "Step pulse width must be positive and direction setup time must not be negative").ThrowAsJavaScriptException();
+    return;
+  }
+  pulse_ns_ = static_cast<uint64_t>(pulse_us * 1e3);
+  dir_setup_ns_ = static_cast<uint64_t>(dir_setup_us * 1e3);
+
+  max_speed_ = ReadNumber(options, "maxSpeed", 1000);
+  acceleration_ = ReadNumber(options, "acceleration", 1000);
+  if (max_speed_ <= 0 || acceleration_ <= 0) {
+    Napi::RangeError::New(env, "Speed and acceleration must be positive").ThrowAsJavaScriptException();
+    return;
+  }
+  if (options.Has("profile") && !ParseProfile(env, options.Get("profile"), profile_)) {
+    return;
+  }
+
+  position_ = static_cast<int64_t>(ReadNumber(options, "position", 0));
+
+  // Settles the promises of finished moves; the function itself is unused
+  tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+    "GPIO Stepper Callback",
+    0,
+    1
+  );
+  tsfn_.Unref(env);
+
+  running_ = true;
+  thread_ = std::thread(&StepperController::Run, this);
+
+  std::string error = ApplyThreadOptions(thread_);
+  if (!error.empty()) {
+    Shutdown();
+    Napi::Error::New(env, "Failed to start motion thread: " + error).ThrowAsJavaScriptException();
+    return;
+  }
+}
+
+StepperController::~StepperController() {
+  Shutdown();
+}
+
+bool StepperController::ParseProfile(Napi::Env env, Napi::Value value, Profile& profile) {
+  std::string name = value.IsString() ? value.As<Napi::String>().Utf8Value() : "";
+  if (name == "trapezoidal") {
+    profile = Profile::TRAPEZOIDAL;
+  } else if (name == "s-curve") {
+    profile = Profile::S_CURVE;
+  } else {
+    Napi::TypeError::New(env, "Invalid motion profile: must be 'trapezoidal' or 's-curve'").ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+void StepperController::BuildRamp(const Move& move) {
+  if (!ramp_.empty() && ramp_speed_ == move.max_speed && ramp_acceleration_ == move.acceleration &&
+      ramp_profile_ == move.profile) {
+    return;
+  }
+  ramp_speed_ = move.max_speed;
+  ramp_acceleration_ = move.acceleration;
+  ramp_profile_ = move.profile;
+
+  // The ramp holds the intervals between consecutive steps while
+  // accelerating from standstill up to the cruise speed. Deceleration uses
+  // the same intervals in reverse.
+  ramp_.clear();
+  double cruise_s = 1.0 / move.max_speed;
+  std::function<double(double)> time_at;
+
+  if (move.profile == Profile::TRAPEZOIDAL) {
+    // Constant acceleration: x = a t^2 / 2
+    double a = move.acceleration;
+    time_at = [a](double x) { return std::sqrt(2 * x / a); };
+  } else {
+    // Sinusoidal acceleration with peak a, which limits the jerk:
+    // v = vmax (1 - cos(pi t / T)) / 2 with T = pi vmax / (2 a)
+    double vmax = move.max_speed;
+    double period = M_PI * vmax / (2 * move.acceleration);
+    double distance = vmax * period / 2;
+    time_at = [vmax, period, distance](double x) {
+      if (x >= distance) {
+        return period;
+      }
+      double low = 0;
+      double high = period;
+      for (int i = 0; i < 48; i++) {
+        double t = (low + high) / 2;
+        double position = vmax / 2 * (t - period / M_PI * std::sin(M_PI * t / period));
+        if (position < x) {
+          low = t;
+        } else {
+          high = t;
+        }
+      }
+      return high;
+    };
+  }
+
+  double previous = 0;
+  for (size_t step = 1; step <= kMaxRampSteps; step++) {
+    double time = time_at(static_cast<double>(step));
+    double interval = time - previous;
+    if (interval <= cruise_s) {
+      break;
+    }
+    ramp_.push_back(static_cast<uint64_t>(interval * 1e9));
+    previous = time;
+  }
+}
+
+uint64_t StepperController::StepInterval(size_t step, size_t count, uint64_t cruise_ns) const {
+  // Interval after the given step: the slower of the acceleration ramp, the
+  // mirrored deceleration ramp and the cruise speed
+  uint64_t interval = cruise_ns;
+  if (step < ramp_.size()) {
+    interval = std::max(interval, ramp_[step]);
+  }
+  size_t remaining = count - 2 - step;
+  if (remaining < ramp_.size()) {
+    interval = std::max(interval, ramp_[remaining]);
+  }
+  return interval;
+}
+
+size_t StepperController::StoppingSteps(uint64_t interval_ns) const {
+  // Position on the (descending) ramp with the current speed
+  auto it = std::lower_bound(ramp_.begin(), ramp_.end(), interval_ns, std::greater<uint64_t>());
+  return static_cast<size_t>(it - ramp_.begin());
+}
+
+void StepperController::Execute(const Move& move) {
+  int64_t start = position_;
+  int64_t target = move.relative ? start + move.target : move.target;
+  if (target == start) {
+    return;
+  }
+
+  bool forward = target > start;
+  size_t count = static_cast<size_t>(forward ? target - start : start - target);
+  uint64_t cruise_ns = static_cast<uint64_t>(1e9 / move.max_speed);
+  BuildRamp(move);
+
+  // The request is fetched for every step, so release() aborts the move
+  if (!last_dir_known_ || last_dir_ != forward) {
+    std::lock_guard<std::mutex> lock(owner_->BusMutex());
+    owner_->ActiveRequest()->set_value(dir_, ToValue(forward != invert_dir_));
+    last_dir_known_ = true;
+    last_dir_ = forward;
+    PreciseSleepUntilNs(MonotonicNowNs() + dir_setup_ns_);
+  }
+
+  uint64_t deadline = MonotonicNowNs();
+  uint64_t interval = ramp_.empty() ? cruise_ns : ramp_[0];
+  bool stopping = false;
+
+  for (size_t step = 0; step < count; step++) {
+    if (abort_) {
+      break;
+    }
+
+    uint64_t now = MonotonicNowNs();
+    uint64_t lateness = now > deadline ? now - deadline : 0;
+    if (lateness > max_lateness_ns_) {
+      max_lateness_ns_ = lateness;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(owner_->BusMutex());
+      std::shared_ptr<gpiod::line_request> request = owner_->ActiveRequest();
+      request->set_value(step_, gpiod::line::value::ACTIVE);
+      PreciseSleepUntilNs(MonotonicNowNs() + pulse_ns_, kSpinNs);
+      request->set_value(step_, gpiod::line::value::INACTIVE);
+    }
+    position_ += forward ? 1 : -1;
+    steps_++;
+
+    // Shorten the move to a deceleration from the current speed
+    if (stop_ && !stopping) {
+      stopping = true;
+      count = std::min(count, step + 2 + StoppingSteps(interval));
+    }
+    if (step + 1 >= count) {
+      break;
+    }
+
+    interval = StepInterval(step, count, cruise_ns);
+    deadline += interval;
+    PreciseSleepUntilNs(deadline, kSpinNs);
+  }
+}
+
+void StepperController::Run() {
+  while (true) {
+    Move move;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      queue_cv_.wait(lock, [this]() { return !running_ || !queue_.empty(); });
+      if (!running_) {
+        break;
+      }
+      move = queue_.front();
+      queue_.pop_front();
+      moving_ = true;
+    }
+
+    std::string error;
+    try {
+      Execute(move);
+    } catch (const std::exception& e) {
+      error = e.what();
+    }
+    owner_->InvalidateShadow();
+    moves_++;
+
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      moving_ = false;
+      stop_ = false;
+      abort_ = false;
+    }
+
+    Complete(move.id, error);
+  }
+}
+
+void StepperController::Complete(uint64_t id, const std::string& error) {
+  int64_t position = position_;
+  tsfn_.BlockingCall([this, id, error, position](Napi::Env env, Napi::Function) {
+    auto it = pending_.find(id);
+    if (it == pending_.end()) {
+      return;
+    }
+
+    if (error.empty()) {
+      it->second.Resolve(Napi::Number::New(env, static_cast<double>(position)));
+    } else {
+      it->second.Reject(Napi::Error::New(env, "Move failed: " + error).Value());
+    }
+    pending_.erase(it);
+    Settled(env);
+  });
+}
+
+void StepperController::CancelQueued(Napi::Env env, const std::string& reason) {
+  std::deque<Move> cancelled;
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    cancelled.swap(queue_);
+  }
+
+  for (const Move& move : cancelled) {
+    auto it = pending_.find(move.id);
+    if (it != pending_.end()) {
+      it->second.Reject(Napi::Error::New(env, reason).Value());
+      pending_.erase(it);
+    }
+  }
+
+  if (!cancelled.empty()) {
+    Settled(env);
+  }
+}
+
+void StepperController::Settled(Napi::Env env) {
+  if (pending_.empty()) {
+    tsfn_.Unref(env);
+    self_ref_.Reset();
+  }
+}
+
+void StepperController::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (!running_ && !thread_.joinable()) {
+      return;
+    }
+    running_ = false;
+    abort_ = true;
+  }
+  queue_cv_.notify_all();
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+
+  tsfn_.Release();
+}
+
+Napi::Value StepperController::MoveTo(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Target position expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (!running_) {
+    Napi::Error::New(env, "Stepper controller is closed").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Move move;
+  move.id = next_id_++;
+  move.target = info[0].As<Napi::Number>().Int64Value();
+  move.relative = false;
+  move.max_speed = max_speed_;
+  move.acceleration = acceleration_;
+  move.profile = profile_;
+
+  if (info.Length() > 1 && info[1].IsObject()) {
+    Napi::Object options = info[1].As<Napi::Object>();
+    move.relative = ReadBoolean(options, "relative", false);
+    move.max_speed = ReadNumber(options, "maxSpeed", max_speed_);
+    move.acceleration = ReadNumber(options, "acceleration", acceleration_);
+    if (move.max_speed <= 0 || move.acceleration <= 0) {
+      Napi::RangeError::New(env, "Speed and acceleration must be positive").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    if (options.Has("profile") && !options.Get("profile").IsUndefined() &&
+        !ParseProfile(env, options.Get("profile"), move.profile)) {
+      return env.Undefined();
+    }
+  }
+
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+  if (pending_.empty()) {
+    tsfn_.Ref(env);
+    self_ref_ = Napi::Persistent(info.This().As<Napi::Object>());
+  }
+  pending_.emplace(move.id, deferred);
+
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    queue_.push_back(move);
+  }
+  queue_cv_.notify_one();
+
+  return deferred.Promise();
+}
+
+Napi::Value StepperController::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  CancelQueued(env, "Move cancelled by stop()");
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (moving_) {
+      stop_ = true;
+    }
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value StepperController::Abort(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  CancelQueued(env, "Move cancelled by abort()");
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (moving_) {
+      abort_ = true;
+    }
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value StepperController::GetPosition(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  return Napi::Number::New(env, static_cast<double>(position_.load()));
+}
+
+Napi::Value StepperController::SetPosition(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Position number expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::lock_guard<std::mutex> lock(queue_mutex_);
+  if (moving_ || !queue_.empty()) {
+    Napi::Error::New(env, "Cannot set the position while moving").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  position_ = info[0].As<Napi::Number>().Int64Value();
+
+  return env.Undefined();
+}
+
+Napi::Value StepperController::IsMoving(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  return Napi::Boolean::New(env, moving_.load());
+}
+
+Napi::Value StepperController::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  size_t queued;
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    queued = queue_.size();
+  }
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("steps", Napi::Number::New(env, static_cast<double>(steps_.load())));
+  result.Set("moves", Napi::Number::New(env, static_cast<double>(moves_.load())));
+  result.Set("queued", Napi::Number::New(env, static_cast<double>(queued)));
+  result.Set("maxLatenessNs", Napi::Number::New(env, static_cast<double>(max_lateness_ns_.load())));
+
+  return result;
+}
+
+Napi::Value StepperController::Close(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  CancelQueued(env, "Stepper controller closed");
+  Shutdown();
+
+  return env.Undefined();
+}
@@ -0,0 +1,107 @@
+#ifndef STEPPER_H
+#define STEPPER_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+
+// Step/direction stepper driver with queued, acceleration limited moves
+class StepperController : public Napi::ObjectWrap<StepperController> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  StepperController(const Napi::CallbackInfo& info);
+  ~StepperController();
+
+  // Wrapped methods
+  Napi::Value MoveTo(const Napi::CallbackInfo& info);
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value Abort(const Napi::CallbackInfo& info);
+  Napi::Value GetPosition(const Napi::CallbackInfo& info);
+  Napi::Value SetPosition(const Napi::CallbackInfo& info);
+  Napi::Value IsMoving(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value Close(const Napi::CallbackInfo& info);
+
+private:
+  enum class Profile {
+    TRAPEZOIDAL,
+    S_CURVE
+  };
+
+  struct Move {
+    uint64_t id;
+    int64_t target;
+    bool relative;
+    double max_speed;
+    double acceleration;
+    Profile profile;
+  };
+
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  unsigned int step_;
+  unsigned int dir_;
+  bool invert_dir_;
+  uint64_t pulse_ns_;
+  uint64_t dir_setup_ns_;
+  double max_speed_;
+  double acceleration_;
+  Profile profile_;
+
+  std::thread thread_;
+  std::atomic<bool> running_;
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::deque<Move> queue_;
+  std::atomic<bool> stop_;
+  std::atomic<bool> abort_;
+  std::atomic<bool> moving_;
+
+  // Promises of pending moves, only touched on the JavaScript thread. The
+  // wrapper is kept alive while moves are pending, because their completion
+  // callbacks run on it after the motion thread finished them.
+  Napi::ThreadSafeFunction tsfn_;
+  std::map<uint64_t, Napi::Promise::Deferred> pending_;
+  Napi::ObjectReference self_ref_;
+  uint64_t next_id_;
+
+  std::atomic<int64_t> position_;
+  std::atomic<uint64_t> steps_;
+  std::atomic<uint64_t> moves_;
+  std::atomic<uint64_t> max_lateness_ns_;
+
+  // Only used by the motion thread
+  std::vector<uint64_t> ramp_;
+  double ramp_speed_;
+  double ramp_acceleration_;
+  Profile ramp_profile_;
+  bool last_dir_known_;
+  bool last_dir_;
+
+  // Internal methods
+  bool ParseProfile(Napi::Env env, Napi::Value value, Profile& profile);
+  void BuildRamp(const Move& move);
+  uint64_t StepInterval(size_t step, size_t count, uint64_t cruise_ns) const;
+  size_t StoppingSteps(uint64_t interval_ns) const;
+  void Run();
+  void Execute(const Move& move);
+  void Complete(uint64_t id, const std::string& error);
+  void CancelQueued(Napi::Env env, const std::string& reason);
+  void Settled(Napi::Env env);
+  void Shutdown();
+};
+
+#endif // STEPPER_H
@@ -0,0 +1,343 @@
+#include "supervisor.h"
+#include "engine_utils.h"
+#include "timing.h"
+#include <algorithm>
+
+Napi::FunctionReference HeartbeatSupervisor::constructor;
+
+Napi::Object HeartbeatSupervisor::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "HeartbeatSupervisor", {
+    InstanceMethod("add", &HeartbeatSupervisor::Add),
+    InstanceMethod("remove", &HeartbeatSupervisor::Remove),
+    InstanceMethod("start", &HeartbeatSupervisor::Start),
+    InstanceMethod("stop", &HeartbeatSupervisor::Stop),
+    InstanceMethod("getStatus", &HeartbeatSupervisor::GetStatus)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("HeartbeatSupervisor", func);
+  return exports;
+}
+
+HeartbeatSupervisor::HeartbeatSupervisor(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<HeartbeatSupervisor>(info), owner_(nullptr), started_(false) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+}
+
+HeartbeatSupervisor::~HeartbeatSupervisor() {
+  StopSupervising();
+}
+
+void HeartbeatSupervisor::OnEvents(const std::vector<EdgeRecord>& edges) {
+  std::vector<Event> events;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (const EdgeRecord& edge : edges) {
+      auto it = std::find_if(lines_.begin(), lines_.end(), [&](const Line& line) {
+        return line.offset == edge.offset;
+      });
+      if (it == lines_.end() || !(edge.rising ? it->on_rising : it->on_falling)) {
+        continue;
+      }
+      Line& line = *it;
+
+      uint64_t interval = line.last_ns != 0 && edge.timestamp_ns > line.last_ns ? edge.timestamp_ns - line.last_ns : 0;
+      bool first = line.last_ns == 0;
+      line.last_ns = edge.timestamp_ns;
+      line.deadline_ns = edge.timestamp_ns + line.max_interval_ns;
+      line.heartbeats++;
+      if (!first) {
+        line.last_interval_ns = interval;
+      }
+
+      if (!first && line.min_interval_ns > 0 && interval < line.min_interval_ns) {
+        line.too_fast++;
+        if (line.state != State::kTooFast) {
+          line.state = State::kTooFast;
+          events.push_back({line.offset, EventType::kTooFast, edge.timestamp_ns, interval});
+        }
+        continue;
+      }
+
+      if (line.state == State::kTimeout || line.state == State::kTooFast) {
+        events.push_back({line.offset, EventType::kRecovered, edge.timestamp_ns, interval});
+      }
+      line.state = State::kAlive;
+    }
+  }
+
+  Emit(events);
+}
+
+void HeartbeatSupervisor::OnIdle(uint64_t now_ns) {
+  std::vector<Event> events;
+  uint64_t wake = 0;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    for (Line& line : lines_) {
+      if (line.state == State::kTimeout) {
+        continue;
+      }
+      if (now_ns >= line.deadline_ns) {
+        line.state = State::kTimeout;
+        line.timeouts++;
+        uint64_t silent = line.last_ns != 0 ? line.deadline_ns - line.last_ns : line.max_interval_ns;
+        events.push_back({line.offset, EventType::kTimeout, line.deadline_ns, silent});
+        continue;
+      }
+      if (wake == 0 || line.deadline_ns < wake) {
+        wake = line.deadline_ns;
+      }
+    }
+  }
+
+  // Sleep until the earliest deadline; lines in timeout wait for an edge
+  reader_->WakeAt(wake);
+  Emit(events);
+}
+
+void HeartbeatSupervisor::Emit(std::vector<Event>& events) {
+  if (events.empty()) {
+    return;
+  }
+
+  auto batch = std::make_shared<std::vector<Event>>(std::move(events));
+  tsfn_.BlockingCall([batch](Napi::Env env, Napi::Function jsCallback) {
+    for (const Event& event : *batch) {
+      Napi::Object result = Napi::Object::New(env);
+      result.Set("offset", Napi::Number::New(env, event.offset));
+
+      const char* type = "timeout";
+      if (event.type == EventType::kTooFast) {
+        type = "too-fast";
+      } else if (event.type == EventType::kRecovered) {
+        type = "recovered";
+      }
+      result.Set("type", Napi::String::New(env, type));
+      result.Set("timestampNs", Napi::BigInt::New(env, event.timestamp_ns));
+      result.Set("intervalNs", Napi::Number::New(env, static_cast<double>(event.interval_ns)));
+      jsCallback.Call({env.Null(), result});
+    }
+  });
+}
+
+Napi::Value HeartbeatSupervisor::Add(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "Offset number and options object expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  unsigned int offset = info[0].As<Napi::Number>().Uint32Value();
+  const std::vector<unsigned int>& offsets = owner_->GetOffsets();
+  if (std::find(offsets.begin(), offsets.end(), offset) == offsets.end()) {
+    Napi::RangeError::New(env, "Offset " + std::to_string(offset) + " is not part of the request").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  double max_interval_ms = ReadNumber(options, "maxIntervalMs", 0);
+  double min_interval_ms = ReadNumber(options, "minIntervalMs", 0);
+  if (max_interval_ms <= 0 || min_interval_ms < 0 || min_interval_ms >= max_interval_ms) {
+    Napi::RangeError::New(env, "Invalid heartbeat intervals: expected 0 <= minIntervalMs < maxIntervalMs").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::string edge = "rising";
+  if (options.Has("edge") && options.Get("edge").IsString()) {
+    edge = options.Get("edge").As<Napi::String>().Utf8Value();
+  }
+  if (edge != "rising" && edge != "falling" && edge != "both") {
+    Napi::RangeError::New(env, "Edge must be 'rising', 'falling' or 'both'").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Line line = {};
+  line.offset = offset;
+  line.max_interval_ns = static_cast<uint64_t>(max_interval_ms * 1e6);
+  line.min_interval_ns = static_cast<uint64_t>(min_interval_ms * 1e6);
+  line.on_rising = edge != "falling";
+  line.on_falling = edge != "rising";
+  line.state = State::kWaiting;
+  // A line that never pulses times out one interval after supervision starts
+  line.deadline_ns = MonotonicNowNs() + line.max_interval_ns;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = std::find_if(lines_.begin(), lines_.end(), [offset](const Line& existing) {
+    return existing.offset == offset;
+  });
+  if (it != lines_.end()) {
+    *it = line;
+  } else {
+    lines_.push_back(line);
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value HeartbeatSupervisor::Remove(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Offset number expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  unsigned int offset = info[0].As<Napi::Number>().Uint32Value();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  lines_.erase(std::remove_if(lines_.begin(), lines_.end(), [offset](const Line& line) {
+    return line.offset == offset;
+  }), lines_.end());
+
+  return env.Undefined();
+}
+
+Napi::Value HeartbeatSupervisor::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsFunction()) {
+    Napi::TypeError::New(env, "Callback function expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!request) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  StopSupervising();
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    uint64_t now = MonotonicNowNs();
+    for (Line& line : lines_) {
+      line.state = State::kWaiting;
+      line.last_ns = 0;
+      line.deadline_ns = now + line.max_interval_ns;
+    }
+  }
+
+  if (!owner_->ClaimEdgeEvents(env, this, "HeartbeatSupervisor")) {
+    return env.Undefined();
+  }
+
+  tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    info[0].As<Napi::Function>(),
+    "GPIO Heartbeat Supervisor Callback",
+    0,
+    1
+  );
+  started_ = true;
+
+  reader_ = std::make_unique<EdgeReader>(
+    request,
+    [this](const std::vector<EdgeRecord>& edges) { OnEvents(edges); },
+    [this](const std::string& error) {
+      tsfn_.BlockingCall([error](Napi::Env env, Napi::Function jsCallback) {
+        jsCallback.Call({Napi::Error::New(env, error).Value(), env.Null()});
+      });
+    }
+  );
+  // The poll interval bounds how long a line added while running waits for
+  // its first deadline to be picked up
+  reader_->SetIdleHandler([this](uint64_t now_ns) { OnIdle(now_ns); }, 100);
+
+  std::string error = reader_->Start();
+  if (!error.empty()) {
+    StopSupervising();
+    Napi::Error::New(env, "Failed to start heartbeat supervisor: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value HeartbeatSupervisor::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  StopSupervising();
+  return env.Undefined();
+}
+
+void HeartbeatSupervisor::StopSupervising() {
+  if (started_) {
+    started_ = false;
+    if (reader_) {
+      reader_->Stop();
+      reader_.reset();
+    }
+    tsfn_.Release();
+  }
+
+  if (owner_) {
+    owner_->ReleaseEdgeEvents(this);
+  }
+}
+
+Napi::Value HeartbeatSupervisor::GetStatus(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsNumber()) {
+    Napi::TypeError::New(env, "Offset number expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  unsigned int offset = info[0].As<Napi::Number>().Uint32Value();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = std::find_if(lines_.begin(), lines_.end(), [offset](const Line& line) {
+    return line.offset == offset;
+  });
+  if (it == lines_.end()) {
+    return env.Null();
+  }
+
+  const char* state = "waiting";
+  switch (it->state) {
+  case State::kWaiting:
+    break;
+  case State::kAlive:
+    state = "alive";
+    break;
+  case State::kTimeout:
+    state = "timeout";
+    break;
+  case State::kTooFast:
+    state = "too-fast";
+    break;
+  }
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("state", Napi::String::New(env, state));
+  result.Set("heartbeats", Napi::Number::New(env, static_cast<double>(it->heartbeats)));
+  result.Set("timeouts", Napi::Number::New(env, static_cast<double>(it->timeouts)));
+  result.Set("tooFast", Napi::Number::New(env, static_cast<double>(it->too_fast)));
+  result.Set("lastIntervalNs", Napi::Number::New(env, static_cast<double>(it->last_interval_ns)));
+
+  return result;
+}
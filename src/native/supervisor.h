@@ -0,0 +1,77 @@
+#ifndef SUPERVISOR_H
+#define SUPERVISOR_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "line_request.h"
+#include "edge_reader.h"
+
+// Heartbeat supervision of input lines. Every heartbeat edge re-arms the
+// deadline of its line from the kernel timestamp on the edge reader thread,
+// which sleeps until the earliest deadline; only timeout, too-fast and
+// recovery transitions are reported.
+class HeartbeatSupervisor : public Napi::ObjectWrap<HeartbeatSupervisor> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  HeartbeatSupervisor(const Napi::CallbackInfo& info);
+  ~HeartbeatSupervisor();
+
+  // Wrapped methods
+  Napi::Value Add(const Napi::CallbackInfo& info);
+  Napi::Value Remove(const Napi::CallbackInfo& info);
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value GetStatus(const Napi::CallbackInfo& info);
+
+private:
+  enum class State { kWaiting, kAlive, kTimeout, kTooFast };
+  enum class EventType { kTimeout, kTooFast, kRecovered };
+
+  struct Line {
+    unsigned int offset;
+    uint64_t max_interval_ns;
+    uint64_t min_interval_ns;
+    bool on_rising;
+    bool on_falling;
+    State state;
+    uint64_t last_ns;
+    uint64_t deadline_ns;
+    uint64_t heartbeats;
+    uint64_t timeouts;
+    uint64_t too_fast;
+    uint64_t last_interval_ns;
+  };
+
+  struct Event {
+    unsigned int offset;
+    EventType type;
+    uint64_t timestamp_ns;
+    uint64_t interval_ns;
+  };
+
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  std::unique_ptr<EdgeReader> reader_;
+  Napi::ThreadSafeFunction tsfn_;
+  bool started_;
+
+  // Guards the supervised lines against Add/Remove/GetStatus
+  std::mutex mutex_;
+  std::vector<Line> lines_;
+
+  // Internal methods, called from the reader thread
+  void OnEvents(const std::vector<EdgeRecord>& edges);
+  void OnIdle(uint64_t now_ns);
+  void Emit(std::vector<Event>& events);
+  void StopSupervising();
+};
+
+#endif // SUPERVISOR_H
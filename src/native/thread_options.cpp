@@ -0,0 +1,203 @@
+#include "thread_options.h"
+#include <mutex>
+#include <future>
+#include <cerrno>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+std::mutex options_mutex;
+ThreadOptions options = { SCHED_OTHER, 0, {}, false };
+
+std::string PolicyName(int policy) {
+  switch (policy) {
+    case SCHED_FIFO:
+      return "fifo";
+    case SCHED_RR:
+      return "rr";
+    default:
+      return "other";
+  }
+}
+
+std::string ApplyToHandle(pthread_t handle, const ThreadOptions& opts) {
+  struct sched_param param;
+  std::memset(&param, 0, sizeof(param));
+  param.sched_priority = opts.priority;
+
+  int err = pthread_setschedparam(handle, opts.policy, &param);
+  if (err != 0) {
+    std::string message = "Failed to set " + PolicyName(opts.policy) + " scheduling with priority " +
+      std::to_string(opts.priority) + ": " + std::strerror(err);
+    if (err == EPERM) {
+      message += " (requires CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO)";
+    }
+    return message;
+  }
+
+  if (!opts.cpus.empty()) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu : opts.cpus) {
+      CPU_SET(cpu, &set);
+    }
+
+    err = pthread_setaffinity_np(handle, sizeof(set), &set);
+    if (err != 0) {
+      return "Failed to set CPU affinity: " + std::string(std::strerror(err));
+    }
+  }
+
+  return "";
+}
+
+Napi::Value OptionsToObject(Napi::Env env, const ThreadOptions& opts) {
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("policy", Napi::String::New(env, PolicyName(opts.policy)));
+  result.Set("priority", Napi::Number::New(env, opts.priority));
+
+  Napi::Array cpus = Napi::Array::New(env, opts.cpus.size());
+  for (size_t i = 0; i < opts.cpus.size(); i++) {
+    cpus[i] = Napi::Number::New(env, opts.cpus[i]);
+  }
+  result.Set("cpus", cpus);
+  result.Set("lockMemory", Napi::Boolean::New(env, opts.lock_memory));
+
+  return result;
+}
+
+Napi::Value SetThreadOptions(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 1 || !info[0].IsObject()) {
+    Napi::TypeError::New(env, "Thread options object expected").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  Napi::Object obj = info[0].As<Napi::Object>();
+  ThreadOptions opts = GetThreadOptions();
+
+  if (obj.Has("policy") && !obj.Get("policy").IsUndefined()) {
+    std::string policy = obj.Get("policy").ToString().Utf8Value();
+    if (policy == "other") {
+      opts.policy = SCHED_OTHER;
+    } else if (policy == "fifo") {
+      opts.policy = SCHED_FIFO;
+    } else if (policy == "rr") {
+      opts.policy = SCHED_RR;
+    } else {
+      Napi::TypeError::New(env, "Invalid policy: must be 'other', 'fifo', or 'rr'").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  }
+
+  if (obj.Has("priority") && obj.Get("priority").IsNumber()) {
+    opts.priority = obj.Get("priority").As<Napi::Number>().Int32Value();
+  } else if (opts.policy == SCHED_OTHER) {
+    opts.priority = 0;
+  }
+
+  int min_priority = sched_get_priority_min(opts.policy);
+  int max_priority = sched_get_priority_max(opts.policy);
+  if (opts.priority < min_priority || opts.priority > max_priority) {
+    Napi::RangeError::New(env, "Priority for " + PolicyName(opts.policy) + " scheduling must be between " +
+      std::to_string(min_priority) + " and " + std::to_string(max_priority)).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  if (obj.Has("cpus") && obj.Get("cpus").IsArray()) {
+    Napi::Array cpus = obj.Get("cpus").As<Napi::Array>();
+    long num_cpus = sysconf(_SC_NPROCESSORS_CONF);
+
+    opts.cpus.clear();
+    for (uint32_t i = 0; i < cpus.Length(); i++) {
+      Napi::Value val = cpus[i];
+      if (!val.IsNumber()) {
+        Napi::TypeError::New(env, "CPU list must contain only numbers").ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+
+      int cpu = val.As<Napi::Number>().Int32Value();
+      if (cpu < 0 || cpu >= CPU_SETSIZE || cpu >= num_cpus) {
+        Napi::RangeError::New(env, "Invalid CPU index: " + std::to_string(cpu)).ThrowAsJavaScriptException();
+        return env.Undefined();
+      }
+      opts.cpus.push_back(cpu);
+    }
+  }
+
+  if (obj.Has("lockMemory") && obj.Get("lockMemory").IsBoolean()) {
+    opts.lock_memory = obj.Get("lockMemory").As<Napi::Boolean>().Value();
+  }
+
+  // Probe the settings on a scratch thread so missing privileges are reported
+  // here instead of when the first watcher starts
+  std::promise<void> release;
+  std::shared_future<void> released = release.get_future().share();
+  std::thread probe([released]() { released.wait(); });
+  std::string error = ApplyToHandle(probe.native_handle(), opts);
+  release.set_value();
+  probe.join();
+
+  if (!error.empty()) {
+    Napi::Error::New(env, error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  // Memory locking is process-wide, so it is applied right away
+  bool was_locked = GetThreadOptions().lock_memory;
+  if (opts.lock_memory && !was_locked) {
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0) {
+      std::string message = "Failed to lock memory: " + std::string(std::strerror(errno));
+      if (errno == EPERM || errno == ENOMEM) {
+        message += " (requires CAP_IPC_LOCK or a sufficient RLIMIT_MEMLOCK)";
+      }
+      Napi::Error::New(env, message).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+  } else if (!opts.lock_memory && was_locked) {
+    munlockall();
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(options_mutex);
+    options = opts;
+  }
+
+  return OptionsToObject(env, opts);
+}
+
+Napi::Value GetThreadOptionsWrapped(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  return OptionsToObject(env, GetThreadOptions());
+}
+
+} // namespace
+
+void InitThreadOptions(Napi::Env env, Napi::Object exports) {
+  exports.Set("setThreadOptions", Napi::Function::New(env, SetThreadOptions, "setThreadOptions"));
+  exports.Set("getThreadOptions", Napi::Function::New(env, GetThreadOptionsWrapped, "getThreadOptions"));
+}
+
+ThreadOptions GetThreadOptions() {
+  std::lock_guard<std::mutex> lock(options_mutex);
+  return options;
+}
+
+std::string ApplyThreadOptions(std::thread& thread) {
+  ThreadOptions opts = GetThreadOptions();
+
+  // Nothing to do for default scheduling without pinning
+  if (opts.policy == SCHED_OTHER && opts.cpus.empty()) {
+    return "";
+  }
+
+  return ApplyToHandle(thread.native_handle(), opts);
+}
@@ -0,0 +1,25 @@
+#ifndef THREAD_OPTIONS_H
+#define THREAD_OPTIONS_H
+
+#include <napi.h>
+#include <thread>
+#include <string>
+#include <vector>
+
+// Scheduling settings applied to every native thread that services GPIO lines
+struct ThreadOptions {
+  int policy;
+  int priority;
+  std::vector<int> cpus;
+  bool lock_memory;
+};
+
+void InitThreadOptions(Napi::Env env, Napi::Object exports);
+
+// Returns a copy of the process-wide thread options
+ThreadOptions GetThreadOptions();
+
+// Applies the process-wide options to a running thread, returns an error message on failure
+std::string ApplyThreadOptions(std::thread& thread);
+
+#endif // THREAD_OPTIONS_H
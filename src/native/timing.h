@@ -0,0 +1,47 @@
+#ifndef TIMING_H
+#define TIMING_H
+
+#include <cstdint>
+#include <cerrno>
+#include <time.h>
+
+// Edge event timestamps use CLOCK_MONOTONIC by default, so all native
+// timing is done on the same clock to keep them comparable.
+
+inline uint64_t ClockNowNs(clockid_t clock) {
+  struct timespec ts;
+  clock_gettime(clock, &ts);
+  return static_cast<uint64_t>(ts.tv_sec) * 1000000000ULL + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+inline uint64_t MonotonicNowNs() {
+  return ClockNowNs(CLOCK_MONOTONIC);
+}
+
+// Sleep until an absolute deadline on the given clock, retrying on signals.
+// CLOCK_REALTIME deadlines follow clock steps made while sleeping.
+inline void ClockSleepUntilNs(clockid_t clock, uint64_t deadline_ns) {
+  struct timespec ts;
+  ts.tv_sec = static_cast<time_t>(deadline_ns / 1000000000ULL);
+  ts.tv_nsec = static_cast<long>(deadline_ns % 1000000000ULL);
+  while (clock_nanosleep(clock, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+  }
+}
+
+// Sleep until an absolute CLOCK_MONOTONIC deadline, retrying on signals
+inline void SleepUntilNs(uint64_t deadline_ns) {
+  ClockSleepUntilNs(CLOCK_MONOTONIC, deadline_ns);
+}
+
+// Sleep until shortly before the deadline, then spin for the rest. Used for
+// bit-level timing where clock_nanosleep wake-up latency would dominate.
+inline void PreciseSleepUntilNs(uint64_t deadline_ns, uint64_t spin_ns = 50000) {
+  uint64_t now = MonotonicNowNs();
+  if (deadline_ns > now + spin_ns) {
+    SleepUntilNs(deadline_ns - spin_ns);
+  }
+  while (MonotonicNowNs() < deadline_ns) {
+  }
+}
+
+#endif // TIMING_H
@@ -0,0 +1,409 @@
+#include "vcd_writer.h"
+#include "thread_options.h"
+#include "timing.h"
+#include <algorithm>
+#include <chrono>
+#include <ctime>
+
+Napi::FunctionReference VcdWriter::constructor;
+
+namespace {
+
+// Changes wait this long before they are written, so an edge read after a
+// snapshot taken later than it is still written first
+const uint64_t kReorderNs = 50000000;
+
+// Interval at which the reader checks whether the request was released
+const int kReleasePollMs = 100;
+
+// VCD identifiers are short strings of printable ASCII characters
+std::string MakeIdentifier(size_t index) {
+  std::string id;
+  do {
+    id += static_cast<char>('!' + (index % 94));
+    index /= 94;
+  } while (index > 0);
+  return id;
+}
+
+// Signal and scope names must not contain whitespace
+std::string SanitizeName(const std::string& name) {
+  std::string result = name;
+  for (auto& c : result) {
+    if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+      c = '_';
+    }
+  }
+  return result;
+}
+
+} // namespace
+
+Napi::Object VcdWriter::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "VcdWriter", {
+    InstanceMethod("snapshot", &VcdWriter::Snapshot),
+    InstanceMethod("getStats", &VcdWriter::GetStats),
+    InstanceMethod("close", &VcdWriter::Close)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("VcdWriter", func);
+  return exports;
+}
+
+VcdWriter::VcdWriter(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<VcdWriter>(info), owner_(nullptr), file_(nullptr), writing_(false), start_ns_(0), last_time_(0),
+    time_written_(false), edges_(0), snapshots_(0), changes_written_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsString()) {
+    Napi::TypeError::New(env, "LineRequest object and file path expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  Napi::Object requestObj = info[0].As<Napi::Object>();
+  if (!requestObj.InstanceOf(LineRequest::constructor.Value())) {
+    Napi::TypeError::New(env, "First argument must be a LineRequest instance").ThrowAsJavaScriptException();
+    return;
+  }
+
+  LineRequest* lineRequest = Napi::ObjectWrap<LineRequest>::Unwrap(requestObj);
+  std::shared_ptr<gpiod::line_request> request = lineRequest->GetRequest();
+  if (!request) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return;
+  }
+  offsets_ = lineRequest->GetOffsets();
+
+  std::string path = info[1].As<Napi::String>().Utf8Value();
+
+  Napi::Array names = Napi::Array::New(env);
+  if (info.Length() > 2 && info[2].IsObject()) {
+    Napi::Object options = info[2].As<Napi::Object>();
+    if (options.Has("names") && options.Get("names").IsArray()) {
+      names = options.Get("names").As<Napi::Array>();
+    }
+    if (options.Has("scope") && options.Get("scope").IsString()) {
+      scope_ = options.Get("scope").As<Napi::String>().Utf8Value();
+    }
+  }
+
+  try {
+    std::shared_ptr<gpiod::chip> chip = lineRequest->GetChip()->GetChip();
+
+    if (scope_.empty()) {
+      scope_ = chip ? chip->get_info().label() : "gpio";
+    }
+
+    // Signal names default to the line names reported by the kernel
+    for (size_t i = 0; i < offsets_.size(); i++) {
+      std::string name;
+      if (i < names.Length() && Napi::Value(names[i]).IsString()) {
+        name = Napi::Value(names[i]).As<Napi::String>().Utf8Value();
+      } else if (chip) {
+        name = chip->get_line_info(offsets_[i]).name();
+      }
+      if (name.empty()) {
+        name = "line" + std::to_string(offsets_[i]);
+      }
+
+      index_[offsets_[i]] = i;
+      names_.push_back(SanitizeName(name));
+      ids_.push_back(MakeIdentifier(i));
+    }
+
+    gpiod::line::values initial = request->get_values();
+
+    file_ = std::fopen(path.c_str(), "w");
+    if (!file_) {
+      Napi::Error::New(env, "Failed to open VCD file: " + path).ThrowAsJavaScriptException();
+      return;
+    }
+    std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+
+    start_ns_ = MonotonicNowNs();
+    WriteHeader(initial);
+  } catch (const std::exception& e) {
+    if (file_) {
+      std::fclose(file_);
+      file_ = nullptr;
+    }
+    Napi::Error::New(env, "Failed to start VCD capture: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return;
+  }
+
+  if (!lineRequest->ClaimEdgeEvents(env, this, "VcdWriter")) {
+    std::fclose(file_);
+    file_ = nullptr;
+    return;
+  }
+  owner_ = lineRequest;
+  owner_ref_ = Napi::Persistent(requestObj);
+
+  // Start the writer before the reader so no event is queued without a consumer
+  writing_ = true;
+  writer_thread_ = std::thread(&VcdWriter::WriterThread, this);
+
+  std::string thread_error = ApplyThreadOptions(writer_thread_);
+  if (!thread_error.empty()) {
+    Stop();
+    Napi::Error::New(env, "Failed to start VCD capture: " + thread_error).ThrowAsJavaScriptException();
+    return;
+  }
+
+  // The reader keeps its own reference to the request until its thread ends
+  reader_ = std::make_unique<EdgeReader>(
+    request,
+    [this](const std::vector<EdgeRecord>& events) {
+      std::vector<Change> changes;
+      changes.reserve(events.size());
+      for (const auto& event : events) {
+        auto it = index_.find(event.offset);
+        if (it != index_.end()) {
+          changes.push_back({event.timestamp_ns, it->second, event.rising, true});
+        }
+      }
+      edges_ += events.size();
+      Enqueue(changes);
+    },
+    [this](const std::string& error) {
+      SetError(error);
+    }
+  );
+  reader_->SetIdleHandler([this](uint64_t) { CheckReleased(); }, kReleasePollMs);
+
+  std::string error = reader_->Start();
+  if (!error.empty()) {
+    Stop();
+    Napi::Error::New(env, "Failed to start VCD capture: " + error).ThrowAsJavaScriptException();
+    return;
+  }
+}
+
+VcdWriter::~VcdWriter() {
+  Stop();
+}
+
+void VcdWriter::WriteHeader(const gpiod::line::values& initial) {
+  char date[64] = {0};
+  std::time_t now = std::time(nullptr);
+  std::strftime(date, sizeof(date), "%Y-%m-%d %H:%M:%S", std::localtime(&now));
+
+  std::fprintf(file_, "$date %s $end\n", date);
+  std::fprintf(file_, "$version libgpiod2-node $end\n");
+  std::fprintf(file_, "$timescale 1ns $end\n");
+  std::fprintf(file_, "$scope module %s $end\n", SanitizeName(scope_).c_str());
+  for (size_t i = 0; i < names_.size(); i++) {
+    std::fprintf(file_, "$var wire 1 %s %s $end\n", ids_[i].c_str(), names_[i].c_str());
+  }
+  std::fprintf(file_, "$upscope $end\n");
+  std::fprintf(file_, "$enddefinitions $end\n");
+
+  std::fprintf(file_, "#0\n$dumpvars\n");
+  last_values_.resize(names_.size(), 0);
+  for (size_t i = 0; i < names_.size() && i < initial.size(); i++) {
+    last_values_[i] = initial[i] == gpiod::line::value::ACTIVE ? 1 : 0;
+    std::fprintf(file_, "%d%s\n", last_values_[i], ids_[i].c_str());
+  }
+  std::fprintf(file_, "$end\n");
+  time_written_ = true;
+}
+
+void VcdWriter::Enqueue(std::vector<Change>& changes) {
+  if (changes.empty()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    queue_.insert(queue_.end(), changes.begin(), changes.end());
+  }
+  queue_cv_.notify_one();
+}
+
+void VcdWriter::WriterThread() {
+  std::vector<Change> incoming;
+  std::vector<Change> pending;
+  std::vector<Change> ready;
+  auto earlier = [](const Change& a, const Change& b) { return a.timestamp_ns < b.timestamp_ns; };
+
+  while (true) {
+    bool stopping;
+    {
+      std::unique_lock<std::mutex> lock(queue_mutex_);
+      auto wake = [this] { return !queue_.empty() || !writing_; };
+      if (pending.empty()) {
+        queue_cv_.wait(lock, wake);
+      } else {
+        uint64_t due = pending.front().timestamp_ns + kReorderNs;
+        uint64_t now = MonotonicNowNs();
+        queue_cv_.wait_for(lock, std::chrono::nanoseconds(due > now ? due - now : 0), wake);
+      }
+
+      stopping = !writing_;
+      incoming.swap(queue_);
+    }
+
+    // Batches are sorted on their own and merged into the held changes;
+    // equal timestamps keep their arrival order
+    if (!incoming.empty()) {
+      std::stable_sort(incoming.begin(), incoming.end(), earlier);
+      size_t held = pending.size();
+      pending.insert(pending.end(), incoming.begin(), incoming.end());
+      std::inplace_merge(pending.begin(), pending.begin() + held, pending.end(), earlier);
+      incoming.clear();
+    }
+
+    // Everything is written when the capture stops
+    uint64_t now = MonotonicNowNs();
+    auto split = pending.end();
+    if (!stopping) {
+      uint64_t horizon = now > kReorderNs ? now - kReorderNs : 0;
+      split = std::partition_point(pending.begin(), pending.end(), [horizon](const Change& change) {
+        return change.timestamp_ns <= horizon;
+      });
+    }
+    ready.assign(pending.begin(), split);
+    pending.erase(pending.begin(), split);
+
+    WriteChanges(ready);
+    ready.clear();
+
+    if (stopping) {
+      break;
+    }
+  }
+
+  std::fflush(file_);
+}
+
+void VcdWriter::WriteChanges(const std::vector<Change>& changes) {
+  for (const auto& change : changes) {
+    int value = change.value ? 1 : 0;
+    // A snapshot can read a level before the edge that set it is read, so
+    // only snapshot samples are dropped when they repeat the last value
+    if (!change.edge && last_values_[change.index] == value) {
+      continue;
+    }
+    last_values_[change.index] = value;
+
+    // VCD time must never go backwards; only a change that arrives later
+    // than the reorder window is moved up to the last written time
+    uint64_t time = change.timestamp_ns > start_ns_ ? change.timestamp_ns - start_ns_ : 0;
+    if (time < last_time_) {
+      time = last_time_;
+    }
+
+    if (!time_written_ || time != last_time_) {
+      std::fprintf(file_, "#%llu\n", static_cast<unsigned long long>(time));
+      last_time_ = time;
+      time_written_ = true;
+    }
+
+    std::fprintf(file_, "%d%s\n", value, ids_[change.index].c_str());
+    changes_written_++;
+  }
+}
+
+void VcdWriter::CheckReleased() {
+  // Stopping the reader from its own thread ends it without a join, which
+  // drops its reference to the request and frees the released lines
+  if (owner_->IsReleased() && reader_->IsRunning()) {
+    SetError("line request was released");
+    reader_->Stop();
+  }
+}
+
+void VcdWriter::SetError(const std::string& error) {
+  std::lock_guard<std::mutex> lock(error_mutex_);
+  error_ = error;
+}
+
+void VcdWriter::Stop() {
+  if (reader_) {
+    reader_->Stop();
+    reader_.reset();
+  }
+
+  if (writing_) {
+    {
+      std::lock_guard<std::mutex> lock(queue_mutex_);
+      writing_ = false;
+    }
+    queue_cv_.notify_one();
+
+    if (writer_thread_.joinable()) {
+      writer_thread_.join();
+    }
+  }
+
+  if (file_) {
+    std::fclose(file_);
+    file_ = nullptr;
+  }
+
+  if (owner_) {
+    owner_->ReleaseEdgeEvents(this);
+  }
+}
+
+Napi::Value VcdWriter::Snapshot(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (!writing_) {
+    Napi::Error::New(env, "VCD writer is closed").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  try {
+    uint64_t timestamp;
+    gpiod::line::values values;
+    {
+      std::lock_guard<std::mutex> lock(owner_->BusMutex());
+      timestamp = MonotonicNowNs();
+      values = owner_->ActiveRequest()->get_values();
+    }
+
+    std::vector<Change> changes;
+    for (size_t i = 0; i < values.size() && i < offsets_.size(); i++) {
+      changes.push_back({timestamp, i, values[i] == gpiod::line::value::ACTIVE, false});
+    }
+    snapshots_++;
+    Enqueue(changes);
+
+    return env.Undefined();
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to take snapshot: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+}
+
+Napi::Value VcdWriter::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("edges", Napi::Number::New(env, static_cast<double>(edges_.load())));
+  result.Set("snapshots", Napi::Number::New(env, static_cast<double>(snapshots_.load())));
+  result.Set("changesWritten", Napi::Number::New(env, static_cast<double>(changes_written_.load())));
+
+  std::lock_guard<std::mutex> lock(error_mutex_);
+  result.Set("error", error_.empty() ? env.Null() : Napi::String::New(env, error_));
+
+  return result;
+}
+
+Napi::Value VcdWriter::Close(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Stop();
+
+  return GetStats(info);
+}
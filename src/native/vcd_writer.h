@@ -0,0 +1,81 @@
+#ifndef VCD_WRITER_H
+#define VCD_WRITER_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdio>
+#include <cstdint>
+#include "line_request.h"
+#include "edge_reader.h"
+
+class VcdWriter : public Napi::ObjectWrap<VcdWriter> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  VcdWriter(const Napi::CallbackInfo& info);
+  ~VcdWriter();
+
+  // Wrapped methods
+  Napi::Value Snapshot(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+  Napi::Value Close(const Napi::CallbackInfo& info);
+
+private:
+  struct Change {
+    uint64_t timestamp_ns;
+    size_t index;
+    bool value;
+    // Edges are always written, snapshot samples only when they change a value
+    bool edge;
+  };
+
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+  std::vector<unsigned int> offsets_;
+  std::map<unsigned int, size_t> index_;
+  std::vector<std::string> names_;
+  std::vector<std::string> ids_;
+  std::string scope_;
+  FILE* file_;
+  std::unique_ptr<EdgeReader> reader_;
+
+  // Writer thread
+  std::thread writer_thread_;
+  std::atomic<bool> writing_;
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::vector<Change> queue_;
+
+  // Only touched by the writer thread once it is running. Changes are held
+  // back for a short window and written in timestamp order.
+  uint64_t start_ns_;
+  uint64_t last_time_;
+  bool time_written_;
+  std::vector<int> last_values_;
+
+  std::atomic<uint64_t> edges_;
+  std::atomic<uint64_t> snapshots_;
+  std::atomic<uint64_t> changes_written_;
+  std::mutex error_mutex_;
+  std::string error_;
+
+  // Internal methods
+  void WriteHeader(const gpiod::line::values& initial);
+  void Enqueue(std::vector<Change>& changes);
+  void WriterThread();
+  void WriteChanges(const std::vector<Change>& changes);
+  void CheckReleased();
+  void SetError(const std::string& error);
+  void Stop();
+};
+
+#endif // VCD_WRITER_H
@@ -0,0 +1,171 @@
+#include "watchdog.h"
+#include "timing.h"
+#include "engine_utils.h"
+
+Napi::FunctionReference WatchdogKicker::constructor;
+
+Napi::Object WatchdogKicker::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "WatchdogKicker", {
+    InstanceMethod("feed", &WatchdogKicker::Feed),
+    InstanceMethod("start", &WatchdogKicker::Start),
+    InstanceMethod("stop", &WatchdogKicker::Stop),
+    InstanceMethod("getStats", &WatchdogKicker::GetStats)
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("WatchdogKicker", func);
+  return exports;
+}
+
+WatchdogKicker::WatchdogKicker(const Napi::CallbackInfo& info)
+  : Napi::ObjectWrap<WatchdogKicker>(info), owner_(nullptr), line_(0), period_ns_(0), feed_timeout_ns_(0),
+    spin_ns_(0), last_feed_ns_(0), feeds_(0), level_(false), kicks_(0), starved_(0) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+    Napi::TypeError::New(env, "LineRequest object and options object expected").ThrowAsJavaScriptException();
+    return;
+  }
+
+  owner_ = UnwrapLineRequest(env, info[0]);
+  if (!owner_) {
+    return;
+  }
+  owner_ref_ = Napi::Persistent(info[0].As<Napi::Object>());
+
+  Napi::Object options = info[1].As<Napi::Object>();
+  int line = -1;
+  if (!ReadLineOffset(env, options, "line", owner_->GetOffsets(), true, line)) {
+    return;
+  }
+  line_ = static_cast<unsigned int>(line);
+
+  double period_ms = ReadNumber(options, "periodMs", 100);
+  double feed_timeout_ms = ReadNumber(options, "feedTimeoutMs", 1000);
+  double spin_us = ReadNumber(options, "spinUs", 0);
+  if (period_ms <= 0 || feed_timeout_ms <= 0 || spin_us < 0) {
+    Napi::RangeError::New(env, "Invalid watchdog timing: expected periodMs > 0, feedTimeoutMs > 0 and spinUs >= 0").ThrowAsJavaScriptException();
+    return;
+  }
+  period_ns_ = static_cast<uint64_t>(period_ms * 1e6);
+  feed_timeout_ns_ = static_cast<uint64_t>(feed_timeout_ms * 1e6);
+  spin_ns_ = static_cast<uint64_t>(spin_us * 1e3);
+}
+
+WatchdogKicker::~WatchdogKicker() {
+  task_.Stop();
+}
+
+bool WatchdogKicker::Tick() {
+  // Without a recent feed the application is considered hung
+  uint64_t now = MonotonicNowNs();
+  if (now - last_feed_ns_.load(std::memory_order_relaxed) > feed_timeout_ns_) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    starved_++;
+    return true;
+  }
+
+  try {
+    {
+      // release() drops the request under the bus lock, so no kick is
+      // issued on a released request
+      std::lock_guard<std::mutex> lock(owner_->BusMutex());
+      std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+      if (!request) {
+        throw std::runtime_error("line request is not active");
+      }
+
+      level_ = !level_;
+      request->set_value(line_, ToValue(level_));
+    }
+    owner_->InvalidateShadow();
+  } catch (const std::exception& e) {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    error_ = e.what();
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  kicks_++;
+  return true;
+}
+
+Napi::Value WatchdogKicker::Feed(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  last_feed_ns_.store(MonotonicNowNs(), std::memory_order_relaxed);
+  feeds_++;
+  return env.Undefined();
+}
+
+Napi::Value WatchdogKicker::Start(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!request) {
+    Napi::Error::New(env, "Line request is not active").ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  task_.Stop();
+
+  {
+    std::lock_guard<std::mutex> lock(stats_mutex_);
+    kicks_ = 0;
+    starved_ = 0;
+    error_.clear();
+  }
+
+  // Starting counts as a feed; toggling continues from the current level
+  try {
+    level_ = request->get_value(line_) == gpiod::line::value::ACTIVE;
+  } catch (const std::exception& e) {
+    Napi::Error::New(env, "Failed to read watchdog line: " + std::string(e.what())).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+  last_feed_ns_.store(MonotonicNowNs(), std::memory_order_relaxed);
+
+  std::string error = task_.Start(period_ns_, [this]() { return Tick(); }, spin_ns_);
+  if (!error.empty()) {
+    Napi::Error::New(env, "Failed to start watchdog thread: " + error).ThrowAsJavaScriptException();
+    return env.Undefined();
+  }
+
+  return env.Undefined();
+}
+
+Napi::Value WatchdogKicker::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  task_.Stop();
+  return env.Undefined();
+}
+
+Napi::Value WatchdogKicker::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  uint64_t last_feed = last_feed_ns_.load(std::memory_order_relaxed);
+  uint64_t now = MonotonicNowNs();
+
+  Napi::Object result = Napi::Object::New(env);
+  result.Set("running", Napi::Boolean::New(env, task_.IsRunning()));
+  result.Set("feeds", Napi::Number::New(env, static_cast<double>(feeds_.load())));
+  result.Set("lastFeedAgeNs", last_feed == 0 ? env.Null() : Napi::Number::New(env, static_cast<double>(now > last_feed ? now - last_feed : 0)));
+  result.Set("timing", PeriodicStatsToObject(env, task_.GetStats()));
+
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  result.Set("kicks", Napi::Number::New(env, static_cast<double>(kicks_)));
+  result.Set("starved", Napi::Number::New(env, static_cast<double>(starved_)));
+  result.Set("error", error_.empty() ? env.Null() : Napi::String::New(env, error_));
+
+  return result;
+}
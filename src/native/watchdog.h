@@ -0,0 +1,57 @@
+#ifndef WATCHDOG_H
+#define WATCHDOG_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <cstdint>
+#include "line_request.h"
+#include "periodic_task.h"
+
+// Kicks an external hardware watchdog by toggling a line from a native
+// timing thread, so garbage collection pauses do not delay the kicks. The
+// line is only toggled while JavaScript fed the kicker recently; a hung
+// application stops the kicks and lets the watchdog reset the system.
+class WatchdogKicker : public Napi::ObjectWrap<WatchdogKicker> {
+public:
+  static Napi::Object Init(Napi::Env env, Napi::Object exports);
+  static Napi::FunctionReference constructor;
+
+  WatchdogKicker(const Napi::CallbackInfo& info);
+  ~WatchdogKicker();
+
+  // Wrapped methods
+  Napi::Value Feed(const Napi::CallbackInfo& info);
+  Napi::Value Start(const Napi::CallbackInfo& info);
+  Napi::Value Stop(const Napi::CallbackInfo& info);
+  Napi::Value GetStats(const Napi::CallbackInfo& info);
+
+private:
+  LineRequest* owner_;
+  Napi::ObjectReference owner_ref_;
+
+  unsigned int line_;
+  uint64_t period_ns_;
+  uint64_t feed_timeout_ns_;
+  uint64_t spin_ns_;
+
+  // CLOCK_MONOTONIC time of the last feed, written by JS
+  std::atomic<uint64_t> last_feed_ns_;
+  std::atomic<uint64_t> feeds_;
+
+  // Only used by the timing thread
+  bool level_;
+  PeriodicTask task_;
+
+  std::mutex stats_mutex_;
+  uint64_t kicks_;
+  uint64_t starved_;
+  std::string error_;
+
+  // Internal methods
+  bool Tick();
+};
+
+#endif // WATCHDOG_H
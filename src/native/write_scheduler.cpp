@@ -0,0 +1,200 @@
+#include "write_scheduler.h"
+#include "line_request.h"
+#include "thread_options.h"
+#include "timing.h"
+#include <algorithm>
+#include <chrono>
+#include <limits>
+
+// Writes are taken from the queue this long before their deadline and
+// approached with clock_nanosleep on their own clock
+const uint64_t kApproachNs = 1000000;
+
+// Bounds each wait so realtime deadlines follow clock steps
+const uint64_t kMaxWaitNs = 100000000;
+
+WriteScheduler::WriteScheduler(LineRequest* owner)
+  : owner_(owner), running_(false), next_id_(1) {
+}
+
+WriteScheduler::~WriteScheduler() {
+  Shutdown();
+}
+
+std::string WriteScheduler::Start(Napi::Env env) {
+  // Settles the promises of finished writes; the function itself is unused
+  tsfn_ = Napi::ThreadSafeFunction::New(
+    env,
+    Napi::Function::New(env, [](const Napi::CallbackInfo&) {}),
+    "GPIO Scheduled Write Callback",
+    0,
+    1
+  );
+  tsfn_.Unref(env);
+
+  running_ = true;
+  thread_ = std::thread(&WriteScheduler::Run, this);
+
+  std::string error = ApplyThreadOptions(thread_);
+  if (!error.empty()) {
+    Shutdown();
+  }
+  return error;
+}
+
+Napi::Promise WriteScheduler::Schedule(Napi::Env env, Napi::Object self, Write write) {
+  write.id = next_id_++;
+
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+  if (pending_.empty()) {
+    tsfn_.Ref(env);
+    self_ref_ = Napi::Persistent(self);
+  }
+  pending_.emplace(write.id, deferred);
+
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    queue_.push_back(std::move(write));
+  }
+  queue_cv_.notify_one();
+
+  return deferred.Promise();
+}
+
+void WriteScheduler::Cancel(Napi::Env env, const std::string& reason) {
+  std::vector<Write> cancelled;
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    cancelled.swap(queue_);
+  }
+
+  Shutdown();
+
+  for (const Write& write : cancelled) {
+    auto it = pending_.find(write.id);
+    if (it != pending_.end()) {
+      it->second.Reject(Napi::Error::New(env, reason).Value());
+      pending_.erase(it);
+    }
+  }
+
+  Settled(env);
+}
+
+void WriteScheduler::Run() {
+  std::unique_lock<std::mutex> lock(queue_mutex_);
+  while (running_) {
+    if (queue_.empty()) {
+      queue_cv_.wait(lock);
+      continue;
+    }
+
+    // Deadlines are compared by the time left on their own clock, so
+    // realtime writes follow clock steps
+    auto next = queue_.begin();
+    uint64_t next_left = std::numeric_limits<uint64_t>::max();
+    for (auto it = queue_.begin(); it != queue_.end(); ++it) {
+      uint64_t now = ClockNowNs(it->clock);
+      uint64_t left = it->time_ns > now ? it->time_ns - now : 0;
+      if (left < next_left) {
+        next = it;
+        next_left = left;
+      }
+    }
+
+    uint64_t lead = next->spin_ns + kApproachNs;
+    if (next_left > lead) {
+      queue_cv_.wait_for(lock, std::chrono::nanoseconds(std::min(next_left - lead, kMaxWaitNs)));
+      continue;
+    }
+
+    Write write = std::move(*next);
+    queue_.erase(next);
+
+    lock.unlock();
+    Execute(write);
+    lock.lock();
+  }
+}
+
+void WriteScheduler::Execute(const Write& write) {
+  Result result = {write.time_ns, 0, 0, ""};
+
+  // A deadline that already passed is written at once and shows as late
+  if (write.time_ns > ClockNowNs(write.clock) + write.spin_ns) {
+    ClockSleepUntilNs(write.clock, write.time_ns - write.spin_ns);
+  }
+  while (ClockNowNs(write.clock) < write.time_ns) {
+  }
+
+  // Release() stops this thread before it drops the request, so a write
+  // cancelled during the approach is not issued
+  std::shared_ptr<gpiod::line_request> request = owner_->GetRequest();
+  if (!running_ || !request) {
+    result.error = "Scheduled write cancelled: line request was released";
+  } else {
+    try {
+      // The bus lock is not taken: waiting for an engine job would make
+      // the write late and stall release(), which joins this thread. The
+      // time is sampled just before the ioctl; the lines change while it runs
+      result.written_ns = ClockNowNs(write.clock);
+      request->set_values(write.mappings);
+      result.duration_ns = ClockNowNs(write.clock) - result.written_ns;
+    } catch (const std::exception& e) {
+      result.error = "Scheduled write failed: " + std::string(e.what());
+    }
+    owner_->InvalidateShadow();
+  }
+
+  Complete(write.id, result);
+}
+
+void WriteScheduler::Complete(uint64_t id, const Result& result) {
+  tsfn_.BlockingCall([this, id, result](Napi::Env env, Napi::Function) {
+    auto it = pending_.find(id);
+    if (it == pending_.end()) {
+      return;
+    }
+
+    if (result.error.empty()) {
+      uint64_t lateness = result.written_ns > result.scheduled_ns ? result.written_ns - result.scheduled_ns : 0;
+      Napi::Object value = Napi::Object::New(env);
+      value.Set("scheduledNs", Napi::BigInt::New(env, result.scheduled_ns));
+      value.Set("writtenNs", Napi::BigInt::New(env, result.written_ns));
+      value.Set("latenessNs", Napi::Number::New(env, static_cast<double>(lateness)));
+      value.Set("ioctlNs", Napi::Number::New(env, static_cast<double>(result.duration_ns)));
+      it->second.Resolve(value);
+    } else {
+      it->second.Reject(Napi::Error::New(env, result.error).Value());
+    }
+    pending_.erase(it);
+    Settled(env);
+  });
+}
+
+void WriteScheduler::Settled(Napi::Env env) {
+  if (pending_.empty()) {
+    // The thread-safe function is released once the scheduler is shut down
+    if (running_) {
+      tsfn_.Unref(env);
+    }
+    self_ref_.Reset();
+  }
+}
+
+void WriteScheduler::Shutdown() {
+  {
+    std::lock_guard<std::mutex> lock(queue_mutex_);
+    if (!running_ && !thread_.joinable()) {
+      return;
+    }
+    running_ = false;
+  }
+  queue_cv_.notify_all();
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+
+  tsfn_.Release();
+}
@@ -0,0 +1,78 @@
+#ifndef WRITE_SCHEDULER_H
+#define WRITE_SCHEDULER_H
+
+#include <napi.h>
+#include <gpiod.hpp>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <time.h>
+
+class LineRequest;
+
+// Writes values at absolute clock times for one line request. A single
+// thread owns the queue, waits for the earliest deadline and settles the
+// promises through a thread-safe function, so pending writes occupy
+// neither the libuv pool nor a busy-waiting thread.
+class WriteScheduler {
+public:
+  struct Write {
+    uint64_t id;
+    clockid_t clock;
+    uint64_t time_ns;
+    uint64_t spin_ns;
+    gpiod::line::value_mappings mappings;
+  };
+
+  explicit WriteScheduler(LineRequest* owner);
+  ~WriteScheduler();
+
+  // Returns an error message if the thread options could not be applied
+  std::string Start(Napi::Env env);
+
+  // Queues a write and returns a promise of its result. The wrapper of the
+  // request is kept alive until all writes are settled. Must be called from
+  // the JavaScript thread.
+  Napi::Promise Schedule(Napi::Env env, Napi::Object self, Write write);
+
+  // Rejects the queued writes with the reason and stops the thread; a write
+  // that is already being issued finishes first. Must be called from the
+  // JavaScript thread.
+  void Cancel(Napi::Env env, const std::string& reason);
+
+private:
+  struct Result {
+    uint64_t scheduled_ns;
+    uint64_t written_ns;
+    uint64_t duration_ns;
+    std::string error;
+  };
+
+  LineRequest* owner_;
+
+  std::thread thread_;
+  std::atomic<bool> running_;
+  std::mutex queue_mutex_;
+  std::condition_variable queue_cv_;
+  std::vector<Write> queue_;
+
+  // Promises of pending writes, only touched on the JavaScript thread
+  Napi::ThreadSafeFunction tsfn_;
+  std::map<uint64_t, Napi::Promise::Deferred> pending_;
+  Napi::ObjectReference self_ref_;
+  uint64_t next_id_;
+
+  // Internal methods
+  void Run();
+  void Execute(const Write& write);
+  void Complete(uint64_t id, const Result& result);
+  void Settled(Napi::Env env);
+  void Shutdown();
+};
+
+#endif // WRITE_SCHEDULER_H
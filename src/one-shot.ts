@@ -0,0 +1,118 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for delayed one-shot options
+const oneShotOptionsSchema = z.object({
+  trigger: z.number().int().nonnegative(),
+  output: z.number().int().nonnegative(),
+  edge: z.enum(['rising', 'falling', 'both']).default('rising'),
+  widthUs: z.number().positive().default(100),
+  maxDelayUs: z.number().nonnegative().default(10000),
+  maxLateUs: z.number().nonnegative().default(200),
+  spinUs: z.number().nonnegative().default(100)
+});
+
+/**
+ * Options for a delayed one-shot
+ */
+export interface DelayedOneShotOptions {
+  /** Offset of the trigger input (e.g. a zero-cross detector), requested with edge detection */
+  trigger: number;
+  /** Offset of the pulse output (e.g. a TRIAC gate driver) */
+  output: number;
+  /** Trigger edges, defaults to 'rising' */
+  edge?: 'rising' | 'falling' | 'both';
+  /** Width of the output pulse in microseconds, defaults to 100 */
+  widthUs?: number;
+  /** Longest delay accepted in microseconds, defaults to 10000 (a 50 Hz half-cycle) */
+  maxDelayUs?: number;
+  /** Skip a pulse that would start later than this after its deadline, defaults to 200 µs */
+  maxLateUs?: number;
+  /** Busy-wait before each edge for lower jitter, defaults to 100 µs */
+  spinUs?: number;
+}
+
+/**
+ * Timing statistics of a delayed one-shot
+ */
+export interface DelayedOneShotStats {
+  /** Whether the timing thread is running */
+  running: boolean;
+  /** Trigger edges seen */
+  triggers: number;
+  /** Pulses emitted */
+  pulses: number;
+  /** Pulses skipped because their deadline had passed by more than maxLateUs */
+  missed: number;
+  /** Largest delay of a pulse start after its deadline in nanoseconds */
+  maxJitterNs: number;
+  /** Mean delay of a pulse start after its deadline in nanoseconds */
+  meanJitterNs: number;
+  /** Time between the last two trigger edges in nanoseconds */
+  periodNs: number;
+  /** Error that stopped the timing thread */
+  error: string | null;
+}
+
+/**
+ * Emits an output pulse at a programmable delay after each trigger edge,
+ * e.g. for TRIAC phase control synchronized to mains zero-crosses
+ *
+ * The delay is measured from the kernel timestamp of the trigger edge and the
+ * pulse is timed with absolute sleeps on the native edge reader thread.
+ * Setting the delay is a lock-free store picked up by the next trigger.
+ */
+export class DelayedOneShot {
+  private _nativeOneShot: any;
+
+  /**
+   * Creates a new DelayedOneShot instance with pulses off
+   * @param request The line request owning the trigger and output lines
+   * @param options Lines and pulse timing
+   */
+  constructor(request: LineRequest, options: DelayedOneShotOptions) {
+    const validated = oneShotOptionsSchema.parse(options);
+    this._nativeOneShot = new addon.DelayedOneShot(request.nativeRequest, validated);
+  }
+
+  /**
+   * Sets the delay of the pulses after their trigger edge
+   * @param delayUs Delay in microseconds (clamped to maxDelayUs), null for no pulses
+   * @returns The delay that was set
+   */
+  setDelay(delayUs: number | null): number | null {
+    return this._nativeOneShot.setDelay(delayUs === null ? null : z.number().nonnegative().parse(delayUs));
+  }
+
+  /**
+   * Gets the delay in microseconds (null if pulses are off)
+   */
+  get delay(): number | null {
+    return this._nativeOneShot.getDelay();
+  }
+
+  /**
+   * Starts reacting to trigger edges
+   */
+  start(): void {
+    this._nativeOneShot.start();
+  }
+
+  /**
+   * Stops reacting to trigger edges and drives the output low
+   */
+  stop(): void {
+    this._nativeOneShot.stop();
+  }
+
+  /**
+   * Gets the timing statistics
+   */
+  get stats(): DelayedOneShotStats {
+    return this._nativeOneShot.getStats();
+  }
+}
@@ -0,0 +1,139 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for 1-Wire bus options
+const oneWireOptionsSchema = z.object({
+  line: z.number().int().nonnegative(),
+  pullUp: z.boolean().default(true)
+});
+
+// ROM and function commands
+const READ_ROM = 0x33;
+const MATCH_ROM = 0x55;
+const SKIP_ROM = 0xcc;
+const CONVERT_T = 0x44;
+const READ_SCRATCHPAD = 0xbe;
+
+/**
+ * Options for a 1-Wire bus
+ */
+export interface OneWireBusOptions {
+  /** Offset of the data line, with an external pull-up resistor */
+  line: number;
+  /** Also enable the internal pull-up while the line is released, defaults to true */
+  pullUp?: boolean;
+}
+
+/**
+ * Statistics of a 1-Wire bus
+ */
+export interface OneWireBusStats {
+  /** Reset pulses sent */
+  resets: number;
+  /** Reset pulses without a presence pulse */
+  noPresence: number;
+  /** Bytes written and read */
+  bytes: number;
+}
+
+/**
+ * Dallas/Maxim CRC-8 (polynomial x^8 + x^5 + x^4 + 1)
+ */
+function crc8(data: Uint8Array): number {
+  let crc = 0;
+  for (const byte of data) {
+    let value = byte;
+    for (let bit = 0; bit < 8; bit++) {
+      const mix = (crc ^ value) & 1;
+      crc >>= 1;
+      if (mix) {
+        crc ^= 0x8c;
+      }
+      value >>= 1;
+    }
+  }
+  return crc;
+}
+
+/**
+ * 1-Wire bus master on a single GPIO line
+ *
+ * Time slots are generated on a native worker thread; the line is switched
+ * between driving low and released by reconfiguring the request in place.
+ * Each transaction holds the bus lock of the request.
+ */
+export class OneWireBus {
+  private _nativeBus: any;
+
+  /**
+   * Creates a new OneWireBus instance
+   * @param request The line request owning the data line
+   * @param options The data line
+   */
+  constructor(request: LineRequest, options: OneWireBusOptions) {
+    const validated = oneWireOptionsSchema.parse(options);
+    this._nativeBus = new addon.OneWireBus(request.nativeRequest, validated);
+  }
+
+  /**
+   * Sends a reset pulse
+   * @returns Whether a device answered with a presence pulse
+   */
+  reset(): Promise<boolean> {
+    return this._nativeBus.reset();
+  }
+
+  /**
+   * Writes bytes and then reads bytes, LSB first
+   * @param tx The bytes to write
+   * @param rxLength The number of bytes to read
+   * @param reset Send a reset pulse first, defaults to true; rejects if no device is present
+   * @returns The bytes read
+   */
+  transfer(tx: Uint8Array, rxLength: number = 0, reset: boolean = true): Promise<Uint8Array> {
+    return this._nativeBus.transfer(tx, rxLength, reset);
+  }
+
+  /**
+   * Reads the ROM code of the only device on the bus
+   * @returns The 8 byte ROM code (family code, serial number, CRC)
+   */
+  async readRom(): Promise<Uint8Array> {
+    const rom = await this.transfer(Uint8Array.of(READ_ROM), 8);
+    if (crc8(rom) !== 0) {
+      throw new Error('ROM code CRC mismatch');
+    }
+    return rom;
+  }
+
+  /**
+   * Starts a conversion on a DS18B20 and reads the temperature
+   * @param rom ROM code of the sensor; the only device on the bus if omitted
+   * @param conversionMs Time to wait for the conversion, defaults to 750 (12 bit resolution)
+   * @returns The temperature in degrees Celsius
+   */
+  async readTemperature(rom?: Uint8Array, conversionMs: number = 750): Promise<number> {
+    const select = rom ? Uint8Array.of(MATCH_ROM, ...rom) : Uint8Array.of(SKIP_ROM);
+
+    await this.transfer(Uint8Array.of(...select, CONVERT_T));
+    await new Promise(resolve => setTimeout(resolve, conversionMs));
+    const scratchpad = await this.transfer(Uint8Array.of(...select, READ_SCRATCHPAD), 9);
+
+    if (crc8(scratchpad) !== 0) {
+      throw new Error('Scratchpad CRC mismatch');
+    }
+    const raw = (scratchpad[1] << 8) | scratchpad[0];
+    return (raw & 0x8000 ? raw - 0x10000 : raw) / 16;
+  }
+
+  /**
+   * Gets the bus statistics
+   */
+  get stats(): OneWireBusStats {
+    return this._nativeBus.getStats();
+  }
+}
@@ -0,0 +1,121 @@
+import { z } from 'zod';
+
+/**
+ * Opcodes of GPIO micro-programs run by LineRequest.execute()
+ */
+export enum Opcode {
+  /** Stop the program */
+  END = 0x00,
+  /** Write the masked lines with one ioctl (operands: mask, bits) */
+  SET = 0x01,
+  /** Store all line values as a bitmask (operands: slot) */
+  READ = 0x02,
+  /** Sleep (operands: nanoseconds) */
+  DELAY = 0x03,
+  /** Wait for an edge on the masked lines (operands: mask, timeout in nanoseconds, slot) */
+  WAIT_EDGE = 0x04,
+  /** Repeat the following block (operands: count) */
+  LOOP = 0x05,
+  /** End of a repeated block */
+  ENDLOOP = 0x06
+}
+
+const u32 = z.number().int().nonnegative().max(0xffffffff);
+const slot = z.number().int().nonnegative().max(255);
+
+/**
+ * Result of a WAIT_EDGE instruction
+ */
+export interface WaitEdgeResult {
+  /** Index of the line in the request offsets */
+  index: number;
+  /** Whether the edge was rising */
+  rising: boolean;
+}
+
+/**
+ * Builds GPIO micro-programs for LineRequest.execute()
+ *
+ * Lines are selected by bit masks where bit n is the line at index n of the
+ * request offsets, so programs cover up to 32 lines. Results are stored in
+ * numbered slots of the Uint32Array returned by execute().
+ *
+ * With loops unrolled, a program may run at most 2^26 instructions and
+ * delay or wait for edges for at most 60 s in total. Delays and edge waits
+ * of 1 ms or more let other writers use the lines meanwhile, and a program
+ * stops when its request is released.
+ */
+export class ProgramBuilder {
+  private _words: number[] = [];
+
+  /**
+   * Writes the masked lines with a single ioctl
+   * @param mask Lines to write
+   * @param bits Values of the written lines
+   */
+  set(mask: number, bits: number): this {
+    this._words.push(Opcode.SET, u32.parse(mask >>> 0), u32.parse(bits >>> 0));
+    return this;
+  }
+
+  /**
+   * Reads all lines into a result slot as a bitmask
+   * @param slotIndex The result slot
+   */
+  read(slotIndex: number): this {
+    this._words.push(Opcode.READ, slot.parse(slotIndex));
+    return this;
+  }
+
+  /**
+   * Sleeps for the given time
+   * @param nanoseconds Delay in nanoseconds (at most about 4.29 s)
+   */
+  delayNs(nanoseconds: number): this {
+    this._words.push(Opcode.DELAY, u32.parse(nanoseconds));
+    return this;
+  }
+
+  /**
+   * Waits for an edge on the masked lines and stores it in a result slot
+   * (see decodeEdge), or 0 on timeout
+   * @param mask Lines to wait on (need edge detection)
+   * @param timeoutNs Timeout in nanoseconds
+   * @param slotIndex The result slot
+   */
+  waitEdge(mask: number, timeoutNs: number, slotIndex: number): this {
+    this._words.push(Opcode.WAIT_EDGE, u32.parse(mask >>> 0), u32.parse(timeoutNs), slot.parse(slotIndex));
+    return this;
+  }
+
+  /**
+   * Repeats the instructions added by body
+   * @param count Number of repetitions
+   * @param body Adds the instructions to repeat
+   */
+  loop(count: number, body: (builder: this) => void): this {
+    this._words.push(Opcode.LOOP, z.number().int().positive().max(0xffffffff).parse(count));
+    body(this);
+    this._words.push(Opcode.ENDLOOP);
+    return this;
+  }
+
+  /**
+   * Builds the program
+   */
+  build(): Uint32Array {
+    return Uint32Array.from([...this._words, Opcode.END]);
+  }
+
+  /**
+   * Decodes the result slot of a WAIT_EDGE instruction
+   * @param value The slot value
+   * @returns The edge, or null on timeout
+   */
+  static decodeEdge(value: number): WaitEdgeResult | null {
+    if (value === 0) {
+      return null;
+    }
+    return { index: (value & 0x7fffffff) - 1, rising: (value & 0x80000000) !== 0 };
+  }
+}
@@ -0,0 +1,95 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest, PulseOptions, pulseOptionsSchema } from './line-request.js';
+import type { PeriodicStats } from './threads.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for continuous pulse measurement options
+const pulseMeterOptionsSchema = pulseOptionsSchema.extend({
+  trigger: z.number().int().nonnegative(),
+  echo: z.number().int().nonnegative(),
+  rateHz: z.number().positive().default(10)
+});
+
+/**
+ * Options for continuous trigger/echo pulse measurements
+ */
+export interface PulseMeterOptions extends PulseOptions {
+  /** Offset of the trigger output */
+  trigger: number;
+  /** Offset of the echo input (requested with edge detection on both edges) */
+  echo: number;
+  /** Measurements per second, defaults to 10 */
+  rateHz?: number;
+}
+
+/**
+ * Result of one continuous measurement
+ */
+export interface PulseMeasurement {
+  /** Echo pulse width in nanoseconds, null if the echo timed out */
+  widthNs: number | null;
+  /** Kernel timestamp of the echo rising edge (or of the timeout) in nanoseconds */
+  timestampNs: bigint;
+}
+
+/**
+ * Statistics of continuous pulse measurements
+ */
+export interface PulseMeterStats {
+  /** Completed measurements */
+  measurements: number;
+  /** Measurements without a complete echo */
+  timeouts: number;
+  /** Width of the last complete echo in nanoseconds */
+  lastWidthNs: number;
+  /** Timing of the measurement thread */
+  timing: PeriodicStats;
+}
+
+/**
+ * Repeats trigger/echo measurements (e.g. HC-SR04 ultrasonic sensors) at a
+ * fixed rate on a native thread
+ */
+export class PulseMeter {
+  private _nativeMeter: any;
+  private _isRunning: boolean = false;
+
+  /**
+   * Creates a new PulseMeter instance
+   * @param request The line request owning the trigger and echo lines
+   * @param options Line offsets, pulse timing and measurement rate
+   */
+  constructor(request: LineRequest, options: PulseMeterOptions) {
+    const validated = pulseMeterOptionsSchema.parse(options);
+    this._nativeMeter = new addon.PulseMeter(request.nativeRequest, validated.trigger, validated.echo, validated);
+  }
+
+  /**
+   * Starts measuring
+   * @param callback Called with every measurement, including timeouts
+   */
+  start(callback: (err: Error | null, measurement: PulseMeasurement | null) => void): void {
+    this._nativeMeter.start(callback);
+    this._isRunning = true;
+  }
+
+  /**
+   * Stops measuring
+   */
+  stop(): void {
+    if (this._isRunning) {
+      this._nativeMeter.stop();
+      this._isRunning = false;
+    }
+  }
+
+  /**
+   * Gets the measurement statistics
+   */
+  get stats(): PulseMeterStats {
+    return this._nativeMeter.getStats();
+  }
+}
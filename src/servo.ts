@@ -0,0 +1,129 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+import type { PeriodicStats } from './threads.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schemas for servo options
+const servoOptionsSchema = z.object({
+  channels: z.array(z.number().int().nonnegative()).min(1),
+  periodUs: z.number().positive().default(20000),
+  minUs: z.number().nonnegative().default(500),
+  maxUs: z.number().positive().default(2500),
+  spinUs: z.number().nonnegative().default(100)
+}).refine(options => options.minUs <= options.maxUs && options.maxUs < options.periodUs, {
+  message: 'Expected minUs <= maxUs < periodUs'
+});
+
+const channelSchema = z.number().int().nonnegative();
+
+/**
+ * Options for a servo pulse generator
+ */
+export interface ServoOptions {
+  /** Offsets of the servo signal lines, one channel each */
+  channels: number[];
+  /** Pulse period in microseconds, defaults to 20000 (50 Hz) */
+  periodUs?: number;
+  /** Shortest pulse accepted in microseconds, defaults to 500 */
+  minUs?: number;
+  /** Longest pulse accepted in microseconds, defaults to 2500 */
+  maxUs?: number;
+  /** Busy-wait before each edge for lower jitter, defaults to 100 µs */
+  spinUs?: number;
+}
+
+/**
+ * Timing statistics of a servo pulse generator
+ */
+export interface ServoStats {
+  /** Whether the timing thread is running */
+  running: boolean;
+  /** Frames with at least one pulse */
+  frames: number;
+  /** Timing of the grouped rising edges (frame starts) */
+  rising: PeriodicStats;
+  /** Largest delay of a falling edge after its deadline in nanoseconds */
+  maxFallingJitterNs: number;
+  /** Mean delay of a falling edge after its deadline in nanoseconds */
+  meanFallingJitterNs: number;
+  /** Error that stopped the timing thread */
+  error: string | null;
+}
+
+/**
+ * Generates servo pulses on several lines from one native timing thread
+ *
+ * Each period starts on an absolute deadline with the rising edges of all
+ * active channels in one set_values call; the falling edges follow in order
+ * of pulse width. Setting a pulse width is a lock-free store picked up by
+ * the next frame.
+ */
+export class ServoController {
+  private _nativeServo: any;
+  private _minUs: number;
+  private _maxUs: number;
+
+  /**
+   * Creates a new ServoController instance with all channels off
+   * @param request The line request owning the servo outputs
+   * @param options Channel offsets and pulse timing
+   */
+  constructor(request: LineRequest, options: ServoOptions) {
+    const validated = servoOptionsSchema.parse(options);
+    this._minUs = validated.minUs;
+    this._maxUs = validated.maxUs;
+    this._nativeServo = new addon.ServoController(request.nativeRequest, validated);
+  }
+
+  /**
+   * Sets the pulse width of a channel
+   * @param channel Index of the channel in the channels option
+   * @param widthUs Pulse width in microseconds (clamped to minUs..maxUs), 0 to switch the channel off
+   * @returns The pulse width that was set
+   */
+  setPulseWidth(channel: number, widthUs: number): number {
+    return this._nativeServo.setPulseWidth(channelSchema.parse(channel), z.number().nonnegative().parse(widthUs));
+  }
+
+  /**
+   * Gets the pulse width of a channel in microseconds (0 if off)
+   * @param channel Index of the channel in the channels option
+   */
+  getPulseWidth(channel: number): number {
+    return this._nativeServo.getPulseWidth(channelSchema.parse(channel));
+  }
+
+  /**
+   * Sets a channel to a position between 0 and 1, mapped linearly onto minUs..maxUs
+   * @param channel Index of the channel in the channels option
+   * @param position Position from 0 to 1
+   */
+  setPosition(channel: number, position: number): void {
+    const validated = z.number().min(0).max(1).parse(position);
+    this.setPulseWidth(channel, this._minUs + validated * (this._maxUs - this._minUs));
+  }
+
+  /**
+   * Starts generating pulses
+   */
+  start(): void {
+    this._nativeServo.start();
+  }
+
+  /**
+   * Stops generating pulses and drives all channels low
+   */
+  stop(): void {
+    this._nativeServo.stop();
+  }
+
+  /**
+   * Gets the timing statistics
+   */
+  get stats(): ServoStats {
+    return this._nativeServo.getStats();
+  }
+}
@@ -0,0 +1,212 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+import { BitOrder } from './enums.js';
+import type { PeriodicStats } from './threads.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schemas for shift register options
+const chainOptionsSchema = z.object({
+  length: z.number().int().positive(),
+  bitOrder: z.nativeEnum(BitOrder).default(BitOrder.MSB_FIRST),
+  clockHz: z.number().nonnegative().default(0)
+});
+
+const outputOptionsSchema = chainOptionsSchema.extend({
+  data: z.number().int().nonnegative(),
+  clock: z.number().int().nonnegative(),
+  latch: z.number().int().nonnegative()
+});
+
+const inputOptionsSchema = chainOptionsSchema.extend({
+  load: z.number().int().nonnegative(),
+  clock: z.number().int().nonnegative(),
+  data: z.number().int().nonnegative()
+});
+
+const rateSchema = z.number().positive();
+
+/**
+ * Options shared by both shift register chain types
+ */
+interface ShiftRegisterChainOptions {
+  /** Number of registers (bytes) in the chain */
+  length: number;
+  /** Bit order within each register, defaults to MSB first (bit 7 on Q7/D7) */
+  bitOrder?: BitOrder;
+  /** Shift clock frequency in Hz, defaults to 0 (as fast as possible) */
+  clockHz?: number;
+}
+
+/**
+ * Options for a 74HC595 output chain
+ */
+export interface ShiftRegisterOutOptions extends ShiftRegisterChainOptions {
+  /** Offset of the serial data line (SER) */
+  data: number;
+  /** Offset of the shift clock line (SRCLK) */
+  clock: number;
+  /** Offset of the storage latch line (RCLK) */
+  latch: number;
+}
+
+/**
+ * Options for a 74HC165 input chain
+ */
+export interface ShiftRegisterInOptions extends ShiftRegisterChainOptions {
+  /** Offset of the parallel load line (SH/LD) */
+  load: number;
+  /** Offset of the shift clock line (CLK) */
+  clock: number;
+  /** Offset of the serial data line (QH) */
+  data: number;
+}
+
+/**
+ * Statistics of a 74HC595 output chain
+ */
+export interface ShiftRegisterOutStats {
+  /** Frames shifted out */
+  shifts: number;
+  /** Whether continuous refresh is running */
+  refreshing: boolean;
+  /** Timing of the last continuous refresh */
+  refresh: PeriodicStats;
+  /** Error that stopped the last continuous refresh */
+  error: string | null;
+}
+
+/**
+ * Statistics of a 74HC165 input chain
+ */
+export interface ShiftRegisterInStats {
+  /** Frames shifted in */
+  shifts: number;
+  /** Changed frames reported by continuous refresh */
+  changes: number;
+  /** Whether continuous refresh is running */
+  refreshing: boolean;
+  /** Timing of the last continuous refresh */
+  refresh: PeriodicStats;
+}
+
+/**
+ * Daisy-chained 74HC595 shift registers driven from a line request
+ *
+ * Byte 0 of a frame is the register nearest to the data line. Frames are
+ * shifted out on native threads, either once per write() or continuously at
+ * a fixed rate with startRefresh().
+ */
+export class ShiftRegisterOut {
+  private _nativeChain: any;
+
+  /**
+   * Creates a new ShiftRegisterOut instance and parks clock and latch low
+   * @param request The line request owning the data, clock and latch outputs
+   * @param options Line offsets and chain settings
+   */
+  constructor(request: LineRequest, options: ShiftRegisterOutOptions) {
+    const validated = outputOptionsSchema.parse(options);
+    this._nativeChain = new addon.ShiftRegisterOut(request.nativeRequest, validated);
+  }
+
+  /**
+   * Sets the frame shifted out by the next refresh without shifting it now
+   * @param data One byte per register
+   */
+  set(data: Uint8Array): void {
+    this._nativeChain.set(data);
+  }
+
+  /**
+   * Sets the frame and shifts it out once
+   * @param data One byte per register
+   * @returns Resolves once the frame is latched
+   */
+  write(data: Uint8Array): Promise<void> {
+    return this._nativeChain.write(data);
+  }
+
+  /**
+   * Starts shifting out the current frame at a fixed rate on a native thread
+   * @param rateHz Refresh rate in Hz
+   */
+  startRefresh(rateHz: number): void {
+    this._nativeChain.startRefresh(rateSchema.parse(rateHz));
+  }
+
+  /**
+   * Stops the continuous refresh
+   */
+  stopRefresh(): void {
+    this._nativeChain.stopRefresh();
+  }
+
+  /**
+   * Gets the shift and refresh statistics
+   */
+  get stats(): ShiftRegisterOutStats {
+    return this._nativeChain.getStats();
+  }
+}
+
+/**
+ * Daisy-chained 74HC165 shift registers read from a line request
+ *
+ * Byte 0 of a frame is the register nearest to the data line. Frames are
+ * shifted in on native threads, either once per read() or continuously at a
+ * fixed rate with startRefresh(), which reports changed frames only.
+ */
+export class ShiftRegisterIn {
+  private _nativeChain: any;
+
+  /**
+   * Creates a new ShiftRegisterIn instance and parks load high and clock low
+   * @param request The line request owning the load and clock outputs and the data input
+   * @param options Line offsets and chain settings
+   */
+  constructor(request: LineRequest, options: ShiftRegisterInOptions) {
+    const validated = inputOptionsSchema.parse(options);
+    this._nativeChain = new addon.ShiftRegisterIn(request.nativeRequest, validated);
+  }
+
+  /**
+   * Latches the parallel inputs and shifts them in once
+   * @returns One byte per register
+   */
+  read(): Promise<Uint8Array> {
+    return this._nativeChain.read();
+  }
+
+  /**
+   * Gets the last frame shifted in, or null if none was read yet
+   */
+  get latest(): Uint8Array | null {
+    return this._nativeChain.getLatest();
+  }
+
+  /**
+   * Starts shifting in frames at a fixed rate on a native thread
+   * @param rateHz Refresh rate in Hz
+   * @param callback Called with the first frame and every changed frame after it
+   */
+  startRefresh(rateHz: number, callback: (err: Error | null, data: Uint8Array | null) => void): void {
+    this._nativeChain.startRefresh(rateSchema.parse(rateHz), callback);
+  }
+
+  /**
+   * Stops the continuous refresh
+   */
+  stopRefresh(): void {
+    this._nativeChain.stopRefresh();
+  }
+
+  /**
+   * Gets the shift and refresh statistics
+   */
+  get stats(): ShiftRegisterInStats {
+    return this._nativeChain.getStats();
+  }
+}
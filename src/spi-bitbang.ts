@@ -0,0 +1,92 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+import { BitOrder } from './enums.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for SPI options
+const spiOptionsSchema = z.object({
+  sck: z.number().int().nonnegative(),
+  mosi: z.number().int().nonnegative().optional(),
+  miso: z.number().int().nonnegative().optional(),
+  cs: z.number().int().nonnegative().optional(),
+  mode: z.number().int().min(0).max(3).default(0),
+  bitOrder: z.nativeEnum(BitOrder).default(BitOrder.MSB_FIRST),
+  clockHz: z.number().positive().default(100000),
+  csActiveHigh: z.boolean().default(false)
+});
+
+/**
+ * Options for a bit-banged SPI master
+ */
+export interface SpiBitbangOptions {
+  /** Offset of the clock line (output) */
+  sck: number;
+  /** Offset of the data output line (output, optional for read-only devices) */
+  mosi?: number;
+  /** Offset of the data input line (input, optional for write-only devices) */
+  miso?: number;
+  /** Offset of the chip select line (output, optional) */
+  cs?: number;
+  /** SPI mode 0-3 (CPOL << 1 | CPHA), defaults to 0 */
+  mode?: number;
+  /** Bit order, defaults to MSB first */
+  bitOrder?: BitOrder;
+  /** Target clock frequency in Hz, defaults to 100 kHz */
+  clockHz?: number;
+  /** Whether chip select is active high, defaults to active low */
+  csActiveHigh?: boolean;
+}
+
+/**
+ * Transfer statistics of a bit-banged SPI master
+ */
+export interface SpiBitbangStats {
+  /** Completed transfers */
+  transfers: number;
+  /** Transferred bytes */
+  bytes: number;
+  /** Configured clock frequency in Hz */
+  targetClockHz: number;
+  /** Clock frequency achieved by the last transfer in Hz */
+  achievedClockHz: number;
+}
+
+/**
+ * SPI master bit-banged over the lines of a line request
+ *
+ * Transfers run on a native worker thread with one ioctl per clock edge plus
+ * one per sampled bit. The lines must be requested with the right directions
+ * (SCK, MOSI and CS as outputs, MISO as input).
+ */
+export class SpiBitbang {
+  private _nativeSpi: any;
+
+  /**
+   * Creates a new SpiBitbang instance and parks the bus
+   * @param request The line request owning the SPI lines
+   * @param options Line offsets and bus settings
+   */
+  constructor(request: LineRequest, options: SpiBitbangOptions) {
+    const validated = spiOptionsSchema.parse(options);
+    this._nativeSpi = new addon.SpiBitbang(request.nativeRequest, validated);
+  }
+
+  /**
+   * Performs a full-duplex transfer
+   * @param data The bytes to send
+   * @returns The bytes received while sending
+   */
+  transfer(data: Uint8Array): Promise<Uint8Array> {
+    return this._nativeSpi.transfer(data);
+  }
+
+  /**
+   * Gets the transfer statistics, including the achieved clock rate
+   */
+  get stats(): SpiBitbangStats {
+    return this._nativeSpi.getStats();
+  }
+}
@@ -0,0 +1,170 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+import { MotionProfile } from './enums.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schemas for stepper options
+const stepperOptionsSchema = z.object({
+  step: z.number().int().nonnegative(),
+  dir: z.number().int().nonnegative(),
+  invertDir: z.boolean().default(false),
+  pulseUs: z.number().positive().default(2),
+  dirSetupUs: z.number().nonnegative().default(5),
+  maxSpeed: z.number().positive().default(1000),
+  acceleration: z.number().positive().default(1000),
+  profile: z.nativeEnum(MotionProfile).default(MotionProfile.TRAPEZOIDAL),
+  position: z.number().int().default(0)
+});
+
+const moveOptionsSchema = z.object({
+  maxSpeed: z.number().positive().optional(),
+  acceleration: z.number().positive().optional(),
+  profile: z.nativeEnum(MotionProfile).optional(),
+  relative: z.boolean().optional()
+});
+
+/**
+ * Options for a step/direction stepper controller
+ */
+export interface StepperOptions {
+  /** Offset of the step line */
+  step: number;
+  /** Offset of the direction line (high moves towards larger positions) */
+  dir: number;
+  /** Whether to invert the direction line, defaults to false */
+  invertDir?: boolean;
+  /** Step pulse width in microseconds, defaults to 2 */
+  pulseUs?: number;
+  /** Time between a direction change and the next step in microseconds, defaults to 5 */
+  dirSetupUs?: number;
+  /** Default cruise speed in steps per second, defaults to 1000 */
+  maxSpeed?: number;
+  /** Default (peak) acceleration in steps per second squared, defaults to 1000 */
+  acceleration?: number;
+  /** Default velocity profile, defaults to trapezoidal */
+  profile?: MotionProfile;
+  /** Initial position in steps, defaults to 0 */
+  position?: number;
+}
+
+/**
+ * Per-move overrides of the controller defaults
+ */
+export interface MoveOptions {
+  /** Cruise speed in steps per second */
+  maxSpeed?: number;
+  /** (Peak) acceleration in steps per second squared */
+  acceleration?: number;
+  /** Velocity profile */
+  profile?: MotionProfile;
+}
+
+/**
+ * Statistics of a stepper controller
+ */
+export interface StepperStats {
+  /** Step pulses generated */
+  steps: number;
+  /** Finished moves, including stopped and aborted ones */
+  moves: number;
+  /** Moves waiting in the queue */
+  queued: number;
+  /** Largest delay of a step pulse after its deadline in nanoseconds */
+  maxLatenessNs: number;
+}
+
+/**
+ * Motion controller for step/direction stepper drivers
+ *
+ * Moves are queued and executed one after another on a native thread,
+ * accelerating from and decelerating to standstill with the chosen
+ * profile. Step pulses are placed on absolute deadlines, independent of the
+ * JavaScript event loop.
+ */
+export class StepperController {
+  private _nativeStepper: any;
+
+  /**
+   * Creates a new StepperController instance and starts its motion thread
+   * @param request The line request owning the step and direction outputs
+   * @param options Line offsets and motion defaults
+   */
+  constructor(request: LineRequest, options: StepperOptions) {
+    const validated = stepperOptionsSchema.parse(options);
+    this._nativeStepper = new addon.StepperController(request.nativeRequest, validated);
+  }
+
+  /**
+   * Queues a move to an absolute position
+   * @param position Target position in steps
+   * @param options Overrides of the speed, acceleration and profile
+   * @returns Resolves with the position when the move ends (early if stopped)
+   */
+  moveTo(position: number, options: MoveOptions = {}): Promise<number> {
+    const validated = moveOptionsSchema.parse(options);
+    return this._nativeStepper.moveTo(z.number().int().parse(position), { ...validated, relative: false });
+  }
+
+  /**
+   * Queues a move relative to the position where the previous move ends
+   * @param steps Steps to move, negative to move backwards
+   * @param options Overrides of the speed, acceleration and profile
+   * @returns Resolves with the position when the move ends (early if stopped)
+   */
+  move(steps: number, options: MoveOptions = {}): Promise<number> {
+    const validated = moveOptionsSchema.parse(options);
+    return this._nativeStepper.moveTo(z.number().int().parse(steps), { ...validated, relative: true });
+  }
+
+  /**
+   * Decelerates the current move to standstill and rejects all queued moves
+   */
+  stop(): void {
+    this._nativeStepper.stop();
+  }
+
+  /**
+   * Ends the current move at once, without deceleration, and rejects all queued moves
+   */
+  abort(): void {
+    this._nativeStepper.abort();
+  }
+
+  /**
+   * Gets the live position in steps
+   */
+  get position(): number {
+    return this._nativeStepper.getPosition();
+  }
+
+  /**
+   * Sets the position in steps, e.g. after homing; only allowed while idle
+   */
+  set position(position: number) {
+    this._nativeStepper.setPosition(z.number().int().parse(position));
+  }
+
+  /**
+   * Whether a move is in progress
+   */
+  get moving(): boolean {
+    return this._nativeStepper.isMoving();
+  }
+
+  /**
+   * Gets the motion statistics
+   */
+  get stats(): StepperStats {
+    return this._nativeStepper.getStats();
+  }
+
+  /**
+   * Aborts all moves and stops the motion thread
+   */
+  close(): void {
+    this._nativeStepper.close();
+  }
+}
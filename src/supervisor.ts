@@ -0,0 +1,167 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import type { LineRequest } from './line-request.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for heartbeat supervision options
+const superviseOptionsSchema = z.object({
+  maxIntervalMs: z.number().positive(),
+  minIntervalMs: z.number().nonnegative().default(0),
+  edge: z.enum(['rising', 'falling', 'both']).default('rising')
+}).refine(options => options.minIntervalMs < options.maxIntervalMs, {
+  message: 'Expected minIntervalMs < maxIntervalMs'
+});
+
+/**
+ * Options for supervising a heartbeat input
+ */
+export interface SuperviseOptions {
+  /** Report a timeout when no heartbeat arrives for this long */
+  maxIntervalMs: number;
+  /** Report heartbeats that come faster than this, defaults to 0 (disabled) */
+  minIntervalMs?: number;
+  /** Edges that count as heartbeats, defaults to 'rising' */
+  edge?: 'rising' | 'falling' | 'both';
+}
+
+/**
+ * Transition of a supervised heartbeat
+ */
+export interface SupervisionEvent {
+  /** Offset of the supervised line */
+  offset: number;
+  /** Heartbeat missing, too fast, or back within its intervals */
+  type: 'timeout' | 'too-fast' | 'recovered';
+  /** Deadline that passed (timeout) or kernel timestamp of the heartbeat edge, in nanoseconds */
+  timestampNs: bigint;
+  /** Time since the previous heartbeat in nanoseconds */
+  intervalNs: number;
+}
+
+/**
+ * Status of a supervised heartbeat
+ */
+export interface SupervisionStatus {
+  /** Waiting for the first heartbeat, alive, timed out or too fast */
+  state: 'waiting' | 'alive' | 'timeout' | 'too-fast';
+  /** Heartbeat edges seen */
+  heartbeats: number;
+  /** Timeouts reported */
+  timeouts: number;
+  /** Heartbeats that came faster than minIntervalMs */
+  tooFast: number;
+  /** Time between the last two heartbeats in nanoseconds */
+  lastIntervalNs: number;
+}
+
+/**
+ * Supervision of one heartbeat line, returned by LineRequest.supervise()
+ */
+export class Supervision {
+  private _supervisor: HeartbeatSupervisor;
+  private _offset: number;
+
+  constructor(supervisor: HeartbeatSupervisor, offset: number) {
+    this._supervisor = supervisor;
+    this._offset = offset;
+  }
+
+  /**
+   * Gets the offset of the supervised line
+   */
+  get offset(): number {
+    return this._offset;
+  }
+
+  /**
+   * Gets the status of the heartbeat (null once cancelled)
+   */
+  get status(): SupervisionStatus | null {
+    return this._supervisor.status(this._offset);
+  }
+
+  /**
+   * Stops supervising the line
+   */
+  cancel(): void {
+    this._supervisor.remove(this._offset);
+  }
+}
+
+/**
+ * Supervises the heartbeat lines of one request from a single native edge
+ * reader thread (for internal use, see LineRequest.supervise)
+ *
+ * Each heartbeat edge re-arms the deadline of its line from its kernel
+ * timestamp in native code, so only transitions reach JavaScript.
+ */
+export class HeartbeatSupervisor {
+  private _nativeSupervisor: any;
+  private _callbacks: Map<number, (err: Error | null, event: SupervisionEvent | null) => void> = new Map();
+  private _isRunning: boolean = false;
+
+  /**
+   * Creates a new HeartbeatSupervisor instance
+   * @param request The line request owning the heartbeat lines
+   */
+  constructor(request: LineRequest) {
+    this._nativeSupervisor = new addon.HeartbeatSupervisor(request.nativeRequest);
+  }
+
+  /**
+   * Starts or replaces the supervision of a line
+   * @param offset Offset of the line, requested with edge detection
+   * @param options Heartbeat intervals
+   * @param callback Called for each transition
+   */
+  add(offset: number, options: SuperviseOptions,
+      callback: (err: Error | null, event: SupervisionEvent | null) => void): Supervision {
+    const validated = superviseOptionsSchema.parse(options);
+    this._nativeSupervisor.add(offset, validated);
+    this._callbacks.set(offset, callback);
+
+    if (!this._isRunning) {
+      this._nativeSupervisor.start((err: Error | null, event: SupervisionEvent | null) => {
+        if (err) {
+          this._callbacks.forEach(cb => cb(err, null));
+        } else if (event) {
+          this._callbacks.get(event.offset)?.(null, event);
+        }
+      });
+      this._isRunning = true;
+    }
+    return new Supervision(this, offset);
+  }
+
+  /**
+   * Stops supervising a line; the reader thread ends with the last one
+   * @param offset Offset of the line
+   */
+  remove(offset: number): void {
+    this._nativeSupervisor.remove(offset);
+    this._callbacks.delete(offset);
+    if (this._callbacks.size === 0) {
+      this.stop();
+    }
+  }
+
+  /**
+   * Gets the status of a supervised line
+   * @param offset Offset of the line
+   */
+  status(offset: number): SupervisionStatus | null {
+    return this._nativeSupervisor.getStatus(offset);
+  }
+
+  /**
+   * Stops supervising all lines
+   */
+  stop(): void {
+    if (this._isRunning) {
+      this._nativeSupervisor.stop();
+      this._isRunning = false;
+    }
+  }
+}
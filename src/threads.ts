@@ -0,0 +1,69 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { SchedPolicy } from './enums.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for thread options
+const threadOptionsSchema = z.object({
+  policy: z.nativeEnum(SchedPolicy).optional(),
+  priority: z.number().int().nonnegative().optional(),
+  cpus: z.array(z.number().int().nonnegative()).optional(),
+  lockMemory: z.boolean().optional()
+});
+
+/**
+ * Scheduling options for native GPIO threads
+ */
+export interface ThreadOptions {
+  /** Scheduling policy */
+  policy?: SchedPolicy;
+  /** Real-time priority (1-99 for FIFO and RR, 0 for OTHER) */
+  priority?: number;
+  /** CPUs the threads are pinned to (empty for no pinning) */
+  cpus?: number[];
+  /** Lock all current and future process memory to avoid page faults */
+  lockMemory?: boolean;
+}
+
+/**
+ * Timing statistics of a native thread running at a fixed rate
+ */
+export interface PeriodicStats {
+  /** Ticks run */
+  ticks: number;
+  /** Ticks dropped because a previous one overran its period */
+  missed: number;
+  /** Largest wake-up delay after a deadline in nanoseconds */
+  maxLatenessNs: number;
+  /** Mean wake-up delay after a deadline in nanoseconds */
+  meanLatenessNs: number;
+}
+
+/**
+ * Sets the scheduling options used by native GPIO threads started from now on
+ *
+ * The options are checked right away, so missing privileges (CAP_SYS_NICE,
+ * RLIMIT_RTPRIO, CAP_IPC_LOCK) are reported by this call. Fields that are
+ * left out keep their previous values.
+ *
+ * The options apply to the threads owned by the library (watchers, edge
+ * readers, the VCD writer, scheduled writes and the engine threads). One-off
+ * jobs that return a promise (`execute()`, `measurePulse()`, SPI and I2C
+ * transfers, shift register and DHT reads, 1-Wire) run on the shared libuv
+ * pool and keep its default scheduling.
+ * @param options The scheduling options
+ * @returns The options now in effect
+ */
+export function setThreadOptions(options: ThreadOptions): Required<ThreadOptions> {
+  const validated = threadOptionsSchema.parse(options);
+  return addon.setThreadOptions(validated);
+}
+
+/**
+ * Gets the scheduling options used by native GPIO threads
+ */
+export function getThreadOptions(): Required<ThreadOptions> {
+  return addon.getThreadOptions();
+}
@@ -0,0 +1,61 @@
+import { Readable } from 'stream';
+import { LineRequest } from './line-request.js';
+import { Decoder, DecoderStats, UartDecoderOptions } from './decoder.js';
+
+/**
+ * Options for a software UART receiver
+ */
+export type UartReceiverOptions = Omit<UartDecoderOptions, 'protocol'>;
+
+/**
+ * Receives serial data on a GPIO line as a byte stream
+ *
+ * Bytes are reconstructed in native code from the kernel timestamps of the
+ * edges of the RX line by a 'uart' Decoder and pushed in chunks. Bytes with
+ * framing or parity errors are dropped and counted in the statistics. The
+ * receiver starts with the first read and stops when the stream is destroyed.
+ */
+export class UartReceiver extends Readable {
+  private _decoder: Decoder;
+  private _isRunning: boolean = false;
+
+  /**
+   * Creates a new UartReceiver instance
+   * @param request The line request owning the RX line, with edge detection on both edges
+   * @param options The line and frame format
+   */
+  constructor(request: LineRequest, options: UartReceiverOptions) {
+    super();
+    this._decoder = new Decoder(request, { ...options, protocol: 'uart' });
+  }
+
+  /**
+   * Gets the decoder statistics, including framingErrors, parityErrors and falseStarts
+   */
+  get stats(): DecoderStats {
+    return this._decoder.stats;
+  }
+
+  _read(): void {
+    // Chunks are pushed as they arrive; flow control is not possible on a wire
+    if (this._isRunning) {
+      return;
+    }
+    this._decoder.start((err, frame) => {
+      if (err) {
+        this.destroy(err);
+      } else if (frame) {
+        this.push(frame.data);
+      }
+    });
+    this._isRunning = true;
+  }
+
+  _destroy(error: Error | null, callback: (error?: Error | null) => void): void {
+    if (this._isRunning) {
+      this._decoder.stop();
+      this._isRunning = false;
+    }
+    callback(error);
+  }
+}
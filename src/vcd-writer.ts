@@ -0,0 +1,90 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for VCD writer constructor
+const vcdWriterSchema = z.object({
+  path: z.string().min(1),
+  names: z.array(z.string().min(1)).optional(),
+  scope: z.string().min(1).optional()
+});
+
+/**
+ * Options for a VCD writer
+ */
+export interface VcdWriterOptions {
+  /** Signal names in request offset order (defaults to the kernel line names) */
+  names?: string[];
+  /** Name of the VCD scope (defaults to the chip label) */
+  scope?: string;
+}
+
+/**
+ * Capture statistics of a VCD writer
+ */
+export interface VcdWriterStats {
+  /** Edge events read from the kernel */
+  edges: number;
+  /** Snapshots taken with snapshot() */
+  snapshots: number;
+  /** Value changes written to the file */
+  changesWritten: number;
+  /** Error that stopped the capture, if any */
+  error: string | null;
+}
+
+/**
+ * Streams edge events of a line request into an IEEE 1364 VCD file
+ *
+ * Edges are read and written on native background threads using the kernel
+ * event timestamps, so captures can be opened in GTKWave or PulseView.
+ * The writer consumes the edge events of the request, so the request must
+ * not be watched by anything else while the capture is running. Changes are
+ * held back for 50 ms and written in timestamp order, so edges and
+ * snapshots interleave correctly. Releasing the request stops the capture
+ * and sets `stats.error`; the file is still written by close().
+ */
+export class VcdWriter {
+  private _nativeWriter: any;
+
+  /**
+   * Creates a new VcdWriter instance and starts capturing
+   * @param request The line request to capture (lines need edge detection)
+   * @param path The path of the VCD file to write
+   * @param options Signal naming options
+   */
+  constructor(request: LineRequest, path: string, options: VcdWriterOptions = {}) {
+    const validated = vcdWriterSchema.parse({ path, ...options });
+
+    this._nativeWriter = new addon.VcdWriter(request.nativeRequest, validated.path, {
+      names: validated.names,
+      scope: validated.scope
+    });
+  }
+
+  /**
+   * Records the current values of all lines, e.g. for lines without edge detection.
+   * Values that did not change since the last recorded change are skipped.
+   */
+  snapshot(): void {
+    this._nativeWriter.snapshot();
+  }
+
+  /**
+   * Gets the capture statistics
+   */
+  get stats(): VcdWriterStats {
+    return this._nativeWriter.getStats();
+  }
+
+  /**
+   * Stops capturing, flushes and closes the file
+   * @returns The final capture statistics
+   */
+  close(): VcdWriterStats {
+    return this._nativeWriter.close();
+  }
+}
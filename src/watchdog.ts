@@ -0,0 +1,98 @@
+import { z } from 'zod';
+import bindings from 'bindings';
+import { LineRequest } from './line-request.js';
+import type { PeriodicStats } from './threads.js';
+
+// Load native addon
+const addon = bindings('gpiod2-node-gyp');
+
+// Validation schema for watchdog kicker options
+const watchdogKickerOptionsSchema = z.object({
+  line: z.number().int().nonnegative(),
+  periodMs: z.number().positive().default(100),
+  feedTimeoutMs: z.number().positive().default(1000),
+  spinUs: z.number().nonnegative().default(0)
+});
+
+/**
+ * Options for a watchdog kicker
+ */
+export interface WatchdogKickerOptions {
+  /** Offset of the output wired to the watchdog input */
+  line: number;
+  /** Time between two toggles of the line in milliseconds, defaults to 100 */
+  periodMs?: number;
+  /** Stop toggling when feed() was not called for this long, defaults to 1000 ms */
+  feedTimeoutMs?: number;
+  /** Busy-wait before each toggle for lower jitter, defaults to 0 */
+  spinUs?: number;
+}
+
+/**
+ * Statistics of a watchdog kicker
+ */
+export interface WatchdogKickerStats {
+  /** Whether the kick thread is running */
+  running: boolean;
+  /** Calls to feed() */
+  feeds: number;
+  /** Time since the last feed (or start) in nanoseconds, null if never started or fed */
+  lastFeedAgeNs: number | null;
+  /** Toggles of the line since start */
+  kicks: number;
+  /** Periods without a toggle because the last feed was too old */
+  starved: number;
+  /** Timing of the kick thread */
+  timing: PeriodicStats;
+  /** Error that stopped the kick thread */
+  error: string | null;
+}
+
+/**
+ * Kicks an external hardware watchdog from a native thread
+ *
+ * The line toggles on absolute deadlines regardless of garbage collection or
+ * event loop stalls, but only while feed() was called within feedTimeoutMs.
+ * An application that stops feeding stops the kicks and the watchdog fires.
+ */
+export class WatchdogKicker {
+  private _nativeKicker: any;
+
+  /**
+   * Creates a new WatchdogKicker instance
+   * @param request The line request owning the watchdog output
+   * @param options Line offset, kick period and feed timeout
+   */
+  constructor(request: LineRequest, options: WatchdogKickerOptions) {
+    const validated = watchdogKickerOptionsSchema.parse(options);
+    this._nativeKicker = new addon.WatchdogKicker(request.nativeRequest, validated);
+  }
+
+  /**
+   * Starts kicking; starting counts as a feed
+   */
+  start(): void {
+    this._nativeKicker.start();
+  }
+
+  /**
+   * Stops kicking and leaves the line at its current level
+   */
+  stop(): void {
+    this._nativeKicker.stop();
+  }
+
+  /**
+   * Signals that the application is alive
+   */
+  feed(): void {
+    this._nativeKicker.feed();
+  }
+
+  /**
+   * Gets the kick statistics
+   */
+  get stats(): WatchdogKickerStats {
+    return this._nativeKicker.getStats();
+  }
+}
@@ -1,5 +1,13 @@
 import { executeChipTests } from "./testChips.js";
 import { executeLineTests } from "./testLines.js";
+import { executeLineRequestTests } from "./testLineRequest.js";
+import { executeVcdWriterTests } from "./testVcdWriter.js";
+import { executeEngineTests } from "./testEngines.js";
+import { executeDecoderTests } from "./testDecoders.js";
 
 executeChipTests();
-executeLineTests();
\ No newline at end of file
+executeLineTests();
+executeLineRequestTests();
+executeVcdWriterTests();
+executeEngineTests();
+executeDecoderTests();
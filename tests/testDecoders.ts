@@ -0,0 +1,229 @@
+import assert from "assert";
+import { Chip } from "../src/chip.js";
+import { LineConfig } from "../src/line-config.js";
+import { LineRequest } from "../src/line-request.js";
+import { DecodedFrame, Decoder } from "../src/decoder.js";
+import { UartReceiver } from "../src/uart-receiver.js";
+import { Direction, Edge, Value } from "../src/enums.js";
+import { cleanupMockChip, getMockChip, waitTimeout, writeMockValue } from "./utils.js";
+import test, { TestContext } from "node:test";
+
+function requestInputs(chip: Chip, offsets: number[], edge: Edge): LineRequest {
+    const config = new LineConfig();
+    for (const offset of offsets) {
+        config.setOffset(offset);
+        config.setDirection(Direction.INPUT);
+        config.setEdge(edge);
+    }
+    return new LineRequest(chip, offsets, config);
+}
+
+function startDecoder(decoder: Decoder): DecodedFrame[] {
+    const frames: DecodedFrame[] = [];
+    decoder.start((err, frame) => {
+        assert.ifError(err);
+        if (frame) {
+            frames.push(frame);
+        }
+    });
+    return frames;
+}
+
+function sendWiegand(bits: string): void {
+    for (const bit of bits) {
+        const offset = bit === '1' ? 1 : 0;
+        writeMockValue(offset, Value.LOW);
+        writeMockValue(offset, Value.HIGH);
+    }
+}
+
+// Sends 8N1 characters with absolute deadlines so timer drift does not add up
+async function sendUart(offset: number, bytes: number[], bitMs: number): Promise<void> {
+    let deadline = performance.now();
+    for (const byte of bytes) {
+        const levels = [0];
+        for (let bit = 0; bit < 8; bit++) {
+            levels.push((byte >> bit) & 1);
+        }
+        levels.push(1);
+        for (const level of levels) {
+            writeMockValue(offset, level ? Value.HIGH : Value.LOW);
+            deadline += bitMs;
+            await waitTimeout(Math.max(0, deadline - performance.now()));
+        }
+    }
+}
+
+// Busy-waits between the levels with absolute deadlines; infrared symbols
+// are far shorter than timers can generate
+function sendLevels(offset: number, levels: [Value, number][]): void {
+    let deadline = process.hrtime.bigint();
+    for (const [value, us] of levels) {
+        writeMockValue(offset, value);
+        deadline += BigInt(Math.round(us * 1000));
+        while (process.hrtime.bigint() < deadline) {
+        }
+    }
+}
+
+// NEC frame of an active-low receiver: leader, 32 bits LSB first, stop mark
+function necLevels(bytes: number[]): [Value, number][] {
+    const levels: [Value, number][] = [[Value.LOW, 9000], [Value.HIGH, 4500]];
+    for (const byte of bytes) {
+        for (let bit = 0; bit < 8; bit++) {
+            levels.push([Value.LOW, 562.5], [Value.HIGH, (byte >> bit) & 1 ? 1687.5 : 562.5]);
+        }
+    }
+    levels.push([Value.LOW, 562.5], [Value.HIGH, 0]);
+    return levels;
+}
+
+// RC5 frame of an active-low receiver: a 1 is a space followed by a mark
+function rc5Levels(bits: string): [Value, number][] {
+    const levels: [Value, number][] = [];
+    for (const bit of bits) {
+        levels.push([bit === '1' ? Value.HIGH : Value.LOW, 889], [bit === '1' ? Value.LOW : Value.HIGH, 889]);
+    }
+    levels.push([Value.HIGH, 0]);
+    return levels;
+}
+
+export async function testWiegandDecoder(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    writeMockValue(0, Value.HIGH);
+    writeMockValue(1, Value.HIGH);
+    const request = requestInputs(chip, [0, 1], Edge.FALLING);
+    const decoder = new Decoder(request, { protocol: 'wiegand', d0: 0, d1: 1, timeoutMs: 20 });
+    const frames = startDecoder(decoder);
+    // Facility 1, card 1 with valid parity
+    sendWiegand('1' + '00000001' + '0000000000000001' + '0');
+    await waitTimeout(100);
+    // Same frame with a broken trailing parity bit
+    sendWiegand('1' + '00000001' + '0000000000000001' + '1');
+    await waitTimeout(100);
+    decoder.stop();
+    assert.strictEqual(frames.length, 1, "Expected only the valid frame");
+    assert.strictEqual(frames[0].bits, 26);
+    assert.strictEqual(frames[0].facility, 1);
+    assert.strictEqual(frames[0].card, 1);
+    assert.strictEqual(decoder.stats.parityErrors, 1);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testOokDecoder(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    writeMockValue(2, Value.LOW);
+    const request = requestInputs(chip, [2], Edge.BOTH);
+    // Periods long enough for timers to generate them
+    const decoder = new Decoder(request, {
+        protocol: 'ook', line: 2, shortUs: 10000, longUs: 40000, gapUs: 100000, tolerance: 0.4, minBits: 4
+    });
+    const frames = startDecoder(decoder);
+    // Glitch that fits no period
+    writeMockValue(2, Value.HIGH);
+    writeMockValue(2, Value.LOW);
+    await waitTimeout(150);
+    for (const bit of '1010') {
+        writeMockValue(2, Value.HIGH);
+        await waitTimeout(bit === '1' ? 40 : 10);
+        writeMockValue(2, Value.LOW);
+        await waitTimeout(10);
+    }
+    await waitTimeout(200);
+    decoder.stop();
+    assert.strictEqual(frames.length, 1, "Expected one frame");
+    assert.strictEqual(frames[0].protocol, 'ook');
+    assert.strictEqual(frames[0].bits, 4);
+    assert.strictEqual(frames[0].data[0], 0xa0);
+    assert.strictEqual(decoder.stats.noisePulses, 1);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testUartReceiver(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    writeMockValue(3, Value.HIGH);
+    const request = requestInputs(chip, [3], Edge.BOTH);
+    // 25 baud leaves half a bit of 20 ms for timer jitter
+    const receiver = new UartReceiver(request, { line: 3, baud: 25 });
+    const received: Buffer[] = [];
+    receiver.on('data', (chunk: Buffer) => received.push(chunk));
+    await waitTimeout(20);
+    await sendUart(3, [0x41, 0x5a], 40);
+    await waitTimeout(300);
+    receiver.destroy();
+    assert.deepStrictEqual([...Buffer.concat(received)], [0x41, 0x5a]);
+    assert.strictEqual(receiver.stats.framingErrors, 0);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testNecDecoder(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    writeMockValue(4, Value.HIGH);
+    const request = requestInputs(chip, [4], Edge.BOTH);
+    const decoder = new Decoder(request, { protocol: 'nec', line: 4, tolerance: 0.4 });
+    const frames = startDecoder(decoder);
+    await waitTimeout(20);
+    // Address 0x04, command 0x08, each followed by its inverse
+    sendLevels(4, necLevels([0x04, 0xfb, 0x08, 0xf7]));
+    await waitTimeout(40);
+    // Repeat code of the held key
+    sendLevels(4, [[Value.LOW, 9000], [Value.HIGH, 2250], [Value.LOW, 562.5], [Value.HIGH, 0]]);
+    await waitTimeout(100);
+    decoder.stop();
+    assert.strictEqual(frames.length, 2, "Expected a frame and a repeat");
+    assert.strictEqual(frames[0].protocol, 'nec');
+    assert.strictEqual(frames[0].bits, 32);
+    assert.deepStrictEqual(Array.from(frames[0].data), [0x04, 0xfb, 0x08, 0xf7]);
+    assert.strictEqual(frames[0].address, 0x04);
+    assert.strictEqual(frames[0].command, 0x08);
+    assert.strictEqual(frames[0].repeat, 0);
+    assert.strictEqual(frames[1].repeat, 1);
+    assert.strictEqual(frames[1].address, 0x04);
+    assert.strictEqual(frames[1].command, 0x08);
+    assert.strictEqual(decoder.stats.invalidFrames, 0);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testRc5Decoder(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    writeMockValue(5, Value.HIGH);
+    const request = requestInputs(chip, [5], Edge.BOTH);
+    const decoder = new Decoder(request, { protocol: 'rc5', line: 5, tolerance: 0.4 });
+    const frames = startDecoder(decoder);
+    await waitTimeout(20);
+    // Start bits, toggle 1, address 5, command 0x23
+    sendLevels(5, rc5Levels('11' + '1' + '00101' + '100011'));
+    await waitTimeout(100);
+    // A pulse that fits no half bit
+    sendLevels(5, [[Value.LOW, 4000], [Value.HIGH, 0]]);
+    await waitTimeout(100);
+    decoder.stop();
+    assert.strictEqual(frames.length, 1, "Expected one frame");
+    assert.strictEqual(frames[0].protocol, 'rc5');
+    assert.strictEqual(frames[0].bits, 14);
+    assert.strictEqual(frames[0].address, 5);
+    assert.strictEqual(frames[0].command, 0x23);
+    assert.strictEqual(frames[0].toggle, 1);
+    assert.strictEqual(decoder.stats.noisePulses, 1);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function executeDecoderTests(): Promise<void> {
+    await test('Decoder Tests', async (tt: TestContext) => {
+        await tt.test('testWiegandDecoder', async (t: TestContext) => await testWiegandDecoder(t));
+        await tt.test('testOokDecoder', async (t: TestContext) => await testOokDecoder(t));
+        await tt.test('testUartReceiver', async (t: TestContext) => await testUartReceiver(t));
+        await tt.test('testNecDecoder', async (t: TestContext) => await testNecDecoder(t));
+        await tt.test('testRc5Decoder', async (t: TestContext) => await testRc5Decoder(t));
+    });
+}
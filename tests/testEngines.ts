@@ -0,0 +1,403 @@
+import assert from "assert";
+import { Chip } from "../src/chip.js";
+import { LineConfig } from "../src/line-config.js";
+import { LineRequest } from "../src/line-request.js";
+import { ShiftRegisterIn, ShiftRegisterOut } from "../src/shift-register.js";
+import { KeypadEvent, KeypadScanner } from "../src/keypad.js";
+import { DisplayRefresher } from "../src/display-refresher.js";
+import { StepperController } from "../src/stepper.js";
+import { ServoController } from "../src/servo.js";
+import { ButtonClassifier, ButtonEvent } from "../src/button.js";
+import { DelayedOneShot } from "../src/one-shot.js";
+import { BusTrigger, BusTriggerEvent } from "../src/bus-trigger.js";
+import { WatchdogKicker } from "../src/watchdog.js";
+import { SpiBitbang } from "../src/spi-bitbang.js";
+import { I2cBitbang } from "../src/i2c-bitbang.js";
+import { PulseMeasurement, PulseMeter } from "../src/pulse-meter.js";
+import { getThreadOptions, setThreadOptions } from "../src/threads.js";
+import { ButtonEventType, Direction, Edge, KeyEventType, SchedPolicy, Value } from "../src/enums.js";
+import { cleanupMockChip, getMockChip, readMockValue, waitTimeout, writeMockValue } from "./utils.js";
+import test, { TestContext } from "node:test";
+
+function requestMixed(chip: Chip, outputs: number[], inputs: number[], edge: Edge = Edge.NONE): LineRequest {
+    const config = new LineConfig();
+    for (const offset of outputs) {
+        config.setOffset(offset);
+        config.setDirection(Direction.OUTPUT);
+    }
+    for (const offset of inputs) {
+        config.setOffset(offset);
+        config.setDirection(Direction.INPUT);
+        config.setEdge(edge);
+    }
+    return new LineRequest(chip, [...outputs, ...inputs], config);
+}
+
+export async function testShiftRegisterOut(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestMixed(chip, [0, 1, 2], []);
+    const chain = new ShiftRegisterOut(request, { data: 0, clock: 1, latch: 2, length: 2 });
+    // Byte 0 is shifted last, its bit 0 stays on the data line
+    await chain.write(Uint8Array.from([0x01, 0x80]));
+    assert(readMockValue(0) === Value.HIGH);
+    assert(readMockValue(1) === Value.LOW);
+    assert(readMockValue(2) === Value.LOW);
+    assert.throws(() => chain.set(Uint8Array.from([0])));
+    chain.startRefresh(1000);
+    await waitTimeout(100);
+    chain.stopRefresh();
+    const stats = chain.stats;
+    assert(stats.refresh.ticks > 0, "Expected refresh ticks");
+    assert.strictEqual(stats.shifts, stats.refresh.ticks + 1);
+    assert.strictEqual(stats.error, null);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testShiftRegisterIn(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestMixed(chip, [0, 1], [2]);
+    const chain = new ShiftRegisterIn(request, { load: 0, clock: 1, data: 2, length: 3 });
+    writeMockValue(2, Value.HIGH);
+    assert.deepStrictEqual(Array.from(await chain.read()), [0xff, 0xff, 0xff]);
+    const frames: Uint8Array[] = [];
+    chain.startRefresh(500, (err, data) => {
+        assert.ifError(err);
+        if (data) {
+            frames.push(data);
+        }
+    });
+    await waitTimeout(50);
+    writeMockValue(2, Value.LOW);
+    await waitTimeout(50);
+    chain.stopRefresh();
+    assert.strictEqual(frames.length, 2, "Expected the first and one changed frame");
+    assert.deepStrictEqual(Array.from(frames[1]), [0, 0, 0]);
+    assert.deepStrictEqual(Array.from(chain.latest ?? []), [0, 0, 0]);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testKeypadScanner(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    writeMockValue(1, Value.HIGH);
+    writeMockValue(2, Value.HIGH);
+    const request = requestMixed(chip, [0], [1, 2], Edge.BOTH);
+    const keypad = new KeypadScanner(request, { rows: [0], columns: [1, 2], keys: ['A', 'B'], debounceMs: 5 });
+    const events: KeypadEvent[] = [];
+    keypad.start((err, event) => {
+        assert.ifError(err);
+        if (event) {
+            events.push(event);
+        }
+    });
+    await waitTimeout(50);
+    writeMockValue(2, Value.LOW);
+    await waitTimeout(100);
+    assert.deepStrictEqual(keypad.pressed, [1]);
+    writeMockValue(2, Value.HIGH);
+    await waitTimeout(100);
+    keypad.stop();
+    assert.strictEqual(events.length, 2, "Expected key-down and key-up");
+    assert.strictEqual(events[0].type, KeyEventType.KEY_DOWN);
+    assert.strictEqual(events[0].key, 'B');
+    assert.strictEqual(events[1].type, KeyEventType.KEY_UP);
+    assert(events[1].timestampNs > events[0].timestampNs);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testDisplayRefresher(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestMixed(chip, [0, 1, 2], []);
+    const display = new DisplayRefresher(request, { digits: [0, 1], segments: [2], rateHz: 1000 });
+    assert.throws(() => display.setFrame(Uint8Array.from([1])));
+    display.setFrame(Uint8Array.from([1, 0]));
+    display.start();
+    await waitTimeout(100);
+    display.stop();
+    const stats = display.stats;
+    assert(stats.cycles > 0, "Expected refresh cycles");
+    assert.strictEqual(stats.frames, 1);
+    assert.strictEqual(stats.error, null);
+    assert(readMockValue(0) === Value.LOW);
+    assert(readMockValue(1) === Value.LOW);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testStepperMoves(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestMixed(chip, [0, 1], []);
+    const stepper = new StepperController(request, { step: 0, dir: 1, maxSpeed: 5000, acceleration: 50000 });
+    const first = stepper.moveTo(100);
+    const second = stepper.move(-40);
+    assert.strictEqual(await first, 100);
+    assert.strictEqual(await second, 60);
+    assert(readMockValue(1) === Value.LOW, "Expected the direction line low after moving backwards");
+    const long = stepper.moveTo(100000);
+    const queued = stepper.moveTo(0);
+    await waitTimeout(50);
+    stepper.stop();
+    await assert.rejects(queued);
+    const stopped = await long;
+    assert(stopped > 60 && stopped < 100000, "Expected the move to end early");
+    assert.strictEqual(stepper.position, stopped);
+    assert.strictEqual(stepper.stats.steps, 140 + (stopped - 60));
+    stepper.close();
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testServoPulses(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestMixed(chip, [0, 1], []);
+    const servo = new ServoController(request, { channels: [0, 1] });
+    assert.strictEqual(servo.setPulseWidth(0, 100), 500);
+    servo.setPosition(1, 0.5);
+    assert.strictEqual(servo.getPulseWidth(1), 1500);
+    servo.start();
+    await waitTimeout(200);
+    servo.stop();
+    const stats = servo.stats;
+    assert(stats.frames > 0, "Expected servo frames");
+    assert.strictEqual(stats.error, null);
+    assert(readMockValue(0) === Value.LOW);
+    assert(readMockValue(1) === Value.LOW);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testButtonClassifier(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    writeMockValue(1, Value.HIGH);
+    const request = requestMixed(chip, [], [1], Edge.BOTH);
+    const classifier = new ButtonClassifier(request, { buttons: [1], debounceMs: 5, longPressMs: 0, multiClickMs: 100 });
+    const events: ButtonEvent[] = [];
+    classifier.start((err, event) => {
+        assert.ifError(err);
+        if (event) {
+            events.push(event);
+        }
+    });
+    await waitTimeout(50);
+    writeMockValue(1, Value.LOW);
+    await waitTimeout(50);
+    assert.deepStrictEqual(classifier.pressed, [0]);
+    writeMockValue(1, Value.HIGH);
+    await waitTimeout(300);
+    classifier.stop();
+    assert.deepStrictEqual(events.map(event => event.type),
+        [ButtonEventType.PRESS, ButtonEventType.RELEASE, ButtonEventType.CLICK]);
+    assert(events[1].durationNs! > 0);
+    assert.strictEqual(events[2].count, 1);
+    assert.strictEqual(classifier.stats.events, 3);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testDelayedOneShot(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestMixed(chip, [0], [1], Edge.RISING);
+    const oneShot = new DelayedOneShot(request, { trigger: 1, output: 0, widthUs: 1000 });
+    assert.strictEqual(oneShot.setDelay(20000), 10000);
+    assert.strictEqual(oneShot.delay, 10000);
+    oneShot.start();
+    await waitTimeout(50);
+    writeMockValue(1, Value.HIGH);
+    await waitTimeout(100);
+    writeMockValue(1, Value.LOW);
+    oneShot.setDelay(null);
+    writeMockValue(1, Value.HIGH);
+    await waitTimeout(100);
+    oneShot.stop();
+    const stats = oneShot.stats;
+    assert.strictEqual(stats.triggers, 2);
+    assert.strictEqual(stats.pulses, 1);
+    assert.strictEqual(stats.missed, 0);
+    assert(stats.periodNs > 0);
+    assert.strictEqual(stats.error, null);
+    assert(readMockValue(0) === Value.LOW);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testBusTrigger(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestMixed(chip, [], [1, 2, 3], Edge.BOTH);
+    const bus = new BusTrigger(request, { lines: [1, 2, 3] });
+    const id = bus.addTrigger({ mask: 0b011, value: 0b011, on: 'both' });
+    bus.addTrigger({ values: [0b100], on: 'enter' });
+    const events: BusTriggerEvent[] = [];
+    bus.start((err, event) => {
+        assert.ifError(err);
+        if (event) {
+            events.push(event);
+        }
+    });
+    assert.strictEqual(bus.value, 0);
+    writeMockValue(1, Value.HIGH);
+    await waitTimeout(20);
+    writeMockValue(2, Value.HIGH);
+    await waitTimeout(20);
+    writeMockValue(1, Value.LOW);
+    await waitTimeout(50);
+    bus.stop();
+    assert.strictEqual(events.length, 2, "Expected enter and leave");
+    assert.strictEqual(events[0].trigger, id);
+    assert.strictEqual(events[0].type, 'enter');
+    assert.strictEqual(events[0].value, 0b011);
+    assert.strictEqual(events[0].offset, 2);
+    assert.strictEqual(events[1].type, 'leave');
+    assert(events[1].timestampNs > events[0].timestampNs);
+    assert.strictEqual(bus.stats.edges, 3);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testWatchdogKicker(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestMixed(chip, [0], []);
+    const kicker = new WatchdogKicker(request, { line: 0, periodMs: 10, feedTimeoutMs: 50 });
+    kicker.start();
+    for (let i = 0; i < 5; i++) {
+        await waitTimeout(20);
+        kicker.feed();
+    }
+    const fed = kicker.stats;
+    assert(fed.kicks > 0, "Expected kicks while fed");
+    assert.strictEqual(fed.feeds, 5);
+    await waitTimeout(150);
+    const starved = kicker.stats;
+    assert(starved.starved > 0, "Expected starved periods without feeds");
+    assert(starved.lastFeedAgeNs! >= 50e6);
+    const level = readMockValue(0);
+    await waitTimeout(50);
+    assert.strictEqual(readMockValue(0), level, "Expected no kicks without feeds");
+    kicker.feed();
+    await waitTimeout(30);
+    kicker.stop();
+    assert(kicker.stats.kicks > starved.kicks, "Expected kicks to resume after a feed");
+    assert.strictEqual(kicker.stats.running, false);
+    assert.strictEqual(kicker.stats.error, null);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testSpiTransfer(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestMixed(chip, [0, 1, 3], [2]);
+    const spi = new SpiBitbang(request, { sck: 0, mosi: 1, miso: 2, cs: 3, clockHz: 10000 });
+    // MISO is held by the mock, so every sampled bit has its level
+    writeMockValue(2, Value.HIGH);
+    assert.deepStrictEqual(Array.from(await spi.transfer(Uint8Array.from([0x5a, 0x01]))), [0xff, 0xff]);
+    assert(readMockValue(0) === Value.LOW, "Expected the clock idle low in mode 0");
+    assert(readMockValue(1) === Value.HIGH, "Expected MOSI to hold the last bit of 0x01");
+    assert(readMockValue(3) === Value.HIGH, "Expected chip select deasserted");
+    writeMockValue(2, Value.LOW);
+    assert.deepStrictEqual(Array.from(await spi.transfer(Uint8Array.from([0xff]))), [0x00]);
+    const stats = spi.stats;
+    assert.strictEqual(stats.transfers, 2);
+    assert.strictEqual(stats.bytes, 3);
+    assert(stats.achievedClockHz > 0, "Expected a measured clock rate");
+    request.release();
+    assert.throws(() => spi.transfer(Uint8Array.from([0])), /not active/);
+    cleanupMockChip(chip);
+}
+
+export async function testI2cNack(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestMixed(chip, [0, 1], []);
+    const i2c = new I2cBitbang(request, { sda: 0, scl: 1, clockHz: 10000 });
+    // The mock reads the released SDA line back high, so no device acknowledges
+    await assert.rejects(i2c.writeRead(0x50, Uint8Array.from([0x00]), 2), /no ACK from device 0x50/);
+    assert(readMockValue(0) === Value.HIGH, "Expected SDA released after the stop condition");
+    assert(readMockValue(1) === Value.HIGH, "Expected SCL released after the stop condition");
+    assert.throws(() => i2c.writeRead(0x50, new Uint8Array(0), 65537), RangeError);
+    const stats = i2c.stats;
+    assert.strictEqual(stats.transactions, 0);
+    assert.strictEqual(stats.nacks, 1);
+    assert.strictEqual(stats.arbitrationLost, 0);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testPulseMeasurement(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestMixed(chip, [0], [1], Edge.BOTH);
+    // The echo is driven from JavaScript timers, so the timeout leaves room for their delays
+    const pending = request.measurePulse(0, 1, { timeoutMs: 500 });
+    await waitTimeout(20);
+    writeMockValue(1, Value.HIGH);
+    await waitTimeout(30);
+    writeMockValue(1, Value.LOW);
+    const width = await pending;
+    assert(width >= 25e6 && width < 250e6, `Expected an echo of about 30 ms, got ${width} ns`);
+    assert(readMockValue(0) === Value.LOW, "Expected the trigger line low after the pulse");
+    await assert.rejects(request.measurePulse(0, 1, { timeoutMs: 20 }), /no echo in time/);
+    const meter = new PulseMeter(request, { trigger: 0, echo: 1, timeoutMs: 20, rateHz: 20 });
+    const measurements: PulseMeasurement[] = [];
+    meter.start((err, measurement) => {
+        assert.ifError(err);
+        if (measurement) {
+            measurements.push(measurement);
+        }
+    });
+    await waitTimeout(200);
+    meter.stop();
+    assert(measurements.length > 0, "Expected measurements");
+    assert(measurements.every((measurement) => measurement.widthNs === null), "Expected only timeouts");
+    // Callbacks queued before stop() may still be pending
+    assert(meter.stats.timeouts >= measurements.length, "Expected every timeout to be counted");
+    assert.strictEqual(meter.stats.measurements, 0);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testThreadOptions(t: TestContext): Promise<void> {
+    const previous = getThreadOptions();
+    assert.throws(() => setThreadOptions({ policy: SchedPolicy.FIFO, priority: 100 }), RangeError);
+    try {
+        const applied = setThreadOptions({ policy: SchedPolicy.FIFO, priority: 10 });
+        assert.strictEqual(applied.policy, SchedPolicy.FIFO);
+        assert.strictEqual(applied.priority, 10);
+    } catch (err) {
+        // Without CAP_SYS_NICE or RLIMIT_RTPRIO the probe thread is refused
+        assert.match((err as Error).message,
+            /^Failed to set fifo scheduling with priority 10: Operation not permitted \(requires CAP_SYS_NICE or a sufficient RLIMIT_RTPRIO\)$/);
+        assert.deepStrictEqual(getThreadOptions(), previous, "Expected rejected options to be left unapplied");
+    }
+    setThreadOptions({ policy: previous.policy, priority: previous.priority, cpus: previous.cpus });
+}
+
+export async function executeEngineTests(): Promise<void> {
+    await test('Engine Tests', async (tt: TestContext) => {
+        await tt.test('testShiftRegisterOut', async (t: TestContext) => await testShiftRegisterOut(t));
+        await tt.test('testShiftRegisterIn', async (t: TestContext) => await testShiftRegisterIn(t));
+        await tt.test('testKeypadScanner', async (t: TestContext) => await testKeypadScanner(t));
+        await tt.test('testDisplayRefresher', async (t: TestContext) => await testDisplayRefresher(t));
+        await tt.test('testStepperMoves', async (t: TestContext) => await testStepperMoves(t));
+        await tt.test('testServoPulses', async (t: TestContext) => await testServoPulses(t));
+        await tt.test('testButtonClassifier', async (t: TestContext) => await testButtonClassifier(t));
+        await tt.test('testDelayedOneShot', async (t: TestContext) => await testDelayedOneShot(t));
+        await tt.test('testBusTrigger', async (t: TestContext) => await testBusTrigger(t));
+        await tt.test('testWatchdogKicker', async (t: TestContext) => await testWatchdogKicker(t));
+        await tt.test('testSpiTransfer', async (t: TestContext) => await testSpiTransfer(t));
+        await tt.test('testI2cNack', async (t: TestContext) => await testI2cNack(t));
+        await tt.test('testPulseMeasurement', async (t: TestContext) => await testPulseMeasurement(t));
+        await tt.test('testThreadOptions', async (t: TestContext) => await testThreadOptions(t));
+    });
+}
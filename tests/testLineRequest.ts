@@ -0,0 +1,305 @@
+import assert from "assert";
+import { Chip } from "../src/chip.js";
+import { LineConfig } from "../src/line-config.js";
+import { LineRequest, OutputTransition } from "../src/line-request.js";
+import { SupervisionEvent } from "../src/supervisor.js";
+import { LineGroup, LineGroupEvent } from "../src/line-group.js";
+import { ProgramBuilder } from "../src/program.js";
+import { Direction, Edge, EventType, Value } from "../src/enums.js";
+import { cleanupMockChip, getMockChip, readMockValue, waitTimeout, writeMockValue } from "./utils.js";
+import test, { TestContext } from "node:test";
+
+function requestLines(chip: Chip, offsets: number[], direction: Direction, edge: Edge = Edge.NONE): LineRequest {
+    const config = new LineConfig();
+    for (const offset of offsets) {
+        config.setOffset(offset);
+        config.setDirection(direction);
+        config.setEdge(edge);
+    }
+    return new LineRequest(chip, offsets, config);
+}
+
+export function testLineGroupSetMask(t: TestContext): void {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const first = requestLines(chip, [0, 1], Direction.OUTPUT);
+    const second = requestLines(chip, [2], Direction.OUTPUT);
+    const group = new LineGroup([first, second]);
+    assert.strictEqual(group.lines.length, 3);
+    assert.strictEqual(group.lines[2].offset, 2);
+    group.setMask(0b101, 0b101);
+    assert(readMockValue(0) === Value.HIGH);
+    assert(readMockValue(1) === Value.LOW);
+    assert(readMockValue(2) === Value.HIGH);
+    assert.strictEqual(group.getMask(), 0b101);
+    group.setValues([Value.LOW, Value.HIGH, Value.LOW]);
+    assert.deepStrictEqual(group.getValues(), [Value.LOW, Value.HIGH, Value.LOW]);
+    // Group writes keep the shadow of the member requests current
+    first.setWriteElision(true);
+    first.setValue(1, Value.LOW);
+    group.setValues([Value.LOW, Value.HIGH, Value.LOW]);
+    first.setValue(1, Value.LOW);
+    assert(readMockValue(1) === Value.LOW);
+    // Observers run after all members are written
+    first.onOutputChange(() => { throw new Error('observer failed'); });
+    assert.throws(() => group.setMask(0b101, 0b101), /observer failed/);
+    assert(readMockValue(2) === Value.HIGH);
+    first.onOutputChange(null);
+    assert.throws(() => new LineGroup([first, first]), /same LineRequest twice/);
+    first.release();
+    second.release();
+    cleanupMockChip(chip);
+}
+
+export async function testLineGroupWatch(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const first = requestLines(chip, [3], Direction.INPUT, Edge.BOTH);
+    const second = requestLines(chip, [4], Direction.INPUT, Edge.BOTH);
+    const group = new LineGroup([first, second]);
+    const events: LineGroupEvent[] = [];
+    group.watch((err, event) => {
+        assert.ifError(err);
+        if (event) {
+            events.push(event);
+        }
+    });
+    writeMockValue(4, Value.HIGH);
+    await waitTimeout(50);
+    writeMockValue(3, Value.HIGH);
+    await waitTimeout(200);
+    group.unwatch();
+    assert.strictEqual(events.length, 2, "Expected two merged events");
+    assert.strictEqual(events[0].index, 1);
+    assert.strictEqual(events[1].index, 0);
+    assert.strictEqual(events[0].type, EventType.RISING_EDGE);
+    assert(events[0].timestampNs < events[1].timestampNs);
+    first.release();
+    second.release();
+    cleanupMockChip(chip);
+}
+
+export async function testLineGroupWatchAcrossReads(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const first = requestLines(chip, [3], Direction.INPUT, Edge.BOTH);
+    const second = requestLines(chip, [4], Direction.INPUT, Edge.BOTH);
+    const group = new LineGroup([first, second]);
+    const events: LineGroupEvent[] = [];
+    group.watch((err, event) => {
+        assert.ifError(err);
+        if (event) {
+            events.push(event);
+        }
+    });
+    // Each edge is read in its own wake-up, alternating between the requests
+    for (const [offset, value] of [[4, Value.HIGH], [3, Value.HIGH], [4, Value.LOW], [3, Value.LOW]]) {
+        writeMockValue(offset, value);
+        await waitTimeout(30);
+    }
+    await waitTimeout(100);
+    group.unwatch();
+    assert.deepStrictEqual(events.map(event => event.index), [1, 0, 1, 0]);
+    assert.deepStrictEqual(events.map(event => event.type),
+        [EventType.RISING_EDGE, EventType.RISING_EDGE, EventType.FALLING_EDGE, EventType.FALLING_EDGE]);
+    for (let i = 1; i < events.length; i++) {
+        assert(events[i - 1].timestampNs < events[i].timestampNs);
+    }
+    first.release();
+    second.release();
+    cleanupMockChip(chip);
+}
+
+export function testWriteElision(t: TestContext): void {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestLines(chip, [0, 1], Direction.OUTPUT);
+    const transitions: OutputTransition[] = [];
+    request.onOutputChange(changes => transitions.push(...changes));
+    request.setWriteElision(true);
+    assert.strictEqual(request.setValues([0, 1], [Value.HIGH, Value.LOW]), 2);
+    assert.strictEqual(request.setValues([0, 1], [Value.HIGH, Value.LOW]), 0);
+    request.setValue(0, Value.HIGH);
+    assert.strictEqual(request.setValues([0, 1], [Value.HIGH, Value.HIGH]), 1);
+    assert(readMockValue(0) === Value.HIGH);
+    assert(readMockValue(1) === Value.HIGH);
+    assert.deepStrictEqual(transitions, [
+        { offset: 0, value: Value.HIGH },
+        { offset: 1, value: Value.LOW },
+        { offset: 1, value: Value.HIGH }
+    ]);
+    const stats = request.writeStats;
+    assert.strictEqual(stats.writes, 7);
+    assert.strictEqual(stats.elided, 4);
+    assert.strictEqual(stats.ioctls, 2);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testExecuteProgram(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestLines(chip, [0, 1], Direction.OUTPUT);
+    const program = new ProgramBuilder()
+        .set(0b11, 0b01)
+        .read(0)
+        .loop(3, body => body.set(0b10, 0b10).delayNs(1000).set(0b10, 0b00))
+        .set(0b11, 0b10)
+        .read(1)
+        .build();
+    const results = await request.execute(program);
+    assert.strictEqual(results.length, 2);
+    assert.strictEqual(results[0], 0b01);
+    assert.strictEqual(results[1], 0b10);
+    assert(readMockValue(0) === Value.LOW);
+    assert(readMockValue(1) === Value.HIGH);
+    assert.throws(() => request.execute(Uint32Array.from([0x7f])));
+    assert.throws(() => request.execute(new ArrayBuffer(6)), RangeError);
+    assert.throws(() => request.execute(new ProgramBuilder()
+        .loop(1000, body => body.delayNs(100_000_000)).build()), /exceed 60 s/);
+    // Releasing the request stops a running program
+    const cancelled = request.execute(new ProgramBuilder().delayNs(4_000_000_000).set(0b01, 0b01).build());
+    await waitTimeout(20);
+    request.release();
+    await assert.rejects(cancelled, /released/);
+    cleanupMockChip(chip);
+}
+
+export async function testWriteDuringProgram(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestLines(chip, [0, 1], Direction.OUTPUT);
+    const running = request.execute(new ProgramBuilder()
+        .loop(20, body => body.set(0b01, 0b01).delayNs(10_000_000).set(0b01, 0b00))
+        .build());
+    // Writes from JavaScript do not wait for the program to finish
+    await waitTimeout(20);
+    const start = process.hrtime.bigint();
+    request.setValue(1, Value.HIGH);
+    const elapsedMs = Number(process.hrtime.bigint() - start) / 1e6;
+    assert(elapsedMs < 50, `Expected the write not to wait for the program, took ${elapsedMs} ms`);
+    assert(readMockValue(1) === Value.HIGH);
+    await running;
+    assert(readMockValue(0) === Value.LOW);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testEdgeConsumerClaim(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestLines(chip, [3, 4], Direction.INPUT, Edge.BOTH);
+    const group = new LineGroup([request]);
+    group.watch((err) => assert.ifError(err));
+    const waitEdge = new ProgramBuilder().waitEdge(0b01, 1000, 0).build();
+    assert.throws(() => request.execute(waitEdge), /already read by LineGroup\.watch\(\)/);
+    // Restarting the watch keeps its own claim
+    group.watch((err) => assert.ifError(err));
+    // Programs without WAIT_EDGE leave the edge events alone
+    const levels = await request.execute(new ProgramBuilder().read(0).build());
+    assert.strictEqual(levels.length, 1);
+    group.unwatch();
+    const results = await request.execute(waitEdge);
+    assert.strictEqual(results[0], 0);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export function testReconfigure(t: TestContext): void {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestLines(chip, [0, 1], Direction.OUTPUT);
+    request.setValues([0, 1], [Value.HIGH, Value.HIGH]);
+    // Switch line 1 to an input while line 0 keeps driving
+    const config = new LineConfig();
+    config.setOffset(0);
+    config.setDirection(Direction.OUTPUT);
+    config.setOutputValue(Value.HIGH);
+    config.setOffset(1);
+    config.setDirection(Direction.INPUT);
+    request.reconfigure(config);
+    assert(readMockValue(0) === Value.HIGH);
+    writeMockValue(1, Value.LOW);
+    assert.strictEqual(request.getValue(1), Value.LOW);
+    writeMockValue(1, Value.HIGH);
+    assert.strictEqual(request.getValue(1), Value.HIGH);
+    request.release();
+    assert.throws(() => request.reconfigure(config));
+    cleanupMockChip(chip);
+}
+
+export async function testSuperviseHeartbeat(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestLines(chip, [1], Direction.INPUT, Edge.BOTH);
+    const events: SupervisionEvent[] = [];
+    const supervision = request.supervise(1, { maxIntervalMs: 100 }, (err, event) => {
+        assert.ifError(err);
+        if (event) {
+            events.push(event);
+        }
+    });
+    for (let i = 0; i < 3; i++) {
+        writeMockValue(1, Value.HIGH);
+        await waitTimeout(20);
+        writeMockValue(1, Value.LOW);
+        await waitTimeout(20);
+    }
+    assert.strictEqual(events.length, 0);
+    assert.strictEqual(supervision.status?.state, 'alive');
+    await waitTimeout(200);
+    writeMockValue(1, Value.HIGH);
+    await waitTimeout(50);
+    assert.deepStrictEqual(events.map(event => event.type), ['timeout', 'recovered']);
+    assert.strictEqual(supervision.status?.heartbeats, 4);
+    assert.strictEqual(supervision.status?.timeouts, 1);
+    supervision.cancel();
+    assert.strictEqual(supervision.status, null);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testSetValuesAt(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const request = requestLines(chip, [0, 1], Direction.OUTPUT);
+    // process.hrtime is CLOCK_MONOTONIC on Linux
+    const timeNs = process.hrtime.bigint() + 20_000_000n;
+    const pending = request.setValuesAt(timeNs, [0, 1], [Value.HIGH, Value.HIGH]);
+    assert(readMockValue(0) === Value.LOW, "Expected no write before the deadline");
+    const result = await pending;
+    assert.strictEqual(result.scheduledNs, timeNs);
+    assert(result.writtenNs >= timeNs);
+    assert.strictEqual(BigInt(result.latenessNs), result.writtenNs - timeNs);
+    assert(readMockValue(0) === Value.HIGH);
+    assert(readMockValue(1) === Value.HIGH);
+    const late = await request.setValueAt(0n, 1, Value.LOW);
+    assert(late.latenessNs > 0, "Expected a past deadline to be written at once");
+    assert(readMockValue(1) === Value.LOW);
+    const realtimeNs = BigInt(Date.now()) * 1_000_000n + 10_000_000n;
+    const realtime = await request.setValueAt(realtimeNs, 0, Value.LOW, { clock: 'realtime' });
+    assert(realtime.writtenNs >= realtimeNs);
+    assert(readMockValue(0) === Value.LOW);
+    assert.throws(() => request.setValueAt(timeNs, 5, Value.HIGH), /not part of the request/);
+    // Writes that have not fired are rejected by release() and never issued
+    const cancelled = request.setValueAt(process.hrtime.bigint() + 10_000_000_000n, 0, Value.HIGH);
+    request.release();
+    await assert.rejects(cancelled, /line request was released/);
+    assert(readMockValue(0) === Value.LOW);
+    cleanupMockChip(chip);
+}
+
+export async function executeLineRequestTests(): Promise<void> {
+    await test('LineRequest Tests', async (tt: TestContext) => {
+        await tt.test('testLineGroupSetMask', (t: TestContext) => testLineGroupSetMask(t));
+        await tt.test('testLineGroupWatch', async (t: TestContext) => await testLineGroupWatch(t));
+        await tt.test('testLineGroupWatchAcrossReads', async (t: TestContext) => await testLineGroupWatchAcrossReads(t));
+        await tt.test('testWriteElision', (t: TestContext) => testWriteElision(t));
+        await tt.test('testExecuteProgram', async (t: TestContext) => await testExecuteProgram(t));
+        await tt.test('testWriteDuringProgram', async (t: TestContext) => await testWriteDuringProgram(t));
+        await tt.test('testEdgeConsumerClaim', async (t: TestContext) => await testEdgeConsumerClaim(t));
+        await tt.test('testReconfigure', (t: TestContext) => testReconfigure(t));
+        await tt.test('testSuperviseHeartbeat', async (t: TestContext) => await testSuperviseHeartbeat(t));
+        await tt.test('testSetValuesAt', async (t: TestContext) => await testSetValuesAt(t));
+    });
+}
@@ -160,6 +160,50 @@ export async function testLineDebounce(t: TestContext): Promise<void> {
     cleanupMockChip(chip);
 }
 
+export async function testLineGlitchFilter(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const line: Line | undefined = chip?.getLine(0);
+    assert(line);
+    line?.setDirection(Direction.INPUT);
+    line?.setEdge(Edge.BOTH);
+    const values: Value[] = [];
+    line?.watch((err, value) => {
+        assert.ifError(err);
+        values.push(value);
+    }, { minPulseUs: 50000 });
+    writeMockValue(0, Value.HIGH);
+    await waitTimeout(10);
+    writeMockValue(0, Value.LOW);
+    await waitTimeout(200);
+    writeMockValue(0, Value.HIGH);
+    await waitTimeout(200);
+    assert.deepStrictEqual(values, [Value.HIGH]);
+    assert.deepStrictEqual(line?.watchStats, { edges: 3, suppressed: 2 });
+    line?.unwatch();
+    cleanupMockChip(chip);
+}
+
+export async function testLineCachedValue(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const line: Line | undefined = chip?.getLine(0);
+    assert(line);
+    line?.setDirection(Direction.INPUT);
+    line?.setEdge(Edge.BOTH);
+    line?.watch(() => {});
+    assert.strictEqual(line?.getValue({ cached: true }), Value.LOW);
+    writeMockValue(0, Value.HIGH);
+    await waitTimeout(100);
+    assert.strictEqual(line?.getValue({ cached: true }), Value.HIGH);
+    const stats = line?.valueCacheStats;
+    assert.strictEqual(stats?.hits, 2);
+    assert.strictEqual(stats?.reads, 1);
+    assert.strictEqual(stats?.overruns, 0);
+    line?.unwatch();
+    cleanupMockChip(chip);
+}
+
 export function testTwoLinesGetValue(t: TestContext): void {
     const chip: Chip | undefined = getMockChip();
     assert(chip);
@@ -285,6 +329,8 @@ export async function executeLineTests(): Promise<void> {
         await tt.test('testWatchLineActiveLowValue', async (t: TestContext) => await testWatchLineActiveLowValue(t));
         await tt.test('testWatchLineActiveHighValue', async (t: TestContext) => await testWatchLineActiveHighValue(t));
         await tt.test('testLineDebounce', (t: TestContext) => testLineDebounce(t));
+        await tt.test('testLineGlitchFilter', async (t: TestContext) => await testLineGlitchFilter(t));
+        await tt.test('testLineCachedValue', async (t: TestContext) => await testLineCachedValue(t));
         await tt.test('testTwoLinesSetValue', (t: TestContext) => testTwoLinesSetValue(t));
         await tt.test('testTwoLinesGetValue', (t: TestContext) => testTwoLinesGetValue(t));
         await tt.test('testWatchTwoLines', async (t: TestContext) => await testWatchTwoLines(t));
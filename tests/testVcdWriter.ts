@@ -0,0 +1,75 @@
+import assert from "assert";
+import fs from "fs";
+import os from "os";
+import path from "path";
+import { Chip } from "../src/chip.js";
+import { LineConfig } from "../src/line-config.js";
+import { LineRequest } from "../src/line-request.js";
+import { VcdWriter } from "../src/vcd-writer.js";
+import { Direction, Edge, Value } from "../src/enums.js";
+import { cleanupMockChip, getMockChip, waitTimeout, writeMockValue } from "./utils.js";
+import test, { TestContext } from "node:test";
+
+export async function testVcdCapture(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const config = new LineConfig();
+    config.setOffset(0);
+    config.setDirection(Direction.INPUT);
+    config.setEdge(Edge.BOTH);
+    const request = new LineRequest(chip, [0], config);
+    const file = path.join(os.tmpdir(), `gpiod-test-${process.pid}.vcd`);
+    const writer = new VcdWriter(request, file, { names: ['clk'] });
+    writeMockValue(0, Value.HIGH);
+    await waitTimeout(100);
+    writeMockValue(0, Value.LOW);
+    await waitTimeout(100);
+    const stats = writer.close();
+    assert.strictEqual(stats.edges, 2, "Expected two captured edges");
+    assert.strictEqual(stats.changesWritten, 2, "Expected two written changes");
+    const content = fs.readFileSync(file, 'utf-8');
+    assert(content.includes('$var wire 1 ! clk $end'));
+    assert(content.includes('$enddefinitions $end'));
+    assert(content.trimEnd().endsWith('0!'));
+    fs.unlinkSync(file);
+    request.release();
+    cleanupMockChip(chip);
+}
+
+export async function testVcdSnapshotOrderAndRelease(t: TestContext): Promise<void> {
+    const chip: Chip | undefined = getMockChip();
+    assert(chip);
+    const config = new LineConfig();
+    config.setOffset(0);
+    config.setDirection(Direction.INPUT);
+    config.setEdge(Edge.BOTH);
+    const request = new LineRequest(chip, [0], config);
+    const file = path.join(os.tmpdir(), `gpiod-test-order-${process.pid}.vcd`);
+    const writer = new VcdWriter(request, file);
+    // The snapshot may be queued before the edge is read, but is written after it
+    writeMockValue(0, Value.HIGH);
+    writer.snapshot();
+    await waitTimeout(200);
+    request.release();
+    assert.throws(() => writer.snapshot(), /not active/);
+    await waitTimeout(300);
+    assert.match(writer.stats.error ?? '', /released/);
+    const stats = writer.close();
+    assert.strictEqual(stats.edges, 1, "Expected one captured edge");
+    assert.strictEqual(stats.changesWritten, 1, "Expected the repeated snapshot value to be dropped");
+    const content = fs.readFileSync(file, 'utf-8');
+    const times = content.split('\n').filter((line) => line.startsWith('#')).map((line) => BigInt(line.slice(1)));
+    for (let i = 1; i < times.length; i++) {
+        assert(times[i] > times[i - 1], "Expected increasing VCD times");
+    }
+    assert(content.trimEnd().endsWith('1!'));
+    fs.unlinkSync(file);
+    cleanupMockChip(chip);
+}
+
+export async function executeVcdWriterTests(): Promise<void> {
+    await test('VcdWriter Tests', async (tt: TestContext) => {
+        await tt.test('testVcdCapture', async (t: TestContext) => await testVcdCapture(t));
+        await tt.test('testVcdSnapshotOrderAndRelease', async (t: TestContext) => await testVcdSnapshotOrderAndRelease(t));
+    });
+}